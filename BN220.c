@@ -34,8 +34,138 @@
 #include "BN220.h"
 #include <string.h>
 #include <stdlib.h>
+#include <stddef.h>
 
+#if BN220_ENABLE_LEGACY_PARSE
 char* data [15];
+#endif
+
+
+#if BN220_NUMERIC_LIBC
+#define gpsStrtof(s) strtof((s), NULL)
+#define gpsAtoi(s)   strtol((s), NULL, 10)
+#else
+static const float gpsPow10[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f };
+
+// Reads "[-]ddd[.ddd]" as found in NMEA fields; stops at the first other character
+static float gpsStrtof(const char *s) {
+    uint32_t mant = 0;
+    int      neg = 0, digits = 0, frac = -1;
+
+    if (*s == '-' || *s == '+')
+        neg = (*s++ == '-');
+
+    for (; *s; ++s) {
+        if (*s >= '0' && *s <= '9') {
+            if (digits < 9) {          // 9 digits always fit in 32 bits
+                mant = mant * 10u + (uint32_t)(*s - '0');
+                digits++;
+                if (frac >= 0) frac++;
+            } else if (frac < 0) {
+                return neg ? -1e9f : 1e9f; // out of range for any NMEA field
+            }
+        } else if (*s == '.' && frac < 0) {
+            frac = 0;
+        } else {
+            break;
+        }
+    }
+
+    float v = (float)mant / gpsPow10[frac > 0 ? frac : 0];
+    return neg ? -v : v;
+}
+
+// Reads "[-]ddd" like strtol(s, NULL, 10); stops at the first non-digit
+static long gpsAtoi(const char *s) {
+    long v = 0;
+    int  neg = 0;
+
+    if (*s == '-' || *s == '+')
+        neg = (*s++ == '-');
+    for (; *s >= '0' && *s <= '9' && v < 100000000L; ++s)
+        v = v * 10 + (*s - '0');
+    return neg ? -v : v;
+}
+#endif
+
+
+/*
+ * Split a NUL-terminated sentence into its comma-separated fields in place:
+ * every ',' becomes '\0' and val[i] points at field i.  At most @p max
+ * fields are cut (the last one keeps any remainder); unused entries are
+ * NULL.  No copy and no allocation, so decoders can run in the RX path.
+ */
+static int gpsSplit(char *s, char **val, int max) {
+    int cnt = 0;
+    val[cnt++] = s;
+    for (; *s && cnt < max; s++) {
+        if (*s == ',') {
+            *s = '\0';
+            val[cnt++] = s + 1;
+        }
+    }
+    for (int i = cnt; i < max; i++)
+        val[i] = NULL;
+    return cnt;
+}
+
+
+#if BN220_USE_SWAR
+#define SWAR_ONES   0x01010101u
+#define SWAR_HIGHS  0x80808080u
+#define SWAR_HAS_ZERO(v)     (((v) - SWAR_ONES) & ~(v) & SWAR_HIGHS)
+#define SWAR_HAS_BYTE(v, b)  SWAR_HAS_ZERO((v) ^ (SWAR_ONES * (uint8_t)(b)))
+
+static inline uint32_t gpsSwarLoad(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v)); // single LDR on cores with unaligned access
+    return v;
+}
+
+static inline uint8_t gpsSwarFold(uint32_t acc) {
+    acc ^= acc >> 16;
+    acc ^= acc >> 8;
+    return (uint8_t)acc;
+}
+
+// XOR of p[0..n), four bytes per step
+static uint8_t gpsSwarXor(const uint8_t *p, size_t n) {
+    uint32_t acc = 0;
+    size_t   i = 0;
+
+    for (; i + 4 <= n; i += 4)
+        acc ^= gpsSwarLoad(p + i);
+    uint8_t x = gpsSwarFold(acc);
+    for (; i < n; i++)
+        x ^= p[i];
+    return x;
+}
+
+static inline int gpsIsFraming(uint8_t c) {
+    return c == '$' || c == '*' || c == '\r' || c == '\n';
+}
+
+// Length of the leading run of p[0..n) without '$', '*', CR or LF; the run
+// is XOR-ed into *cs on the way
+static size_t gpsSwarRun(const uint8_t *p, size_t n, uint8_t *cs) {
+    uint32_t acc = 0;
+    size_t   i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        uint32_t v = gpsSwarLoad(p + i);
+        if (SWAR_HAS_BYTE(v, '$') | SWAR_HAS_BYTE(v, '*') |
+            SWAR_HAS_BYTE(v, '\r') | SWAR_HAS_BYTE(v, '\n'))
+            break;
+        acc ^= v;
+    }
+    uint8_t x = gpsSwarFold(acc);
+    for (; i < n && !gpsIsFraming(p[i]); i++)
+        x ^= p[i];
+
+    *cs ^= x;
+    return i;
+}
+#endif
 
 
 int getChecksum(const char* gps_sentence) {
@@ -48,10 +178,14 @@ int getChecksum(const char* gps_sentence) {
         return 0;
 
     // 2) XOR range: all characters from the start of the sentence up to the ‘*’ character
+#if BN220_USE_SWAR
+    unsigned char calc_cs = gpsSwarXor((const uint8_t *)gps_sentence, (size_t)(star - gps_sentence));
+#else
     unsigned char calc_cs = 0;
     for (const char* p = gps_sentence; p < star; ++p) {
         calc_cs ^= (unsigned char)(*p);
     }
+#endif
 
     // 3) Extract the two hexadecimal digits from the NMEA sentence
     char cs_str[3] = { star[1], star[2], '\0' };
@@ -66,40 +200,18 @@ int getChecksum(const char* gps_sentence) {
 }
 
 
+#if BN220_ENABLE_GLL
 int nmea_GLL(BN220_GPS *gps_data, char *nmea_sentence) {
     char *val[25];
-    int  cnt = 0;
-
-    // 1) Fill the val[] array with NULL
-    memset(val, 0, sizeof(val));
-
-    // 2) Keep the original sentence intact; take a copy with strdup
-    char *buf = strdup(nmea_sentence);
-    if (!buf) return 0;
-
-    // 3) Split by commas: consecutive ",," must also yield an empty token ("")
-    char *p     = buf;
-    char *token = NULL;
-    while ((token = strsep(&p, ",")) != NULL && cnt < 25) {
-        val[cnt] = malloc(strlen(token) + 1);
-        if (!val[cnt]) {
-        	//    Clean up if malloc fails
-            for (int i = 0; i < cnt; i++) free(val[i]);
-            free(buf);
-            return 0;
-        }
-        strcpy(val[cnt], token);
-        cnt++;
-    }
 
-    // 4) A GLL sentence must contain at least five fields: header, lat, N/S, lon, E/W
-    if (cnt < 5) {
-        for (int i = 0; i < cnt; i++) free(val[i]);
-        free(buf);
+    // 1) Split in place: consecutive ",," must also yield an empty field ("")
+    int cnt = gpsSplit(nmea_sentence, val, 25);
+
+    // 2) A GLL sentence must contain at least five fields: header, lat, N/S, lon, E/W
+    if (cnt < 5)
         return 0;
-    }
 
-    // 5) Latitude check
+    // 3) Latitude check
     char lat_ind = val[2][0];
     if (lat_ind == 'N' || lat_ind == 'S') {
     	//    Expected format: DDMM.MMMM
@@ -107,8 +219,8 @@ int nmea_GLL(BN220_GPS *gps_data, char *nmea_sentence) {
         memcpy(lat_d, val[1], 2);
         memcpy(lat_m, val[1] + 2, 6);
 
-        int   lat_d_t = strtol(lat_d, NULL, 10);
-        float lat_m_t = strtof(lat_m, NULL);
+        int   lat_d_t = gpsAtoi(lat_d);
+        float lat_m_t = gpsStrtof(lat_m);
         double lat_deg = lat_d_t + lat_m_t / 60.0;
 
         //    Longitude check
@@ -117,19 +229,16 @@ int nmea_GLL(BN220_GPS *gps_data, char *nmea_sentence) {
         memcpy(lon_d, val[3], 3);
         memcpy(lon_m, val[3] + 3, 7);
 
-        int   lon_d_t = strtol(lon_d, NULL, 10);
-        float lon_m_t = strtof(lon_m, NULL);
+        int   lon_d_t = gpsAtoi(lon_d);
+        float lon_m_t = gpsStrtof(lon_m);
         double lon_deg = lon_d_t + lon_m_t / 60.0;
 
-        // 6) Zero-value check
+        // 4) Zero-value check
         if (lat_d_t == 0 || lat_m_t == 0.0f ||
-            lon_d_t == 0 || lon_m_t == 0.0f) {
-            for (int i = 0; i < cnt; i++) free(val[i]);
-            free(buf);
+            lon_d_t == 0 || lon_m_t == 0.0f)
             return 0;
-        }
 
-        // 7) Populate the GPS data
+        // 5) Populate the GPS data
         gps_data->lat = lat_deg;
         gps_data->lon = lon_deg;
         gps_data->NS  = lat_ind;
@@ -142,75 +251,87 @@ int nmea_GLL(BN220_GPS *gps_data, char *nmea_sentence) {
             gps_data->lastMeasure[0] = '\0';
         }
 
-        for (int i = 0; i < cnt; i++) free(val[i]);
-        free(buf);
         return 1;
     }
 
     //    Invalid N/S indicator
-    for (int i = 0; i < cnt; i++) free(val[i]);
-    free(buf);
     return 0;
 }
+#endif
+
+
+#if BN220_ENABLE_GSV
+/*
+ * Satellite table bookkeeping.  A BN-220 epoch sends its GSA sentence(s)
+ * before the GSV groups, so the first GSA after a GSV opens a new epoch
+ * (used flags cleared) and the first GSV after a GSA opens a new table.
+ */
+#if BN220_ENABLE_GSA
+static void gpsSatUsed(BN220_GPS *gps_data, long prn) {
+    if (prn <= 0 || prn > 255)
+        return;
+    gps_data->satUsedPrn[prn >> 3] |= (uint8_t)(1u << (prn & 7));
+    for (int i = 0; i < gps_data->satCount; i++)
+        if (gps_data->sats[i].prn == prn)
+            gps_data->sats[i].used = 1;
+}
+#endif
+
+static int gpsSatIsUsed(const BN220_GPS *gps_data, uint8_t prn) {
+    return (gps_data->satUsedPrn[prn >> 3] >> (prn & 7)) & 1;
+}
+
+static void gpsSatNewTable(BN220_GPS *gps_data) {
+    gps_data->satCount = 0;
+    gps_data->satSeq++;
+}
+#endif
 
 
+#if BN220_ENABLE_GSA
 int nmea_GSA(BN220_GPS *gps_data, char* nmea_sentence) {
     char *val[25];
-    int   cnt = 0;
-    memset(val, 0, sizeof(val));
-
-    char *buf = strdup(nmea_sentence);
-    if (!buf) return 0;
-
-    char *p = buf;
-    char *token;
-    while ((token = strsep(&p, ",")) != NULL && cnt < 25) {
-        val[cnt] = malloc(strlen(token) + 1);
-        if (!val[cnt]) {
-            for (int i = 0; i < cnt; i++) free(val[i]);
-            free(buf);
-            return 0;
-        }
-        strcpy(val[cnt], token);
-        cnt++;
-    }
+    int   cnt = gpsSplit(nmea_sentence, val, 25);
 
     // GSA requires at least 15 fields
-    if (cnt < 15) {
-        for (int i = 0; i < cnt; i++) free(val[i]);
-        free(buf);
+    if (cnt < 15)
         return 0;
-    }
 
-    int fix = strtol(val[2], NULL, 10);
+    int fix = gpsAtoi(val[2]);
     gps_data->fix = fix > 1 ? 1 : 0;
 
+#if BN220_ENABLE_GSV
+    // First GSA of the epoch: forget last epoch's used satellites
+    if (gps_data->satPhase != 'A') {
+        memset(gps_data->satUsedPrn, 0, sizeof(gps_data->satUsedPrn));
+        for (int i = 0; i < gps_data->satCount; i++)
+            gps_data->sats[i].used = 0;
+        gps_data->satPhase = 'A';
+    }
+#endif
+
     int satelliteCount = 0;
     for (int i = 3; i < 15; i++) {
         if (val[i][0] != '\0') {
             satelliteCount++;
+#if BN220_ENABLE_GSV
+            gpsSatUsed(gps_data, gpsAtoi(val[i]));
+#endif
         }
     }
     gps_data->satelliteCount = satelliteCount;
 
     // Cleanup
-    for (int i = 0; i < cnt; i++) free(val[i]);
-    free(buf);
     return 1;
 }
+#endif
 
+
+#if BN220_ENABLE_GGA
 int nmea_GGA(BN220_GPS *gps_data, char* nmea_sentence) {
-    char *val[25] = {0};
-    int   cnt = 0;
-    char *buf = strdup(nmea_sentence);
-    if (!buf) return 0;
-
-    // token
-    char *p = buf, *tok;
-    while ((tok = strsep(&p, ",")) && cnt < 25) {
-        val[cnt++] = strdup(tok);
-    }
-    if (cnt < 10) goto fail;
+    char *val[25];
+    int   cnt = gpsSplit(nmea_sentence, val, 25);
+    if (cnt < 10) return 0;
 
     // --- time ---
     if (strlen(val[1]) >= 9) {
@@ -220,72 +341,154 @@ int nmea_GGA(BN220_GPS *gps_data, char* nmea_sentence) {
 
     // --- latitude ---
     char lat_ind = val[3][0];              // **val[3]**
-    if (lat_ind != 'N' && lat_ind != 'S') goto fail;
+    if (lat_ind != 'N' && lat_ind != 'S') return 0;
     char lat_d[3] = {0}, lat_m[8] = {0};
     memcpy(lat_d, val[2], 2);              // **val[2]**
     memcpy(lat_m, val[2] + 2, 6);
-    int   lat_deg_i = strtol(lat_d, NULL, 10);
-    float lat_deg_f = strtof(lat_m, NULL) / 60.0f;
+    int   lat_deg_i = gpsAtoi(lat_d);
+    float lat_deg_f = gpsStrtof(lat_m) / 60.0f;
     double lat = lat_deg_i + lat_deg_f;
-    if (lat <= 0 || lat >= 90) goto fail;
+    if (lat <= 0 || lat >= 90) return 0;
 
     // --- longitude ---
     char lon_ind = val[5][0];              // **val[5]**
-    if (lon_ind != 'E' && lon_ind != 'W') goto fail;
+    if (lon_ind != 'E' && lon_ind != 'W') return 0;
     char lon_d[4] = {0}, lon_m[8] = {0};
     memcpy(lon_d, val[4], 3);              // **val[4]**
     memcpy(lon_m, val[4] + 3, 7);
-    int   lon_deg_i = strtol(lon_d, NULL, 10);
-    float lon_deg_f = strtof(lon_m, NULL) / 60.0f;
+    int   lon_deg_i = gpsAtoi(lon_d);
+    float lon_deg_f = gpsStrtof(lon_m) / 60.0f;
     double lon = lon_deg_i + lon_deg_f;
-    if (lon <= 0 || lon >= 180) goto fail;
+    if (lon <= 0 || lon >= 180) return 0;
 
     // --- indicator ---
     gps_data->lat = (lat_ind == 'S' ? -lat : lat);
     gps_data->lon = (lon_ind == 'W' ? -lon : lon);
-    gps_data->fix = (strtol(val[6], NULL, 10) > 0);
-    gps_data->satelliteCount = strtol(val[7], NULL, 10);
-    gps_data->hdop = strtof(val[8], NULL) ?: gps_data->hdop;
-    gps_data->altitude = strtof(val[9], NULL) ?: gps_data->altitude;
-    for (int i = 0; i < cnt; i++) free(val[i]);
-    free(buf);
+    gps_data->fix = (gpsAtoi(val[6]) > 0);
+    gps_data->satelliteCount = gpsAtoi(val[7]);
+    gps_data->hdop = gpsStrtof(val[8]) ?: gps_data->hdop;
+    gps_data->altitude = gpsStrtof(val[9]) ?: gps_data->altitude;
+    if (cnt > 11 && val[11][0])
+        gps_data->geoidSep = gpsStrtof(val[11]);
     return 1;
+}
+#endif
 
-fail:
-    for (int i = 0; i < cnt; i++) free(val[i]);
-    free(buf);
-    return 0;
+
+#if BN220_ENABLE_RMC
+int nmea_RMC(BN220_GPS *gps_data, char* nmea_sentence) {
+    char *val[25];
+    int   cnt = gpsSplit(nmea_sentence, val, 25);
+    if (cnt < 10) return 0;
+
+    // --- status: only 'A' (active) carries a valid speed ---
+    if (val[2][0] != 'A') return 0;
+
+    // --- speed over ground, knots -> m/s ---
+    if (val[7][0] != '\0')
+        gps_data->speed = gpsStrtof(val[7]) * 0.514444f;
+
+    // --- date ---
+    if (strlen(val[9]) == 6) {
+        memcpy(gps_data->date, val[9], 6);
+        gps_data->date[6] = '\0';
+    }
+
+    return 1;
 }
+#endif
 
 
+#if BN220_ENABLE_GSV
 int nmea_GSV(BN220_GPS *gps_data, char* nmea_sentence) {
     char *val[25];
-    int   cnt = 0;
-    memset(val, 0, sizeof(val));
-    char *buf = strdup(nmea_sentence);
-    if (!buf) return 0;
-    char *p = buf;
-    char *token;
-    while ((token = strsep(&p, ",")) != NULL && cnt < 25) {
-        val[cnt] = malloc(strlen(token) + 1);
-        if (!val[cnt]) {
-            for (int i = 0; i < cnt; i++) free(val[i]);
-            free(buf);
-            return 0;
-        }
-        strcpy(val[cnt], token);
-        cnt++;
-    }
-    if (cnt < 2) {
-        for (int i = 0; i < cnt; i++) free(val[i]);
-        free(buf);
+    int   cnt = gpsSplit(nmea_sentence, val, 25);
+
+    // Header, message count, message number and satellites in view
+    if (cnt < 4 || strlen(val[0]) < 5)
         return 0;
+
+    // 1) Message 1 starts a new table on the first GSV of the epoch, or when
+    //    this constellation is already in the table (no GSA in the stream)
+    char talker = val[0][1];
+    if (gpsAtoi(val[2]) == 1) {
+        int seen = gps_data->satPhase != 'V';
+        for (int i = 0; i < gps_data->satCount && !seen; i++)
+            seen = gps_data->sats[i].talker == talker;
+        if (seen)
+            gpsSatNewTable(gps_data);
+        gps_data->satPhase = 'V';
     }
-    for (int i = 0; i < cnt; i++) free(val[i]);
-    free(buf);
+
+    // 2) Up to four satellites: PRN, elevation, azimuth, SNR; a trailing
+    //    NMEA 4.10 signal id is a short group and is ignored
+    for (int k = 4; k + 3 < cnt; k += 4) {
+        long prn = gpsAtoi(val[k]);
+        if (prn <= 0 || prn > 255 || gps_data->satCount >= BN220_SAT_MAX)
+            continue;
+        BN220_Sat *sat = &gps_data->sats[gps_data->satCount++];
+        long elev = gpsAtoi(val[k + 1]);
+        long azim = gpsAtoi(val[k + 2]);
+        long snr  = gpsAtoi(val[k + 3]);
+        memset(sat, 0, sizeof(*sat));
+        sat->prn    = (uint8_t)prn;
+        sat->talker = talker;
+        if (val[k + 1][0] == '\0' || val[k + 2][0] == '\0' || elev < -90 || elev > 90 ||
+            azim < 0 || azim >= 360) {
+            sat->azim = BN220_SAT_NO_POS;
+        } else {
+            sat->elev = (int8_t)elev;
+            sat->azim = (uint16_t)azim;
+        }
+        sat->snr  = (uint8_t)(snr > 0 && snr < 100 ? snr : 0);
+        sat->used = (uint8_t)gpsSatIsUsed(gps_data, sat->prn);
+    }
+
     return 1;
 }
+#endif
+
 
+// Sentence ids returned by gpsDispatch on success
+#define SENTENCE_GLL 1
+#define SENTENCE_GSA 2
+#define SENTENCE_GGA 3
+#define SENTENCE_GSV 4
+#define SENTENCE_RMC 5
+
+// Sentence formatter after the two-letter talker: "GPGGA" -> "GGA"
+static inline int gpsIsType(const char *sentence, const char *type) {
+    return sentence[0] && sentence[1] && sentence[2] == type[0] && sentence[3] == type[1] &&
+           sentence[4] == type[2];
+}
+
+static int gpsDispatch(BN220_GPS *gps_data, char *sentence) {
+#if BN220_ENABLE_GLL
+	if(gpsIsType(sentence, "GLL"))
+		return nmea_GLL(gps_data, sentence) ? SENTENCE_GLL : 0;
+#endif
+#if BN220_ENABLE_GSA
+	if(gpsIsType(sentence, "GSA"))
+		return nmea_GSA(gps_data, sentence) ? SENTENCE_GSA : 0;
+#endif
+#if BN220_ENABLE_GGA
+	if(gpsIsType(sentence, "GGA"))
+		return nmea_GGA(gps_data, sentence) ? SENTENCE_GGA : 0;
+#endif
+#if BN220_ENABLE_GSV
+	if(gpsIsType(sentence, "GSV"))
+		return nmea_GSV(gps_data, sentence) ? SENTENCE_GSV : 0;
+#endif
+#if BN220_ENABLE_RMC
+	if(gpsIsType(sentence, "RMC"))
+		return nmea_RMC(gps_data, sentence) ? SENTENCE_RMC : 0;
+#endif
+	(void)gps_data;
+	(void)sentence;
+	return 0;
+}
+
+#if BN220_ENABLE_LEGACY_PARSE
 void gpsParse(BN220_GPS *gps_data, uint8_t *buffer){
 	memset(data,0,sizeof(data));
 	char* sentence = strtok(buffer,"$");
@@ -297,20 +500,350 @@ void gpsParse(BN220_GPS *gps_data, uint8_t *buffer){
 	}
 	for(int i=0;i<cnt;i++){
 		if(strstr(data[i], "\r\n")!=NULL && getChecksum(data[i])){
-			if(strstr(data[i], "GLL")!=NULL){
-				nmea_GLL(gps_data, data[i]);
-			}
-			else if(strstr(data[i], "GSA")!=NULL){
-				nmea_GSA(gps_data, data[i]);
-			}
-			else if(strstr(data[i], "GGA")!=NULL){
-				nmea_GGA(gps_data, data[i]);
-			}
-			else if(strstr(data[i], "GSV")!=NULL){
-				nmea_GSV(gps_data, data[i]);
-			}
+			gpsDispatch(gps_data, data[i]);
 		}
 	}
 	for(int i = 0; i<cnt; i++)
 		free(data[i]);
 }
+#endif
+
+
+int32_t gpsDaysFromCivil(int32_t year, uint32_t month, uint32_t day) {
+    // H. Hinnant's days_from_civil, valid for any year representable here
+    year -= month <= 2;
+    const int32_t  era = (year >= 0 ? year : year - 399) / 400;
+    const uint32_t yoe = (uint32_t)(year - era * 400);
+    const uint32_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + (int32_t)doe - 719468;
+}
+
+
+static int32_t gpsDegToE7(double deg, char hemi, char negative) {
+    // GGA stores signed degrees, GLL stores magnitude plus N/S or E/W
+    if (deg > 0 && hemi == negative)
+        deg = -deg;
+    return (int32_t)(deg * 1e7 + (deg < 0 ? -0.5 : 0.5));
+}
+
+
+void gpsToFix(const BN220_GPS *gps_data, BN220_Fix *fix) {
+    memset(fix, 0, sizeof(*fix));
+
+    fix->lat_e7    = gpsDegToE7(gps_data->lat, gps_data->NS, 'S');
+    fix->lon_e7    = gpsDegToE7(gps_data->lon, gps_data->EW, 'W');
+    fix->alt_mm    = (int32_t)(gps_data->altitude * 1000.0f);
+    fix->speed_cms = (uint16_t)(gps_data->speed * 100.0f + 0.5f);
+    fix->hdop_c    = (uint16_t)(gps_data->hdop * 100.0f + 0.5f);
+    fix->sats      = (uint8_t)gps_data->satelliteCount;
+    fix->fix       = (uint8_t)gps_data->fix;
+
+    // 1) Time of day from "hhmmss.ss"
+    const char *t = gps_data->lastMeasure;
+    if (strlen(t) >= 6) {
+        int64_t ms = ((t[0] - '0') * 10 + (t[1] - '0')) * 3600000LL +
+                     ((t[2] - '0') * 10 + (t[3] - '0')) * 60000LL +
+                     ((t[4] - '0') * 10 + (t[5] - '0')) * 1000LL;
+        if (t[6] == '.' && t[7] >= '0' && t[7] <= '9') {
+            ms += (t[7] - '0') * 100;
+            if (t[8] >= '0' && t[8] <= '9')
+                ms += (t[8] - '0') * 10;
+        }
+        fix->utc_ms = ms;
+    }
+
+    // 2) Date from "ddmmyy", when RMC has been seen
+    const char *d = gps_data->date;
+    if (strlen(d) == 6) {
+        int32_t days = gpsDaysFromCivil(2000 + (d[4] - '0') * 10 + (d[5] - '0'),
+                                        (uint32_t)((d[2] - '0') * 10 + (d[3] - '0')),
+                                        (uint32_t)((d[0] - '0') * 10 + (d[1] - '0')));
+        fix->utc_ms += days * 86400000LL;
+    }
+}
+
+
+#if BN220_ENABLE_STATS
+#define BN220_STAT(ctx, field) ((ctx)->stats.field++)
+#else
+#define BN220_STAT(ctx, field) ((void)0)
+#endif
+
+
+void gpsInit(BN220_Context *ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+
+static int gpsHexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+
+// Decides once per sentence, from the state gathered while framing it
+static int gpsChecksumAccept(BN220_Context *ctx) {
+    int ok = (ctx->csState == 3 && ctx->csCalc == ctx->csRecv);
+
+    switch (ctx->csPolicy) {
+    case BN220_CS_SKIP:
+        return 1;
+    case BN220_CS_REPORT:
+        ctx->csLastCalc = ctx->csCalc;
+        ctx->csLastRecv = ctx->csRecv;
+        return ok;
+    default:
+        return ok;
+    }
+}
+
+
+void gpsFeed(BN220_Context *ctx, const uint8_t *bytes, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#if BN220_USE_SWAR
+        // 0) Copy a run of ordinary sentence bytes in one go, folding them
+        //    into the checksum; framing bytes fall through to the byte path
+        if (ctx->inSentence && ctx->csState == 0) {
+            size_t room = (size_t)(BN220_LINE_MAX - 1 - ctx->len);
+            size_t run  = gpsSwarRun(bytes + i, n - i < room ? n - i : room, &ctx->csCalc);
+            memcpy(ctx->line + ctx->len, bytes + i, run);
+            ctx->len += (uint8_t)run;
+            i += run;
+            if (i >= n)
+                break;
+        }
+#endif
+        char c = (char)bytes[i];
+
+        // 1) '$' always starts a new sentence, even if the previous one was cut
+        if (c == '$') {
+            ctx->len = 0;
+            ctx->inSentence = 1;
+            ctx->csCalc = 0;
+            ctx->csRecv = 0;
+            ctx->csState = 0;
+            continue;
+        }
+        if (!ctx->inSentence)
+            continue;
+
+        // 2) End of line: decode what we have
+        if (c == '\n') {
+            ctx->line[ctx->len] = '\0';
+            ctx->inSentence = 0;
+            BN220_STAT(ctx, sentences);
+            if (!gpsChecksumAccept(ctx)) {
+                BN220_STAT(ctx, checksumErrors);
+                continue;
+            }
+#if BN220_ENABLE_GSV
+            // Any other sentence after the GSV group closes the table; unlike
+            // onEpoch this does not depend on the epoch having a fix
+            if (ctx->gps.satPhase == 'V' && !gpsIsType(ctx->line, "GSV")) {
+                ctx->gps.satPhase = 'C';
+                if (ctx->onSats)
+                    ctx->onSats(ctx->user, &ctx->gps);
+            }
+#endif
+            int sentence = gpsDispatch(&ctx->gps, ctx->line);
+            if (sentence)
+                BN220_STAT(ctx, decoded);
+            // GGA is the last position sentence of a BN-220 epoch (after RMC/VTG)
+            if (sentence == SENTENCE_GGA && ctx->onEpoch) {
+                BN220_Fix fix;
+                gpsToFix(&ctx->gps, &fix);
+                ctx->onEpoch(ctx->user, &fix);
+            }
+            continue;
+        }
+
+        // 3) Accumulate; an over-long line cannot be valid NMEA, drop it
+        if (ctx->len >= BN220_LINE_MAX - 1) {
+            ctx->inSentence = 0;
+            BN220_STAT(ctx, overflows);
+            continue;
+        }
+        ctx->line[ctx->len++] = c;
+
+        // 4) Checksum in the same pass: XOR up to '*', then two hex digits
+        if (ctx->csState == 0) {
+            if (c == '*')
+                ctx->csState = 1;
+            else
+                ctx->csCalc ^= (uint8_t)c;
+        } else if (ctx->csState < 3) {
+            int h = gpsHexDigit(c);
+            if (h < 0) {
+                ctx->csState = 4;
+            } else {
+                ctx->csRecv = (uint8_t)((ctx->csRecv << 4) | h);
+                ctx->csState++;
+            }
+        } else if (ctx->csState == 3 && c != '\r') {
+            ctx->csState = 4;   // only the line ending may follow the digits
+        }
+    }
+}
+
+
+/*
+ * Checkpoint blob layout (little-endian, same build only):
+ *   'B' 'N' version stateSize(2) | gps fields before sats[] |
+ *   [satCount satSeq satPhase sats[satCount] usedLen satUsedPrn[usedLen]] | [stats] |
+ *   inSentence csPolicy csCalc csRecv csState csLastCalc csLastRecv len line[len] |
+ *   fletcher16(2)
+ * Only the satellites in the table are stored, and the used-PRN bitmap up
+ * to its last non-zero byte, so an idle context gives a short blob.
+ */
+static uint16_t gpsFletcher16(const uint8_t *p, size_t n) {
+    uint16_t a = 0, b = 0;
+    while (n--) {
+        a = (a + *p++) % 255;
+        b = (b + a) % 255;
+    }
+    return (uint16_t)((b << 8) | a);
+}
+
+
+#define CHECKPOINT_STATE (sizeof(BN220_GPS) + BN220_STATS_SIZE)
+#define CHECKPOINT_FRAME 8
+#if BN220_ENABLE_GSV
+#define CHECKPOINT_HEAD  offsetof(BN220_GPS, sats)
+#else
+#define CHECKPOINT_HEAD  sizeof(BN220_GPS)
+#endif
+
+#if BN220_ENABLE_GSV
+static uint8_t gpsUsedLen(const BN220_GPS *gps_data) {
+    uint8_t n = sizeof(gps_data->satUsedPrn);
+    while (n && !gps_data->satUsedPrn[n - 1])
+        n--;
+    return n;
+}
+#endif
+
+size_t gpsCheckpoint(const BN220_Context *ctx, uint8_t *out, size_t out_len) {
+    if (!ctx || !out)
+        return 0;
+
+    size_t need = 5 + CHECKPOINT_HEAD + BN220_STATS_SIZE + CHECKPOINT_FRAME + ctx->len + 2;
+#if BN220_ENABLE_GSV
+    uint8_t used = gpsUsedLen(&ctx->gps);
+    need += 4 + ctx->gps.satCount * sizeof(BN220_Sat) + used;
+#endif
+    if (out_len < need)
+        return 0;
+
+    uint8_t *p = out;
+
+    // 1) Header
+    *p++ = 'B';
+    *p++ = 'N';
+    *p++ = BN220_CHECKPOINT_VERSION;
+    *p++ = (uint8_t)CHECKPOINT_STATE;
+    *p++ = (uint8_t)(CHECKPOINT_STATE >> 8);
+
+    // 2) Decoded state: the fixed fields, then the used part of the satellite table
+    memcpy(p, &ctx->gps, CHECKPOINT_HEAD);
+    p += CHECKPOINT_HEAD;
+#if BN220_ENABLE_GSV
+    *p++ = ctx->gps.satCount;
+    *p++ = ctx->gps.satSeq;
+    *p++ = ctx->gps.satPhase;
+    memcpy(p, ctx->gps.sats, ctx->gps.satCount * sizeof(BN220_Sat));
+    p += ctx->gps.satCount * sizeof(BN220_Sat);
+    *p++ = used;
+    memcpy(p, ctx->gps.satUsedPrn, used);
+    p += used;
+#endif
+
+    // 3) Counters and the partial sentence
+#if BN220_ENABLE_STATS
+    memcpy(p, &ctx->stats, sizeof(ctx->stats));
+    p += sizeof(ctx->stats);
+#endif
+    *p++ = ctx->inSentence;
+    *p++ = ctx->csPolicy;
+    *p++ = ctx->csCalc;
+    *p++ = ctx->csRecv;
+    *p++ = ctx->csState;
+    *p++ = ctx->csLastCalc;
+    *p++ = ctx->csLastRecv;
+    *p++ = ctx->len;
+    memcpy(p, ctx->line, ctx->len);
+    p += ctx->len;
+
+    // 4) Trailer
+    uint16_t cs = gpsFletcher16(out, (size_t)(p - out));
+    *p++ = (uint8_t)cs;
+    *p++ = (uint8_t)(cs >> 8);
+
+    return (size_t)(p - out);
+}
+
+
+int gpsRestore(BN220_Context *ctx, const uint8_t *blob, size_t len) {
+    if (!ctx || !blob || len < 5 + CHECKPOINT_HEAD + BN220_STATS_SIZE + CHECKPOINT_FRAME + 2)
+        return 0;
+
+    // 1) Header must match this build
+    if (blob[0] != 'B' || blob[1] != 'N' || blob[2] != BN220_CHECKPOINT_VERSION)
+        return 0;
+    if ((size_t)(blob[3] | (blob[4] << 8)) != CHECKPOINT_STATE)
+        return 0;
+
+    // 2) Locate the variable-length parts; bytes past the blob are ignored
+    const uint8_t *end = blob + len;
+    const uint8_t *p   = blob + 5 + CHECKPOINT_HEAD;
+#if BN220_ENABLE_GSV
+    const uint8_t *sat = p;
+    if (end - p < 4 || sat[0] > BN220_SAT_MAX ||
+        (size_t)(end - p) < 4 + sat[0] * sizeof(BN220_Sat))
+        return 0;
+    p += 3 + sat[0] * sizeof(BN220_Sat);
+    const uint8_t *used = p++;
+    if (*used > sizeof(ctx->gps.satUsedPrn) || end - p < *used)
+        return 0;
+    p += *used;
+#endif
+    if ((size_t)(end - p) < BN220_STATS_SIZE + CHECKPOINT_FRAME)
+        return 0;
+    const uint8_t *f = p + BN220_STATS_SIZE;
+    uint8_t line_len = f[7];
+    p = f + CHECKPOINT_FRAME;
+
+    // 3) Length and integrity
+    if (line_len >= BN220_LINE_MAX || (size_t)(end - p) < (size_t)line_len + 2)
+        return 0;
+    p += line_len;
+    uint16_t cs = (uint16_t)(p[0] | (p[1] << 8));
+    if (cs != gpsFletcher16(blob, (size_t)(p - blob)))
+        return 0;
+
+    // 4) Everything checks out, apply it
+    memset(&ctx->gps, 0, sizeof(ctx->gps));
+    memcpy(&ctx->gps, blob + 5, CHECKPOINT_HEAD);
+#if BN220_ENABLE_GSV
+    ctx->gps.satCount = sat[0];
+    ctx->gps.satSeq   = sat[1];
+    ctx->gps.satPhase = sat[2];
+    memcpy(ctx->gps.sats, sat + 3, sat[0] * sizeof(BN220_Sat));
+    memcpy(ctx->gps.satUsedPrn, used + 1, *used);
+#endif
+#if BN220_ENABLE_STATS
+    memcpy(&ctx->stats, f - BN220_STATS_SIZE, sizeof(ctx->stats));
+#endif
+    ctx->inSentence = f[0];
+    ctx->csPolicy   = f[1];
+    ctx->csCalc     = f[2];
+    ctx->csRecv     = f[3];
+    ctx->csState    = f[4];
+    ctx->csLastCalc = f[5];
+    ctx->csLastRecv = f[6];
+    ctx->len = line_len;
+    memcpy(ctx->line, f + CHECKPOINT_FRAME, line_len);
+    return 1;
+}
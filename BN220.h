@@ -34,10 +34,32 @@
 #ifndef INC_BN220_H_
 #define INC_BN220_H_
 
+#include "BN220_config.h"
 #include <string.h>
 #include <stdlib.h>
+#if BN220_PLATFORM_HAL
 #include <stm32h523xx.h> // that changes with STM model
 #include <stm32h5xx_hal.h>
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif
+
+/*
+ * One satellite in view, from GSV (and GSA for the used flag).  PRNs follow
+ * the NMEA 4.0 numbering of the BN-220: GPS 1-32, SBAS 33-64, GLONASS 65-96.
+ */
+typedef struct {
+    uint8_t  prn;     // satellite id
+    char     talker;  // second talker letter of the GSV: 'P' GPS, 'L' GLONASS, ...
+    int8_t   elev;    // elevation in degrees, 0-90
+    uint8_t  snr;     // C/N0 in dB-Hz, 0 = not tracked
+    uint16_t azim;    // azimuth in degrees, 0-359; BN220_SAT_NO_POS if elev/azim were empty
+    uint8_t  used;    // listed in this epoch's GSA
+    uint8_t  reserved;
+} BN220_Sat;
+
+#define BN220_SAT_NO_POS 0xFFFF
 
 typedef struct NMEA_SENTENCES {
     double lat; //latitude in degrees with decimal places
@@ -45,12 +67,94 @@ typedef struct NMEA_SENTENCES {
     double lon; //longitude in degrees with decimal places
     char EW; // E or W
     float altitude; //altitude in meters
+    float geoidSep; // geoid separation in meters: ellipsoid height = altitude + geoidSep (GGA)
     float hdop; //horizontal dilution of precision
     int satelliteCount; //number of satellites used in measurement
     int fix; // 1 = fix, 0 = no fix
     char lastMeasure[10]; // hhmmss.ss UTC of last successful measurement; time read from the GPS module
+    float speed; // ground speed in m/s (RMC)
+    char date[7]; // ddmmyy UTC date (RMC)
+#if BN220_ENABLE_GSV
+    BN220_Sat sats[BN220_SAT_MAX]; // satellites in view, rebuilt from each epoch's GSV groups
+    uint8_t satCount; // entries in sats[]
+    uint8_t satSeq; // incremented whenever a new table starts
+    uint8_t satPhase; // internal: 'A' after a GSA, 'V' after a GSV, 'C' once the table is closed
+    uint8_t satUsedPrn[32]; // internal: bitmap of the PRNs listed in this epoch's GSA
+#endif
 } BN220_GPS;
 
+/*
+ * Compact, integer-only fix record for storage, transport and host-side
+ * processing.  Build one from BN220_GPS with gpsToFix().
+ */
+typedef struct {
+    int64_t  utc_ms;    // UTC ms since 1970-01-01, or ms of day when the date is unknown
+    int32_t  lat_e7;    // latitude in 1e-7 degrees, south negative
+    int32_t  lon_e7;    // longitude in 1e-7 degrees, west negative
+    int32_t  alt_mm;    // altitude above mean sea level in millimetres
+    uint16_t speed_cms; // ground speed in cm/s
+    uint16_t hdop_c;    // hdop x 100
+    uint8_t  sats;      // satellites used
+    uint8_t  fix;       // 1 = fix, 0 = no fix
+    uint8_t  reserved[6];
+} BN220_Fix;
+
+#if BN220_ENABLE_STATS
+typedef struct {
+    uint32_t sentences;      // complete lines seen
+    uint32_t decoded;        // lines accepted by a decoder
+    uint32_t checksumErrors; // lines dropped on checksum
+    uint32_t overflows;      // lines longer than BN220_LINE_MAX
+} BN220_Stats;
+#endif
+
+/*
+ * Checksum handling for sentences received through gpsFeed.  The XOR is
+ * accumulated while the sentence is framed, so no mode re-scans the line.
+ */
+typedef enum {
+    BN220_CS_VERIFY = 0, // drop sentences whose checksum does not match (default)
+    BN220_CS_SKIP,       // trusted link: accept every complete sentence
+    BN220_CS_REPORT,     // verify, and keep the computed/received values in csLast*
+} BN220_ChecksumPolicy;
+
+#define BN220_LINE_MAX 96 // NMEA 0183 caps a sentence at 82 characters; keep some margin
+
+/*
+ * Streaming parser context.  Bytes can be fed in arbitrary chunks (DMA
+ * half/full transfer, single-byte RX interrupt...); a sentence split across
+ * two chunks is kept in line[] until its end arrives.
+ */
+typedef struct {
+    BN220_GPS gps;                  // decoded state, updated in place
+    char      line[BN220_LINE_MAX]; // sentence being assembled, without the leading '$'
+    uint8_t   len;                  // number of bytes held in line[]
+    uint8_t   inSentence;           // 1 between '$' and the end of line
+    uint8_t   csPolicy;             // BN220_ChecksumPolicy, evaluated once per sentence
+    uint8_t   csCalc;               // running XOR of the current sentence
+    uint8_t   csRecv;               // checksum digits read after '*'
+    uint8_t   csState;              // 0: before '*', 1-3: '*' plus 0-2 hex digits, 4: malformed
+    uint8_t   csLastCalc;           // BN220_CS_REPORT: computed checksum of the last sentence
+    uint8_t   csLastRecv;           // BN220_CS_REPORT: transmitted checksum of the last sentence
+    void    (*onEpoch)(void *user, const BN220_Fix *fix); // optional, called once per decoded GGA
+#if BN220_ENABLE_GSV
+    void    (*onSats)(void *user, const BN220_GPS *gps);  // optional, called once per complete GSV table
+#endif
+    void     *user;                 // passed to onEpoch / onSats
+#if BN220_ENABLE_STATS
+    BN220_Stats stats;
+#endif
+} BN220_Context;
+
+#if BN220_ENABLE_STATS
+#define BN220_STATS_SIZE sizeof(BN220_Stats)
+#else
+#define BN220_STATS_SIZE 0
+#endif
+
+#define BN220_CHECKPOINT_VERSION 7
+#define BN220_CHECKPOINT_MAX     (20 + sizeof(BN220_GPS) + BN220_STATS_SIZE + BN220_LINE_MAX)
+
 /**
  * @brief  Parse raw BN-220 data and populate @p gps_data.
  *
@@ -60,5 +164,77 @@ typedef struct NMEA_SENTENCES {
  * Fills fix status, latitude, longitude, altitude, velocity and time after
  * checksum verification. No return value.
  */
+#if BN220_ENABLE_LEGACY_PARSE
 void gpsParse(BN220_GPS *gps_data, uint8_t *buffer);
+#endif
+
+/**
+ * @brief  Verify the XOR checksum of one sentence (without the leading '$').
+ *
+ * Returns 1 when the two hex digits after '*' match, 0 otherwise.
+ */
+int getChecksum(const char* gps_sentence);
+
+/**
+ * @brief  Convert the parsed state into a compact fix record.
+ *
+ * @param[in]  gps_data  Parsed GPS state.
+ * @param[out] fix       Destination record.
+ *
+ * utc_ms is a full timestamp once RMC has supplied the date, otherwise the
+ * millisecond of the day.
+ */
+void gpsToFix(const BN220_GPS *gps_data, BN220_Fix *fix);
+
+/**
+ * @brief  Days between 1970-01-01 and the given civil date (proleptic Gregorian).
+ */
+int32_t gpsDaysFromCivil(int32_t year, uint32_t month, uint32_t day);
+
+/**
+ * @brief  Reset @p ctx to an empty state before the first gpsFeed call.
+ */
+void gpsInit(BN220_Context *ctx);
+
+/**
+ * @brief  Feed raw receiver bytes into the streaming parser.
+ *
+ * @param[in,out] ctx    Parser context.
+ * @param[in]     bytes  Received bytes; may start or end mid-sentence.
+ * @param[in]     n      Number of bytes.
+ *
+ * Every complete sentence accepted by ctx->csPolicy updates ctx->gps.
+ * Each decoded GGA closes an epoch and, if set, calls ctx->onEpoch with the
+ * current state as a BN220_Fix.  With GSV enabled, the first other sentence
+ * after a run of GSVs closes the satellite table and calls ctx->onSats,
+ * whether or not the receiver has a fix (a GGA without a position does not
+ * decode and raises no onEpoch).
+ */
+void gpsFeed(BN220_Context *ctx, const uint8_t *bytes, size_t n);
+
+/**
+ * @brief  Serialise the parser context into a compact blob.
+ *
+ * @param[in]  ctx      Parser context.
+ * @param[out] out      Destination, e.g. backup SRAM before entering STOP mode.
+ * @param[in]  out_len  Size of @p out; BN220_CHECKPOINT_MAX always suffices.
+ *
+ * Only the used parts of the satellite table and of the partial sentence
+ * are stored.  The blob is tied to the build that wrote it.  Returns the
+ * blob length, or 0 if @p out is too small.
+ */
+size_t gpsCheckpoint(const BN220_Context *ctx, uint8_t *out, size_t out_len);
+
+/**
+ * @brief  Restore a context written by gpsCheckpoint.
+ *
+ * @param[in]  len  Bytes available at @p blob: the length gpsCheckpoint
+ *                  returned, or the size of the whole region it was written
+ *                  to; bytes after the encoded blob are ignored.
+ *
+ * Returns 1 on success.  On a corrupt or foreign blob, @p ctx is left
+ * untouched and 0 is returned; call gpsInit in that case.  The callbacks and
+ * user are not part of the blob and keep their current values.
+ */
+int gpsRestore(BN220_Context *ctx, const uint8_t *blob, size_t len);
 #endif /* INC_BN220_H_ */
@@ -0,0 +1,153 @@
+/*
+ * BN220_aiding.c — Warm-start aiding for the BN-220 GPS receiver
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_aiding.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Last-fix persistence and UBX-MGA-INI aiding injection.
+ * ---------------------------------------------------------------------------
+ */
+
+#include "BN220_aiding.h"
+
+#if BN220_ENABLE_UBX
+
+// Accuracy we claim for a stored position: hdop times a nominal 5 m UERE,
+// but never tighter than 100 m since the device may have moved while off.
+#define AIDING_UERE_CM     500.0f
+#define AIDING_MIN_ACC_CM  10000u
+
+#define MGA_INI_POS_LLH    0x01
+#define MGA_INI_TIME_UTC   0x10
+
+
+static uint16_t aidingChecksum(const BN220_AidingRecord *rec) {
+    // Fletcher-16 over everything after the checksum field
+    const uint8_t *p   = (const uint8_t *)&rec->lat_e7;
+    const uint8_t *end = (const uint8_t *)rec + sizeof(*rec);
+    uint16_t a = 0, b = 0;
+
+    for (; p < end; ++p) {
+        a = (a + *p) % 255;
+        b = (b + a) % 255;
+    }
+    return (uint16_t)((b << 8) | a);
+}
+
+
+int gpsAidingSave(const BN220_AidingStore *store, const BN220_GPS *gps_data) {
+    BN220_AidingRecord rec;
+    BN220_Fix fix;
+
+    if (!store || !store->save || !gps_data || !gps_data->fix)
+        return 0;
+
+    // 1) Clear padding so the checksum is reproducible
+    memset(&rec, 0, sizeof(rec));
+
+    // 2) Position in the integer units used by MGA-INI-POS_LLH
+    gpsToFix(gps_data, &fix);
+    rec.lat_e7 = fix.lat_e7;
+    rec.lon_e7 = fix.lon_e7;
+    // MGA-INI-POS_LLH wants height above the ellipsoid, GGA gives MSL
+    rec.alt_cm = (int32_t)((gps_data->altitude + gps_data->geoidSep) * 100.0f);
+
+    uint32_t acc = (uint32_t)(gps_data->hdop * AIDING_UERE_CM);
+    rec.posAcc_cm = acc < AIDING_MIN_ACC_CM ? AIDING_MIN_ACC_CM : acc;
+
+    memcpy(rec.lastMeasure, gps_data->lastMeasure, sizeof(rec.lastMeasure));
+    rec.lastMeasure[sizeof(rec.lastMeasure) - 1] = '\0';
+
+    // 3) Seal the record
+    rec.magic    = BN220_AIDING_MAGIC;
+    rec.version  = BN220_AIDING_VERSION;
+    rec.checksum = aidingChecksum(&rec);
+
+    return store->save(store->user, &rec, sizeof(rec));
+}
+
+
+static int aidingSendPos(const BN220_AidingRecord *rec, BN220_WriteFn write, void *port) {
+    uint8_t pl[20];
+
+    memset(pl, 0, sizeof(pl));
+    pl[0] = MGA_INI_POS_LLH;  // type
+    pl[1] = 0;                // version
+    ubxPutU32(&pl[4],  (uint32_t)rec->lat_e7);
+    ubxPutU32(&pl[8],  (uint32_t)rec->lon_e7);
+    ubxPutU32(&pl[12], (uint32_t)rec->alt_cm);
+    ubxPutU32(&pl[16], rec->posAcc_cm);
+
+    return ubxSend(write, port, UBX_CLASS_MGA, UBX_MGA_INI, pl, sizeof(pl));
+}
+
+
+static int aidingSendTime(const BN220_UtcTime *now, BN220_WriteFn write, void *port) {
+    uint8_t pl[24];
+
+    memset(pl, 0, sizeof(pl));
+    pl[0]  = MGA_INI_TIME_UTC; // type
+    pl[1]  = 0;                // version
+    pl[2]  = 0;                // ref: none, time is valid on receipt
+    pl[3]  = (uint8_t)-128;    // leapSecs: unknown
+    ubxPutU16(&pl[4], now->year);
+    pl[6]  = now->month;
+    pl[7]  = now->day;
+    pl[8]  = now->hour;
+    pl[9]  = now->minute;
+    pl[10] = now->second;
+    ubxPutU32(&pl[12], 0);     // ns
+    ubxPutU16(&pl[16], now->accuracy_s ? now->accuracy_s : 1);
+    ubxPutU32(&pl[20], 0);     // tAccNs
+
+    return ubxSend(write, port, UBX_CLASS_MGA, UBX_MGA_INI, pl, sizeof(pl));
+}
+
+
+int gpsAidingInject(const BN220_AidingStore *store, const BN220_UtcTime *now,
+                    BN220_WriteFn write, void *port) {
+    BN220_AidingRecord rec;
+    int sent = 0;
+
+    if (!store || !store->load || !write)
+        return 0;
+
+    // 1) Time first: the receiver needs it to make use of the position
+    if (now && now->year >= 2020 && now->month >= 1 && now->month <= 12 &&
+        now->day >= 1 && now->day <= 31) {
+        sent += aidingSendTime(now, write, port);
+    }
+
+    // 2) Last known position, only if the stored record is intact
+    if (!store->load(store->user, &rec, sizeof(rec)))
+        return sent;
+    if (rec.magic != BN220_AIDING_MAGIC || rec.version != BN220_AIDING_VERSION ||
+        rec.checksum != aidingChecksum(&rec))
+        return sent;
+
+    sent += aidingSendPos(&rec, write, port);
+    return sent;
+}
+
+#endif /* BN220_ENABLE_UBX */
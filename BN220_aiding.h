@@ -0,0 +1,102 @@
+/*
+ * BN220_aiding.h — Warm-start aiding for the BN-220 GPS receiver
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_aiding.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Persist the last good fix to a caller-provided store and replay it
+ *          at boot as UBX-MGA-INI position/time aiding to shorten TTFF.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_AIDING_H_
+#define INC_BN220_AIDING_H_
+
+#include "BN220.h"
+#include "BN220_ubx.h"
+
+#define BN220_AIDING_MAGIC    0x414E4742u  // "BGNA"
+#define BN220_AIDING_VERSION  2
+
+typedef struct {
+    uint32_t magic;        // BN220_AIDING_MAGIC when the record is valid
+    uint16_t version;      // BN220_AIDING_VERSION
+    uint16_t checksum;     // Fletcher-16 over the remaining fields
+    int32_t  lat_e7;       // latitude in 1e-7 degrees, south negative
+    int32_t  lon_e7;       // longitude in 1e-7 degrees, west negative
+    int32_t  alt_cm;       // height above the WGS84 ellipsoid in centimetres
+    uint32_t posAcc_cm;    // estimated position accuracy in centimetres
+    char     lastMeasure[10]; // hhmmss.ss UTC of the saved fix
+} BN220_AidingRecord;
+
+/**
+ * Caller-provided non-volatile store (flash page, EEPROM, backup SRAM...).
+ * Both hooks return 1 on success, 0 on failure.
+ */
+typedef struct {
+    int  (*save)(void *user, const void *blob, uint16_t len);
+    int  (*load)(void *user, void *blob, uint16_t len);
+    void *user;
+} BN220_AidingStore;
+
+/**
+ * Current UTC time, typically read from the RTC at boot.  @p accuracy_s is
+ * the expected error of the clock in seconds (drift since it was last set).
+ */
+typedef struct {
+    uint16_t year;
+    uint8_t  month;
+    uint8_t  day;
+    uint8_t  hour;
+    uint8_t  minute;
+    uint8_t  second;
+    uint16_t accuracy_s;
+} BN220_UtcTime;
+
+/**
+ * @brief  Save the current fix as the next boot's aiding position.
+ *
+ * @param[in] store     Non-volatile store hooks.
+ * @param[in] gps_data  Parsed GPS state; ignored unless it holds a fix.
+ *
+ * Returns 1 when a record was written.  Flash-backed stores should call this
+ * sparingly (e.g. once per minute or on power-down warning) to limit wear.
+ */
+int gpsAidingSave(const BN220_AidingStore *store, const BN220_GPS *gps_data);
+
+/**
+ * @brief  Load the saved fix and send MGA-INI-POS_LLH and MGA-INI-TIME_UTC.
+ *
+ * @param[in] store  Non-volatile store hooks.
+ * @param[in] now    Current UTC time, or NULL to send position aiding only.
+ * @param[in] write  Port hook used to send the UBX frames.
+ * @param[in] port   Opaque pointer passed to @p write.
+ *
+ * Call once after power-up, before feeding received bytes to gpsParse.
+ * Returns the number of aiding frames accepted by the port (0, 1 or 2).
+ */
+int gpsAidingInject(const BN220_AidingStore *store, const BN220_UtcTime *now,
+                    BN220_WriteFn write, void *port);
+
+#endif /* INC_BN220_AIDING_H_ */
@@ -0,0 +1,242 @@
+/*
+ * BN220_batch.c — Multi-stream batch GGA decoder
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_batch.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Gather/convert/scatter implementation of gpsBatchGGA.  The
+ *          conversion loops are written over fixed lane counts so the
+ *          compiler maps them onto SSE/AVX/NEON registers.
+ * ---------------------------------------------------------------------------
+ */
+
+#include "BN220_batch.h"
+
+#define L BN220_BATCH_LANES
+
+// Digits kept per field after normalising to a fixed layout
+#define TIME_DIGITS  9   // hhmmss + 3 fraction digits (ms)
+#define LAT_DIGITS   9   // ddmm   + 5 fraction digits
+#define LON_DIGITS  10   // dddmm  + 5 fraction digits
+#define ALT_DIGITS   8   // up to 99999 m + 3 fraction digits (mm)
+#define HDOP_DIGITS  4   // up to 99 + 2 fraction digits
+#define SATS_DIGITS  2
+
+/*
+ * One batch in structure-of-arrays form: digit k of field F for lane l
+ * lives at F[k][l], so every conversion step walks contiguous lanes.
+ */
+typedef struct {
+    uint8_t time[TIME_DIGITS][L];
+    uint8_t lat[LAT_DIGITS][L];
+    uint8_t lon[LON_DIGITS][L];
+    uint8_t alt[ALT_DIGITS][L];
+    uint8_t hdop[HDOP_DIGITS][L];
+    uint8_t sats[SATS_DIGITS][L];
+    uint8_t quality[L];
+    uint8_t latNeg[L];
+    uint8_t lonNeg[L];
+    uint8_t altNeg[L];
+    uint8_t valid[L];
+} BatchLanes;
+
+
+static inline int batchIsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static inline int batchHex(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+
+// Transposes the digits of one "iii.fff" field into col[..][lane].  With
+// @p exact the integer part must have exactly @p intDigits digits (fixed
+// NMEA layout); otherwise a shorter one is left-padded with zeros.  Missing
+// fraction digits are zero-filled, extra ones are dropped.  An empty field
+// reads as 0: lanes carry no state from earlier sentences to fall back on.
+static int batchField(const char *f, size_t len, int intDigits, int fracDigits,
+                      int exact, uint8_t (*col)[L], int lane) {
+    if (len == 0) {
+        for (int k = 0; k < intDigits + fracDigits; k++)
+            col[k][lane] = 0;
+        return 1;
+    }
+
+    size_t intLen = 0;
+    while (intLen < len && f[intLen] != '.')
+        intLen++;
+
+    if (intLen == 0 || intLen > (size_t)intDigits || (exact && intLen != (size_t)intDigits))
+        return 0;
+
+    int pad = intDigits - (int)intLen;
+    for (int k = 0; k < pad; k++)
+        col[k][lane] = 0;
+    for (size_t k = 0; k < intLen; k++) {
+        if (!batchIsDigit(f[k]))
+            return 0;
+        col[pad + k][lane] = (uint8_t)(f[k] - '0');
+    }
+    for (int k = 0; k < fracDigits; k++) {
+        size_t idx = intLen + 1 + (size_t)k;
+        char c = idx < len ? f[idx] : '0';
+        if (!batchIsDigit(c))
+            return 0;
+        col[intDigits + k][lane] = (uint8_t)(c - '0');
+    }
+    return 1;
+}
+
+
+// Scalar part: split one sentence, check it, and transpose its digits
+static int batchGather(const char *s, BatchLanes *b, int lane) {
+    const char *f[10];
+    size_t      fl[10];
+    int         nf = 0;
+    uint8_t     cs = 0;
+
+    if (*s == '$')
+        s++;
+
+    // 1) Field boundaries and checksum in one pass
+    const char *start = s, *p = s;
+    for (; *p && *p != '*' && *p != '\r' && *p != '\n'; p++) {
+        cs ^= (uint8_t)*p;
+        if (*p == ',') {
+            if (nf < 10) {
+                f[nf]  = start;
+                fl[nf] = (size_t)(p - start);
+                nf++;
+            }
+            start = p + 1;
+        }
+    }
+    if (*p != '*' || nf < 10)
+        return 0;
+    int hi = batchHex(p[1]), lo = batchHex(p[2]);
+    if (hi < 0 || lo < 0 || cs != (uint8_t)((hi << 4) | lo))
+        return 0;
+    if (fl[0] != 5 || memcmp(f[0] + 2, "GGA", 3) != 0)
+        return 0;
+
+    // 2) Hemispheres (empty only with an empty coordinate) and quality
+    if (fl[3] != (fl[2] ? 1u : 0u) || (fl[3] && f[3][0] != 'N' && f[3][0] != 'S')) return 0;
+    if (fl[5] != (fl[4] ? 1u : 0u) || (fl[5] && f[5][0] != 'E' && f[5][0] != 'W')) return 0;
+    if (fl[6] != 1 || !batchIsDigit(f[6][0])) return 0;
+    b->latNeg[lane]  = fl[3] && f[3][0] == 'S';
+    b->lonNeg[lane]  = fl[5] && f[5][0] == 'W';
+    b->quality[lane] = (uint8_t)(f[6][0] - '0');
+
+    // 3) Numeric fields
+    const char *alt = f[9];
+    size_t      altLen = fl[9];
+    b->altNeg[lane] = altLen > 0 && alt[0] == '-';
+    if (b->altNeg[lane]) {
+        alt++;
+        altLen--;
+    }
+
+    return batchField(f[1], fl[1], 6, 3, 1, b->time, lane) &&
+           batchField(f[2], fl[2], 4, 5, 1, b->lat,  lane) &&
+           batchField(f[4], fl[4], 5, 5, 1, b->lon,  lane) &&
+           batchField(f[7], fl[7], 2, 0, 0, b->sats, lane) &&
+           batchField(f[8], fl[8], 2, 2, 0, b->hdop, lane) &&
+           batchField(alt,  altLen, 5, 3, 0, b->alt, lane);
+}
+
+
+// Lane-wise decimal accumulate: acc[l] = acc[l] * 10 + digit[k][l]
+#define BATCH_ACCUMULATE(acc, col, ndig)              \
+    do {                                              \
+        for (int l_ = 0; l_ < L; l_++) (acc)[l_] = 0; \
+        for (int k_ = 0; k_ < (ndig); k_++)           \
+            for (int l_ = 0; l_ < L; l_++)            \
+                (acc)[l_] = (acc)[l_] * 10u + (col)[k_][l_]; \
+    } while (0)
+
+
+size_t gpsBatchGGA(const char *const *sentences, const int64_t *day_ms, size_t n,
+                   BN220_Fix *out, uint8_t *ok) {
+    BatchLanes b;
+    uint32_t   tod[L], lat[L], lon[L], alt[L], hdop[L], sats[L];
+    size_t     decoded = 0;
+
+    for (size_t base = 0; base < n; base += L) {
+        int lanes = n - base < L ? (int)(n - base) : L;
+
+        // 1) Gather: scalar split/validate, transposed store
+        memset(&b, 0, sizeof(b));
+        for (int l = 0; l < lanes; l++)
+            b.valid[l] = (uint8_t)batchGather(sentences[base + l], &b, l);
+
+        // 2) Digits to integers, all lanes at once
+        BATCH_ACCUMULATE(tod,  b.time, TIME_DIGITS);
+        BATCH_ACCUMULATE(lat,  b.lat,  LAT_DIGITS);
+        BATCH_ACCUMULATE(lon,  b.lon,  LON_DIGITS);
+        BATCH_ACCUMULATE(alt,  b.alt,  ALT_DIGITS);
+        BATCH_ACCUMULATE(hdop, b.hdop, HDOP_DIGITS);
+        BATCH_ACCUMULATE(sats, b.sats, SATS_DIGITS);
+
+        // 3) Unit conversion, still lane-wise and branch-free
+        for (int l = 0; l < L; l++) {
+            uint32_t hh = tod[l] / 10000000u, mm = tod[l] / 100000u % 100u;
+            uint32_t ss = tod[l] / 1000u % 100u, ms = tod[l] % 1000u;
+            tod[l] = ((hh * 60u + mm) * 60u + ss) * 1000u + ms;
+
+            // ddmm.mmmmm -> 1e-7 deg: minutes x 1e5 scaled by 100/60
+            uint32_t latMin = lat[l] % 10000000u, lonMin = lon[l] % 10000000u;
+            lat[l] = lat[l] / 10000000u * 10000000u + (latMin * 5u + 1u) / 3u;
+            lon[l] = lon[l] / 10000000u * 10000000u + (lonMin * 5u + 1u) / 3u;
+
+            uint32_t ln = b.latNeg[l], on = b.lonNeg[l], an = b.altNeg[l];
+            lat[l] = (lat[l] ^ (0u - ln)) + ln;
+            lon[l] = (lon[l] ^ (0u - on)) + on;
+            alt[l] = (alt[l] ^ (0u - an)) + an;
+        }
+
+        // 4) Scatter to per-device records
+        for (int l = 0; l < lanes; l++) {
+            BN220_Fix *fx = &out[base + l];
+            memset(fx, 0, sizeof(*fx));
+            if (ok)
+                ok[base + l] = b.valid[l];
+            if (!b.valid[l])
+                continue;
+
+            fx->utc_ms = (int64_t)tod[l] + (day_ms ? day_ms[base + l] : 0);
+            fx->lat_e7 = (int32_t)lat[l];
+            fx->lon_e7 = (int32_t)lon[l];
+            fx->alt_mm = (int32_t)alt[l];
+            fx->hdop_c = (uint16_t)hdop[l];
+            fx->sats   = (uint8_t)sats[l];
+            fx->fix    = b.quality[l] > 0;
+            decoded++;
+        }
+    }
+    return decoded;
+}
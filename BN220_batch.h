@@ -0,0 +1,73 @@
+/*
+ * BN220_batch.h — Multi-stream batch GGA decoder
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_batch.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Decodes GGA sentences from many devices in parallel lanes for
+ *          fleet backends: digits are transposed into lane vectors and
+ *          converted with lane-wise multiply-add.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_BATCH_H_
+#define INC_BN220_BATCH_H_
+
+#include "BN220.h"
+
+/*
+ * Number of sentences decoded side by side.  16 lanes of 32-bit
+ * accumulators fill two AVX2 or four SSE/NEON registers per digit step.
+ */
+#ifndef BN220_BATCH_LANES
+#define BN220_BATCH_LANES 16
+#endif
+
+/**
+ * @brief  Decode many GGA sentences, typically from different devices, at once.
+ *
+ * @param[in]  sentences  n sentences, with or without the leading '$'; each
+ *                        must be NUL- or CR/LF-terminated.
+ * @param[in]  day_ms     Optional per-sentence UTC midnight in ms since 1970
+ *                        (GGA carries no date); NULL leaves utc_ms as ms of day.
+ * @param[in]  n          Number of sentences.
+ * @param[out] out        n fix records, in input order.
+ * @param[out] ok         n flags, 1 when the sentence decoded; optional.
+ *
+ * Sentences are processed BN220_BATCH_LANES at a time: the digits of every
+ * numeric field are transposed into per-digit lane vectors, converted with
+ * lane-wise multiply-add, and scattered back to the records.  Checksum,
+ * field layout and hemisphere are validated per lane; a failing lane gets
+ * a zeroed record.  Returns the number of decoded sentences.
+ *
+ * Differences from the streaming decoder, which updates a BN220_GPS:
+ *  - Each sentence stands alone.  An empty field (time, position, sats,
+ *    hdop or altitude, as sent before the first fix) decodes as 0 instead
+ *    of keeping the previous sentence's value.
+ *  - GGA carries no speed, so speed_cms is always 0; take it from RMC/VTG.
+ */
+size_t gpsBatchGGA(const char *const *sentences, const int64_t *day_ms, size_t n,
+                   BN220_Fix *out, uint8_t *ok);
+
+#endif /* INC_BN220_BATCH_H_ */
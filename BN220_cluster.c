@@ -0,0 +1,410 @@
+/*
+ * BN220_cluster.c — Stop-point clustering
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_cluster.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Parallel radix grouping by cell, lock-free union-find over dense
+ *          cells and parallel labelling.
+ * ---------------------------------------------------------------------------
+ */
+
+#include "BN220_cluster.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define CLUSTER_LON_SPAN 3600000000LL  // 360° in 1e-7 degrees
+#define CLUSTER_LAT_SPAN 1800000000LL  // 180° in 1e-7 degrees
+#define CLUSTER_RADIX    256
+
+typedef struct {
+    uint64_t key;   // cy << 32 | cx
+    uint32_t idx;   // point index
+} ClusterItem;
+
+typedef struct ClusterJob ClusterJob;
+typedef void (*ClusterStep)(ClusterJob *job, unsigned t);
+
+struct ClusterJob {
+    const int32_t     *lat, *lon;
+    size_t             n;
+    int32_t            cell, ncx;
+    uint32_t           minPts;
+    unsigned           threads;
+
+    ClusterItem       *items, *tmp;       // radix sort ping-pong
+    uint64_t          *diff;              // per thread: key bits that vary
+    size_t           (*hist)[CLUSTER_RADIX];
+    unsigned           shift;
+
+    uint64_t          *cellKey;           // sorted unique cells
+    size_t            *cellStart;         // ncells + 1 offsets into items
+    size_t             ncells;
+    _Atomic uint32_t  *parent;            // union-find over cells
+    int32_t           *cellId;            // cluster of each dense cell
+    int32_t           *label;
+};
+
+
+/* --- Thread helpers ------------------------------------------------------- */
+
+typedef struct {
+    ClusterJob *job;
+    ClusterStep step;
+    unsigned    t;
+} ClusterArg;
+
+static void *clusterThread(void *arg) {
+    ClusterArg *a = arg;
+    a->step(a->job, a->t);
+    return NULL;
+}
+
+// Run step(job, t) for t = 0..threads-1, the last one on the calling thread
+static int clusterParallel(ClusterJob *job, ClusterStep step) {
+    ClusterArg *arg = malloc(sizeof(ClusterArg) * job->threads);
+    pthread_t  *tid = malloc(sizeof(pthread_t) * job->threads);
+    unsigned    started = 0;
+    int         ok = arg && tid;
+
+    for (; ok && started + 1 < job->threads; started++) {
+        arg[started] = (ClusterArg){ job, step, started };
+        if (pthread_create(&tid[started], NULL, clusterThread, &arg[started]) != 0) {
+            ok = 0;
+            break;
+        }
+    }
+    if (ok)
+        step(job, job->threads - 1);
+    for (unsigned i = 0; i < started; i++)
+        pthread_join(tid[i], NULL);
+    free(arg);
+    free(tid);
+    return ok;
+}
+
+static void clusterRange(size_t n, unsigned parts, unsigned t, size_t *lo, size_t *hi) {
+    *lo = n * t / parts;
+    *hi = n * (t + 1) / parts;
+}
+
+
+/* --- 1) Cell keys --------------------------------------------------------- */
+
+static inline uint32_t clusterWrapX(const ClusterJob *job, int64_t cx) {
+    cx %= job->ncx;
+    return (uint32_t)(cx < 0 ? cx + job->ncx : cx);
+}
+
+static inline uint64_t clusterKey(uint32_t cx, uint32_t cy) {
+    return ((uint64_t)cy << 32) | cx;
+}
+
+static void clusterKeys(ClusterJob *job, unsigned t) {
+    size_t lo, hi;
+    clusterRange(job->n, job->threads, t, &lo, &hi);
+
+    uint64_t first = 0, diff = 0;
+    for (size_t i = lo; i < hi; i++) {
+        uint32_t cx = clusterWrapX(job, ((int64_t)job->lon[i] + CLUSTER_LON_SPAN / 2) / job->cell);
+        uint32_t cy = (uint32_t)(((int64_t)job->lat[i] + CLUSTER_LAT_SPAN / 2) / job->cell);
+        uint64_t key = clusterKey(cx, cy);
+        if (i == lo)
+            first = key;
+        diff |= key ^ first;
+        job->items[i] = (ClusterItem){ key, (uint32_t)i };
+    }
+    job->diff[t] = diff;
+    job->diff[job->threads + t] = first;
+}
+
+
+/* --- 2) Parallel LSD radix sort on the key bytes that vary ---------------- */
+
+static void clusterHistogram(ClusterJob *job, unsigned t) {
+    size_t lo, hi;
+    clusterRange(job->n, job->threads, t, &lo, &hi);
+    size_t *h = job->hist[t];
+    memset(h, 0, sizeof(job->hist[t]));
+    for (size_t i = lo; i < hi; i++)
+        h[(job->items[i].key >> job->shift) & (CLUSTER_RADIX - 1)]++;
+}
+
+static void clusterScatter(ClusterJob *job, unsigned t) {
+    size_t lo, hi;
+    clusterRange(job->n, job->threads, t, &lo, &hi);
+    size_t *pos = job->hist[t];   // already turned into output offsets
+    for (size_t i = lo; i < hi; i++) {
+        const ClusterItem *it = &job->items[i];
+        job->tmp[pos[(it->key >> job->shift) & (CLUSTER_RADIX - 1)]++] = *it;
+    }
+}
+
+static int clusterSort(ClusterJob *job, uint64_t diff) {
+    for (job->shift = 0; job->shift < 64; job->shift += 8) {
+        if (!((diff >> job->shift) & 0xFF))
+            continue;   // byte is the same in every key
+        if (!clusterParallel(job, clusterHistogram))
+            return 0;
+
+        // Digit-major, thread-minor offsets keep the sort stable
+        size_t sum = 0;
+        for (unsigned d = 0; d < CLUSTER_RADIX; d++) {
+            for (unsigned t = 0; t < job->threads; t++) {
+                size_t c = job->hist[t][d];
+                job->hist[t][d] = sum;
+                sum += c;
+            }
+        }
+        if (!clusterParallel(job, clusterScatter))
+            return 0;
+
+        ClusterItem *swap = job->items;
+        job->items = job->tmp;
+        job->tmp   = swap;
+    }
+    return 1;
+}
+
+
+/* --- 3) Union-find over dense neighbouring cells -------------------------- */
+
+static int64_t clusterFindCell(const ClusterJob *job, uint64_t key) {
+    size_t lo = 0, hi = job->ncells;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (job->cellKey[mid] < key)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo < job->ncells && job->cellKey[lo] == key ? (int64_t)lo : -1;
+}
+
+static inline int clusterDense(const ClusterJob *job, size_t c) {
+    return job->cellStart[c + 1] - job->cellStart[c] >= job->minPts;
+}
+
+static uint32_t clusterFind(_Atomic uint32_t *parent, uint32_t x) {
+    for (;;) {
+        uint32_t p = atomic_load_explicit(&parent[x], memory_order_relaxed);
+        if (p == x)
+            return x;
+        uint32_t gp = atomic_load_explicit(&parent[p], memory_order_relaxed);
+        if (gp != p)    // path halving
+            atomic_compare_exchange_weak_explicit(&parent[x], &p, gp, memory_order_relaxed,
+                                                  memory_order_relaxed);
+        x = gp;
+    }
+}
+
+static void clusterUnion(_Atomic uint32_t *parent, uint32_t a, uint32_t b) {
+    for (;;) {
+        a = clusterFind(parent, a);
+        b = clusterFind(parent, b);
+        if (a == b)
+            return;
+        if (a > b) {
+            uint32_t t = a; a = b; b = t;
+        }
+        // Link the larger root under the smaller; retry if b stopped being a root
+        uint32_t expected = b;
+        if (atomic_compare_exchange_strong(&parent[b], &expected, a))
+            return;
+    }
+}
+
+// Visit the existing cells around c (8-neighbourhood, longitude wraps)
+#define CLUSTER_FOR_NEIGHBOURS(job, c, nb, body)                                        \
+    do {                                                                                \
+        uint32_t cx_ = (uint32_t)(job)->cellKey[c], cy_ = (uint32_t)((job)->cellKey[c] >> 32); \
+        for (int dy_ = -1; dy_ <= 1; dy_++) {                                           \
+            if ((int64_t)cy_ + dy_ < 0)                                                 \
+                continue;                                                               \
+            for (int dx_ = -1; dx_ <= 1; dx_++) {                                       \
+                if (!dx_ && !dy_)                                                       \
+                    continue;                                                           \
+                int64_t nb = clusterFindCell((job),                                     \
+                    clusterKey(clusterWrapX((job), (int64_t)cx_ + dx_), cy_ + (uint32_t)dy_)); \
+                if (nb >= 0) { body }                                                   \
+            }                                                                           \
+        }                                                                               \
+    } while (0)
+
+static void clusterLink(ClusterJob *job, unsigned t) {
+    size_t lo, hi;
+    clusterRange(job->ncells, job->threads, t, &lo, &hi);
+    for (size_t c = lo; c < hi; c++) {
+        if (!clusterDense(job, c))
+            continue;
+        CLUSTER_FOR_NEIGHBOURS(job, c, nb,
+            if ((size_t)nb > c && clusterDense(job, (size_t)nb))
+                clusterUnion(job->parent, (uint32_t)c, (uint32_t)nb);
+        );
+    }
+}
+
+
+/* --- 4) Point labels ------------------------------------------------------ */
+
+static void clusterLabel(ClusterJob *job, unsigned t) {
+    size_t lo, hi;
+    clusterRange(job->ncells, job->threads, t, &lo, &hi);
+    for (size_t c = lo; c < hi; c++) {
+        int32_t id = job->cellId[c];
+
+        // Sparse cell: border of the first dense neighbour, else noise
+        if (id < 0) {
+            CLUSTER_FOR_NEIGHBOURS(job, c, nb,
+                if (id < 0 && job->cellId[nb] >= 0)
+                    id = job->cellId[nb];
+            );
+        }
+        for (size_t i = job->cellStart[c]; i < job->cellStart[c + 1]; i++)
+            job->label[job->items[i].idx] = id;
+    }
+}
+
+
+int clusterStops(const int32_t *lat_e7, const int32_t *lon_e7, size_t n, int32_t cell_e7,
+                 uint32_t minPts, unsigned threads, int32_t *label, size_t *clusters) {
+    *clusters = 0;
+    if (!n)
+        return 1;
+    if (cell_e7 <= 0)
+        return 0;
+    if (!threads)
+        threads = 1;
+    if (threads > n)
+        threads = (unsigned)n;
+
+    ClusterJob job = { .lat = lat_e7, .lon = lon_e7, .n = n, .cell = cell_e7,
+                       .ncx = (int32_t)((CLUSTER_LON_SPAN + cell_e7 - 1) / cell_e7),
+                       .minPts = minPts ? minPts : 1, .threads = threads, .label = label };
+    job.items = malloc(sizeof(ClusterItem) * n);
+    job.tmp   = malloc(sizeof(ClusterItem) * n);
+    job.diff  = malloc(sizeof(uint64_t) * 2 * threads);
+    job.hist  = malloc(sizeof(*job.hist) * threads);
+    int ok = job.items && job.tmp && job.diff && job.hist;
+
+    // 1) Cell key per point, and which key bits differ at all
+    ok = ok && clusterParallel(&job, clusterKeys);
+    uint64_t diff = 0;
+    for (unsigned t = 0; ok && t < threads; t++)
+        diff |= job.diff[t] | (job.diff[threads + t] ^ job.diff[threads]);
+
+    // 2) Group points by cell
+    ok = ok && clusterSort(&job, diff);
+
+    // 3) Unique cells
+    if (ok) {
+        size_t cells = 1;
+        for (size_t i = 1; i < n; i++)
+            cells += job.items[i].key != job.items[i - 1].key;
+        job.cellKey   = malloc(sizeof(uint64_t) * cells);
+        job.cellStart = malloc(sizeof(size_t) * (cells + 1));
+        job.parent    = malloc(sizeof(*job.parent) * cells);
+        job.cellId    = malloc(sizeof(int32_t) * cells);
+        ok = job.cellKey && job.cellStart && job.parent && job.cellId;
+    }
+    if (ok) {
+        for (size_t i = 0; i < n; i++) {
+            if (i == 0 || job.items[i].key != job.items[i - 1].key) {
+                job.cellKey[job.ncells]   = job.items[i].key;
+                job.cellStart[job.ncells] = i;
+                atomic_init(&job.parent[job.ncells], (uint32_t)job.ncells);
+                job.ncells++;
+            }
+        }
+        job.cellStart[job.ncells] = n;
+    }
+
+    // 4) Join dense neighbours, then number the clusters in cell order
+    ok = ok && clusterParallel(&job, clusterLink);
+    if (ok) {
+        int32_t next = 0;
+        for (size_t c = 0; c < job.ncells; c++) {
+            job.cellId[c] = -1;
+            if (!clusterDense(&job, c))
+                continue;
+            uint32_t root = clusterFind(job.parent, (uint32_t)c);
+            if (root == c)
+                job.cellId[c] = next++;
+            else
+                job.cellId[c] = job.cellId[root];   // root < c, numbered already
+        }
+        *clusters = (size_t)next;
+    }
+
+    // 5) Labels
+    ok = ok && clusterParallel(&job, clusterLabel);
+
+    free(job.items);
+    free(job.tmp);
+    free(job.diff);
+    free(job.hist);
+    free(job.cellKey);
+    free(job.cellStart);
+    free((void *)job.parent);
+    free(job.cellId);
+    return ok;
+}
+
+
+void clusterSummary(const int32_t *lat_e7, const int32_t *lon_e7, const int32_t *label, size_t n,
+                    size_t clusters, BN220_ClusterInfo *info) {
+    int64_t *sum = calloc(clusters * 2, sizeof(int64_t));
+    memset(info, 0, sizeof(*info) * clusters);
+
+    // Offsets from the first point of each cluster keep the sums small and
+    // the centroid correct across the antimeridian
+    for (size_t i = 0; i < n; i++) {
+        if (label[i] < 0)
+            continue;
+        BN220_ClusterInfo *c = &info[label[i]];
+        if (!c->points) {
+            c->lat_e7 = lat_e7[i];
+            c->lon_e7 = lon_e7[i];
+        }
+        int64_t dlon = (int64_t)lon_e7[i] - c->lon_e7;
+        if (dlon >  CLUSTER_LON_SPAN / 2) dlon -= CLUSTER_LON_SPAN;
+        if (dlon < -CLUSTER_LON_SPAN / 2) dlon += CLUSTER_LON_SPAN;
+        if (sum) {
+            sum[2 * label[i]]     += (int64_t)lat_e7[i] - c->lat_e7;
+            sum[2 * label[i] + 1] += dlon;
+        }
+        c->points++;
+    }
+
+    for (size_t k = 0; sum && k < clusters; k++) {
+        if (!info[k].points)
+            continue;
+        int64_t lon = info[k].lon_e7 + sum[2 * k + 1] / info[k].points;
+        if (lon >=  CLUSTER_LON_SPAN / 2) lon -= CLUSTER_LON_SPAN;
+        if (lon <  -CLUSTER_LON_SPAN / 2) lon += CLUSTER_LON_SPAN;
+        info[k].lat_e7 += (int32_t)(sum[2 * k] / info[k].points);
+        info[k].lon_e7  = (int32_t)lon;
+    }
+    free(sum);
+}
@@ -0,0 +1,84 @@
+/*
+ * BN220_cluster.h — Stop-point clustering
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_cluster.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Grid approximation of DBSCAN over lat/lon columns: dense cells
+ *          joined with their dense neighbours.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_CLUSTER_H_
+#define INC_BN220_CLUSTER_H_
+
+#include "BN220.h"
+
+/*
+ * Grid-based clustering of stop points (host side).
+ *
+ * Points are bucketed into cell_e7 x cell_e7 cells (1e-7 degree units).  A
+ * cell holding at least minPts points is dense; dense cells touching each
+ * other (8-neighbourhood) form one cluster, and points of a sparse cell next
+ * to a dense one join that cluster as border points.  Everything else is
+ * noise.  This is the usual grid approximation of DBSCAN with eps about one
+ * cell: a parallel radix sort groups points by cell, then a lock-free
+ * union-find joins dense neighbours, so the cost is near-linear in n.
+ *
+ * Input is columnar, e.g. the stop centroids of BN220_segment.c or the
+ * lat_e7/lon_e7 columns of a decoded log.
+ */
+
+typedef struct {
+    int32_t  lat_e7;  // centroid
+    int32_t  lon_e7;
+    uint32_t points;
+} BN220_ClusterInfo;
+
+/**
+ * @brief  Cluster n points.
+ *
+ * @param[in]  lat_e7, lon_e7  Point columns.
+ * @param[in]  n               Number of points (below 2^32).
+ * @param[in]  cell_e7         Cell size in 1e-7 degrees (e.g. 5000 = 0.0005°,
+ *                             about 55 m north-south).
+ * @param[in]  minPts          Points that make a cell dense.
+ * @param[in]  threads         Worker threads (1 runs inline).
+ * @param[out] label           Per point: cluster 0..clusters-1, or -1 for noise.
+ * @param[out] clusters        Number of clusters.
+ *
+ * Returns 0 when out of memory or a thread cannot be started.
+ */
+int clusterStops(const int32_t *lat_e7, const int32_t *lon_e7, size_t n, int32_t cell_e7,
+                 uint32_t minPts, unsigned threads, int32_t *label, size_t *clusters);
+
+/**
+ * @brief  Centroid and size of every cluster from the labels of clusterStops.
+ *
+ * @param[out] info  clusters entries.
+ */
+void clusterSummary(const int32_t *lat_e7, const int32_t *lon_e7, const int32_t *label, size_t n,
+                    size_t clusters, BN220_ClusterInfo *info);
+
+#endif /* INC_BN220_CLUSTER_H_ */
@@ -0,0 +1,116 @@
+/*
+ * BN220_config.h — Build-time feature configuration for the BN-220 driver
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_config.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Selects sentence decoders, numeric backend, instrumentation and
+ *          I/O adapters at compile time so unused code and its libc
+ *          dependencies stay out of flash.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_CONFIG_H_
+#define INC_BN220_CONFIG_H_
+
+/*
+ * Every option below can be overridden from the compiler command line
+ * (-DBN220_ENABLE_GSV=0) or from a project file named by BN220_CONFIG_FILE
+ * (-DBN220_CONFIG_FILE='"my_bn220_config.h"').  Disabled features compile to
+ * nothing, so the linker never pulls their libc dependencies in.
+ */
+#ifdef BN220_CONFIG_FILE
+#include BN220_CONFIG_FILE
+#endif
+
+/* --- Sentence decoders ---------------------------------------------------- */
+#ifndef BN220_ENABLE_GGA
+#define BN220_ENABLE_GGA 1 // fix, position, altitude, hdop, satellites, time
+#endif
+
+#ifndef BN220_ENABLE_GLL
+#define BN220_ENABLE_GLL 1 // position and time
+#endif
+
+#ifndef BN220_ENABLE_GSA
+#define BN220_ENABLE_GSA 1 // fix mode and satellites used
+#endif
+
+#ifndef BN220_ENABLE_GSV
+#define BN220_ENABLE_GSV 1 // satellites in view
+#endif
+
+#ifndef BN220_SAT_MAX
+#define BN220_SAT_MAX 24 // GSV table entries kept in BN220_GPS (GPS + GLONASS in view)
+#endif
+
+#ifndef BN220_ENABLE_RMC
+#define BN220_ENABLE_RMC 1 // ground speed and date
+#endif
+
+/* --- Numeric backend ------------------------------------------------------ */
+/*
+ * 1: decimal fields go through libc strtof().
+ * 0: use the built-in fixed-format decimal reader, which handles the plain
+ *    "[-]ddd.ddd" numbers found in NMEA and avoids newlib's float parser.
+ */
+#ifndef BN220_NUMERIC_LIBC
+#define BN220_NUMERIC_LIBC 1
+#endif
+
+/* --- Framing kernel ------------------------------------------------------ */
+/*
+ * 1: gpsFeed and getChecksum scan four bytes per step (SWAR has-zero-byte
+ *    tests for '$', '*', CR and LF, word-wide XOR for the checksum).  Meant
+ *    for cores without SIMD units such as Cortex-M33; needs unaligned 32-bit
+ *    loads, which every ARMv7-M/ARMv8-M core provides.
+ * 0: one byte per step.
+ */
+#ifndef BN220_USE_SWAR
+#define BN220_USE_SWAR 0
+#endif
+
+/* --- Instrumentation ------------------------------------------------------ */
+#ifndef BN220_ENABLE_STATS
+#define BN220_ENABLE_STATS 0 // sentence / error counters in BN220_Context
+#endif
+
+/* --- I/O adapters --------------------------------------------------------- */
+#ifndef BN220_PLATFORM_HAL
+#define BN220_PLATFORM_HAL 1 // 1: STM32 HAL headers, 0: plain C (host builds)
+#endif
+
+#ifndef BN220_ENABLE_LEGACY_PARSE
+#define BN220_ENABLE_LEGACY_PARSE 1 // gpsParse() on whole buffers (strtok/malloc)
+#endif
+
+#ifndef BN220_ENABLE_UBX
+#define BN220_ENABLE_UBX 1 // UBX output: aiding, rate controller
+#endif
+
+#ifndef BN220_EXPORT_GZIP
+#define BN220_EXPORT_GZIP 0 // gzip output in BN220_export.c (host, links zlib)
+#endif
+
+#endif /* INC_BN220_CONFIG_H_ */
@@ -0,0 +1,434 @@
+/*
+ * BN220_ctxcache.c — Bounded parser context cache
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_ctxcache.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Slot index, CLOCK eviction and the built-in spill stores.
+ * ---------------------------------------------------------------------------
+ */
+
+#define _FILE_OFFSET_BITS 64
+#define _POSIX_C_SOURCE  200809L   // fseeko/ftello
+
+#include "BN220_ctxcache.h"
+#include <stdio.h>
+
+#define CACHE_EMPTY_KEY  0   // map keys are device id + 1
+
+/*
+ * uint64 -> uint64 open-addressing map with linear probing and
+ * backward-shift deletion; shared by the slot index and the spill stores.
+ */
+typedef struct {
+    uint64_t *keys;
+    uint64_t *vals;
+    uint32_t  mask;
+    uint32_t  count;
+} CacheMap;
+
+static uint32_t cacheHash(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33;
+    return (uint32_t)x;
+}
+
+static int cacheMapInit(CacheMap *m, uint32_t capacity) {
+    uint32_t n = 16;
+    while (n < capacity * 2)
+        n <<= 1;
+    m->keys  = calloc(n, sizeof(uint64_t));
+    m->vals  = calloc(n, sizeof(uint64_t));
+    m->mask  = n - 1;
+    m->count = 0;
+    if (!m->keys || !m->vals) {
+        free(m->keys);
+        free(m->vals);
+        m->keys = m->vals = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+static void cacheMapFree(CacheMap *m) {
+    free(m->keys);
+    free(m->vals);
+    m->keys = m->vals = NULL;
+}
+
+static uint64_t *cacheMapFind(const CacheMap *m, uint64_t device) {
+    uint64_t key = device + 1;
+    for (uint32_t i = cacheHash(key) & m->mask;; i = (i + 1) & m->mask) {
+        if (m->keys[i] == key)
+            return &m->vals[i];
+        if (m->keys[i] == CACHE_EMPTY_KEY)
+            return NULL;
+    }
+}
+
+static int cacheMapPut(CacheMap *m, uint64_t device, uint64_t val);
+
+static int cacheMapGrow(CacheMap *m) {
+    CacheMap old = *m;
+    if (!cacheMapInit(m, (old.mask + 1)))
+        return *m = old, 0;
+    for (uint32_t i = 0; i <= old.mask; i++) {
+        if (old.keys[i] != CACHE_EMPTY_KEY)
+            cacheMapPut(m, old.keys[i] - 1, old.vals[i]);
+    }
+    cacheMapFree(&old);
+    return 1;
+}
+
+static int cacheMapPut(CacheMap *m, uint64_t device, uint64_t val) {
+    if ((m->count + 1) * 10 > (m->mask + 1) * 7 && !cacheMapGrow(m))
+        return 0;
+
+    uint64_t key = device + 1;
+    for (uint32_t i = cacheHash(key) & m->mask;; i = (i + 1) & m->mask) {
+        if (m->keys[i] == key) {
+            m->vals[i] = val;
+            return 1;
+        }
+        if (m->keys[i] == CACHE_EMPTY_KEY) {
+            m->keys[i] = key;
+            m->vals[i] = val;
+            m->count++;
+            return 1;
+        }
+    }
+}
+
+static void cacheMapErase(CacheMap *m, uint64_t device) {
+    uint64_t key = device + 1;
+    uint32_t i = cacheHash(key) & m->mask;
+
+    while (m->keys[i] != key) {
+        if (m->keys[i] == CACHE_EMPTY_KEY)
+            return;
+        i = (i + 1) & m->mask;
+    }
+
+    // Shift later members of the probe run back so lookups still find them
+    for (uint32_t j = (i + 1) & m->mask; m->keys[j] != CACHE_EMPTY_KEY; j = (j + 1) & m->mask) {
+        uint32_t home = cacheHash(m->keys[j]) & m->mask;
+        if (((j - home) & m->mask) >= ((j - i) & m->mask)) {
+            m->keys[i] = m->keys[j];
+            m->vals[i] = m->vals[j];
+            i = j;
+        }
+    }
+    m->keys[i] = CACHE_EMPTY_KEY;
+    m->count--;
+}
+
+
+typedef struct {
+    uint64_t      device;
+    uint8_t       used;  // slot holds a context
+    uint8_t       ref;   // CLOCK reference bit
+    BN220_Context ctx;
+} CacheSlot;
+
+struct BN220_CtxCache {
+    CacheSlot       *slots;
+    uint32_t         nslots;
+    uint32_t         hand;    // CLOCK hand
+    uint32_t         filled;  // slots handed out so far
+    CacheMap         index;   // device -> slot
+    BN220_SpillStore store;
+    BN220_CtxLoadFn  onLoad;
+    void            *user;
+    uint64_t         hits, restores, evictions;
+};
+
+
+BN220_CtxCache *ctxCacheCreate(uint32_t resident, const BN220_SpillStore *store,
+                               BN220_CtxLoadFn onLoad, void *user) {
+    BN220_CtxCache *c = calloc(1, sizeof(*c));
+    if (!c)
+        return NULL;
+
+    c->nslots = resident ? resident : 1;
+    c->slots  = calloc(c->nslots, sizeof(CacheSlot));
+    c->store  = *store;
+    c->onLoad = onLoad;
+    c->user   = user;
+    if (!c->slots || !cacheMapInit(&c->index, c->nslots)) {
+        ctxCacheDestroy(c);
+        return NULL;
+    }
+    return c;
+}
+
+void ctxCacheDestroy(BN220_CtxCache *cache) {
+    if (!cache)
+        return;
+    cacheMapFree(&cache->index);
+    free(cache->slots);
+    free(cache);
+}
+
+
+static int cacheSpill(BN220_CtxCache *c, CacheSlot *s) {
+    uint8_t blob[BN220_CHECKPOINT_MAX];
+    size_t  len = gpsCheckpoint(&s->ctx, blob, sizeof(blob));
+    return len && c->store.put(c->store.user, s->device, blob, len);
+}
+
+
+// Slot for a new resident: a never-used one, else the CLOCK victim
+static CacheSlot *cacheVictim(BN220_CtxCache *c) {
+    if (c->filled < c->nslots)
+        return &c->slots[c->filled++];
+
+    for (;;) {
+        CacheSlot *s = &c->slots[c->hand];
+        c->hand = (c->hand + 1) % c->nslots;
+        if (s->ref) {
+            s->ref = 0;     // second chance
+            continue;
+        }
+        // A slot left unused by a failed acquire has no index entry; its
+        // stale device may be resident elsewhere by now
+        if (s->used) {
+            if (!cacheSpill(c, s))
+                return NULL;
+            cacheMapErase(&c->index, s->device);
+            s->used = 0;
+            c->evictions++;
+        }
+        return s;
+    }
+}
+
+
+BN220_Context *ctxCacheAcquire(BN220_CtxCache *cache, uint64_t device) {
+    // 1) Resident already
+    uint64_t *slot = cacheMapFind(&cache->index, device);
+    if (slot) {
+        CacheSlot *s = &cache->slots[*slot];
+        s->ref = 1;
+        cache->hits++;
+        return &s->ctx;
+    }
+
+    // 2) Make room
+    CacheSlot *s = cacheVictim(cache);
+    if (!s)
+        return NULL;
+    if (!cacheMapPut(&cache->index, device, (uint64_t)(s - cache->slots))) {
+        s->device = 0;   // stays unused, the next victim pass hands it out again
+        return NULL;
+    }
+
+    // 3) Rehydrate from the spill store, or start fresh
+    uint8_t blob[BN220_CHECKPOINT_MAX];
+    size_t  len = cache->store.get(cache->store.user, device, blob, sizeof(blob));
+    int restored = 0;
+
+    gpsInit(&s->ctx);
+    if (len && gpsRestore(&s->ctx, blob, len)) {
+        restored = 1;
+        cache->restores++;
+    }
+    s->device = device;
+    s->used   = 1;
+    s->ref    = 1;
+    if (cache->onLoad)
+        cache->onLoad(cache->user, device, &s->ctx, restored);
+    return &s->ctx;
+}
+
+
+uint32_t ctxCacheFlush(BN220_CtxCache *cache) {
+    uint32_t failed = 0;
+    for (uint32_t i = 0; i < cache->filled; i++) {
+        if (cache->slots[i].used && !cacheSpill(cache, &cache->slots[i]))
+            failed++;
+    }
+    return failed;
+}
+
+
+void ctxCacheStats(const BN220_CtxCache *cache, uint64_t *hits, uint64_t *restores,
+                   uint64_t *evictions) {
+    if (hits)      *hits = cache->hits;
+    if (restores)  *restores = cache->restores;
+    if (evictions) *evictions = cache->evictions;
+}
+
+
+/* --- In-memory spill store: device -> malloc'd [len(2) | blob] ----------- */
+
+static int spillMemPut(void *user, uint64_t device, const uint8_t *blob, size_t len) {
+    CacheMap *m = user;
+    uint8_t  *copy = malloc(len + 2);
+    if (!copy)
+        return 0;
+    copy[0] = (uint8_t)len;
+    copy[1] = (uint8_t)(len >> 8);
+    memcpy(copy + 2, blob, len);
+
+    uint64_t *old = cacheMapFind(m, device);
+    if (old) {
+        free((void *)(uintptr_t)*old);
+        *old = (uint64_t)(uintptr_t)copy;
+        return 1;
+    }
+    if (!cacheMapPut(m, device, (uint64_t)(uintptr_t)copy)) {
+        free(copy);
+        return 0;
+    }
+    return 1;
+}
+
+static size_t spillMemGet(void *user, uint64_t device, uint8_t *blob, size_t cap) {
+    uint64_t *v = cacheMapFind(user, device);
+    if (!v)
+        return 0;
+    const uint8_t *p = (const uint8_t *)(uintptr_t)*v;
+    size_t len = (size_t)(p[0] | (p[1] << 8));
+    if (len > cap)
+        return 0;
+    memcpy(blob, p + 2, len);
+    return len;
+}
+
+int spillMemOpen(BN220_SpillStore *store) {
+    CacheMap *m = malloc(sizeof(*m));
+    if (!m || !cacheMapInit(m, 1024)) {
+        free(m);
+        return 0;
+    }
+    store->put  = spillMemPut;
+    store->get  = spillMemGet;
+    store->user = m;
+    return 1;
+}
+
+void spillMemClose(BN220_SpillStore *store) {
+    CacheMap *m = store->user;
+    if (!m)
+        return;
+    for (uint32_t i = 0; i <= m->mask; i++) {
+        if (m->keys[i] != CACHE_EMPTY_KEY)
+            free((void *)(uintptr_t)m->vals[i]);
+    }
+    cacheMapFree(m);
+    free(m);
+    store->user = NULL;
+}
+
+
+/* --- File spill store: one extent per device, rewritten in place -------- */
+
+#define SPILL_UNIT 256   // extent granule; a checkpoint blob takes two
+
+/*
+ * Index value: offset / SPILL_UNIT << 24 | (units - 1) << 16 | len.  An
+ * extent keeps its capacity when a shorter blob is written into it, so a
+ * device's checkpoints, whose length only varies with the partial line,
+ * keep landing in the same place and the file stays at one extent per
+ * device.
+ */
+#define SPILL_OFFSET(v) (((v) >> 24) * SPILL_UNIT)
+#define SPILL_UNITS(v)  ((((v) >> 16) & 0xFF) + 1)
+#define SPILL_LEN(v)    ((size_t)((v) & 0xFFFF))
+
+typedef struct {
+    FILE    *fp;
+    uint64_t end;
+    CacheMap index;
+} SpillFile;
+
+static int spillFilePut(void *user, uint64_t device, const uint8_t *blob, size_t len) {
+    SpillFile *f = user;
+    uint64_t  *v = cacheMapFind(&f->index, device);
+    uint64_t   units = len ? (len + SPILL_UNIT - 1) / SPILL_UNIT : 1;
+    uint64_t   off = f->end;
+
+    if (len > 0xFFFF)
+        return 0;
+
+    // 1) Same extent if the blob fits, else a new one at the end; the old
+    //    one is then abandoned until the store is reopened
+    if (v && SPILL_UNITS(*v) >= units) {
+        units = SPILL_UNITS(*v);
+        off   = SPILL_OFFSET(*v);
+    }
+    if (fseeko(f->fp, (off_t)off, SEEK_SET) != 0 || fwrite(blob, 1, len, f->fp) != len)
+        return 0;
+
+    // 2) Index it
+    uint64_t val = (off / SPILL_UNIT) << 24 | (units - 1) << 16 | len;
+    if (v)
+        *v = val;
+    else if (!cacheMapPut(&f->index, device, val))
+        return 0;
+    if (off == f->end)
+        f->end += units * SPILL_UNIT;
+    return 1;
+}
+
+static size_t spillFileGet(void *user, uint64_t device, uint8_t *blob, size_t cap) {
+    SpillFile *f = user;
+    uint64_t  *v = cacheMapFind(&f->index, device);
+    if (!v)
+        return 0;
+    size_t len = SPILL_LEN(*v);
+    if (len > cap || fflush(f->fp) != 0 || fseeko(f->fp, (off_t)SPILL_OFFSET(*v), SEEK_SET) != 0 ||
+        fread(blob, 1, len, f->fp) != len)
+        return 0;
+    return len;
+}
+
+int spillFileOpen(BN220_SpillStore *store, const char *path) {
+    SpillFile *f = calloc(1, sizeof(*f));
+    if (!f)
+        return 0;
+    f->fp = fopen(path, "w+b");
+    if (!f->fp || !cacheMapInit(&f->index, 1024)) {
+        if (f->fp)
+            fclose(f->fp);
+        cacheMapFree(&f->index);
+        free(f);
+        return 0;
+    }
+    store->put  = spillFilePut;
+    store->get  = spillFileGet;
+    store->user = f;
+    return 1;
+}
+
+void spillFileClose(BN220_SpillStore *store) {
+    SpillFile *f = store->user;
+    if (!f)
+        return;
+    fclose(f->fp);
+    cacheMapFree(&f->index);
+    free(f);
+    store->user = NULL;
+}
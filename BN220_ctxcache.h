@@ -0,0 +1,121 @@
+/*
+ * BN220_ctxcache.h — Bounded parser context cache
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_ctxcache.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   CLOCK-managed set of resident BN220_Context with checkpoint spill
+ *          to memory or file.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_CTXCACHE_H_
+#define INC_BN220_CTXCACHE_H_
+
+#include "BN220.h"
+
+/*
+ * Memory-bounded set of per-device parser contexts (host side).
+ *
+ * Only a fixed number of BN220_Context are resident.  When a packet arrives
+ * for a device that is not resident, the CLOCK hand evicts a context that
+ * has not been used since its last sweep: it is frozen with gpsCheckpoint()
+ * into a spill store, and the slot is reused for the incoming device, which
+ * is rehydrated with gpsRestore() (or started fresh).  Memory use then
+ * follows the number of active devices, not registered ones.
+ */
+typedef struct BN220_CtxCache BN220_CtxCache;
+
+/*
+ * Where evicted contexts go.  put() replaces any earlier blob of the same
+ * device; get() returns the blob length, or 0 when the device has none.
+ */
+typedef struct {
+    int    (*put)(void *user, uint64_t device, const uint8_t *blob, size_t len);
+    size_t (*get)(void *user, uint64_t device, uint8_t *blob, size_t cap);
+    void    *user;
+} BN220_SpillStore;
+
+/*
+ * Called whenever a context becomes resident (fresh or rehydrated) to set
+ * what the checkpoint does not carry: onEpoch/user, usually per device.
+ */
+typedef void (*BN220_CtxLoadFn)(void *user, uint64_t device, BN220_Context *ctx, int restored);
+
+/**
+ * @brief  Create a cache with @p resident context slots.
+ *
+ * @param[in] resident  Number of contexts kept in memory.
+ * @param[in] store     Spill store; copied.
+ * @param[in] onLoad    Optional hook run for each context made resident.
+ * @param[in] user      Passed to @p onLoad.
+ */
+BN220_CtxCache *ctxCacheCreate(uint32_t resident, const BN220_SpillStore *store,
+                               BN220_CtxLoadFn onLoad, void *user);
+
+/**
+ * @brief  Free the cache without spilling; call ctxCacheFlush first to keep state.
+ */
+void ctxCacheDestroy(BN220_CtxCache *cache);
+
+/**
+ * @brief  Resident context of @p device, loading or creating it if needed.
+ *
+ * The pointer stays valid until the next ctxCacheAcquire call, which may
+ * evict it.  Returns NULL only when eviction failed (spill store error).
+ */
+BN220_Context *ctxCacheAcquire(BN220_CtxCache *cache, uint64_t device);
+
+/**
+ * @brief  Spill every resident context, e.g. before shutdown.
+ *
+ * Returns the number of contexts that could not be written.
+ */
+uint32_t ctxCacheFlush(BN220_CtxCache *cache);
+
+/**
+ * @brief  Counters: hits, misses served from the spill store, and evictions.
+ */
+void ctxCacheStats(const BN220_CtxCache *cache, uint64_t *hits, uint64_t *restores,
+                   uint64_t *evictions);
+
+/**
+ * @brief  Spill store keeping blobs in process memory.
+ *
+ * Returns 0 when out of memory.  Free with spillMemClose().
+ */
+int  spillMemOpen(BN220_SpillStore *store);
+void spillMemClose(BN220_SpillStore *store);
+
+/**
+ * @brief  Spill store keeping blobs in a local file (truncated on open).
+ *
+ * Each device owns one extent, rounded up to 256 bytes, which later blobs
+ * overwrite in place while they fit; the file therefore grows with the
+ * number of devices, not with the number of evictions.  Returns 0 on error.
+ */
+int  spillFileOpen(BN220_SpillStore *store, const char *path);
+void spillFileClose(BN220_SpillStore *store);
+
+#endif /* INC_BN220_CTXCACHE_H_ */
@@ -0,0 +1,171 @@
+/*
+ * BN220_enu.c — Local ENU frame
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_enu.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   WGS-84 position to local East-North-Up and ECEF in float32
+ * ---------------------------------------------------------------------------
+ */
+
+#include "BN220_enu.h"
+#include <math.h>
+
+#define ENU_A       6378137.0        // WGS-84 semi-major axis (m)
+#define ENU_E2      6.69437999014e-3 // first eccentricity squared
+#define ENU_RAD_E7  1.7453292519943295e-9   // radians per 1e-7 degree
+
+void enuSetOrigin(BN220_EnuOrigin *o, int32_t lat_e7, int32_t lon_e7, int32_t alt_mm) {
+    double lat = lat_e7 * ENU_RAD_E7, lon = lon_e7 * ENU_RAD_E7, h = alt_mm * 1e-3;
+    double s = sin(lat), c = cos(lat);
+    double w = 1.0 - ENU_E2 * s * s;
+    double n = ENU_A / sqrt(w);
+
+    o->lat_e7     = lat_e7;
+    o->lon_e7     = lon_e7;
+    o->alt_mm     = alt_mm;
+    o->sinLat     = (float)s;
+    o->cosLat     = (float)c;
+    o->sinLon     = (float)sin(lon);
+    o->cosLon     = (float)cos(lon);
+    o->n0_m       = (float)n;
+    o->sqrtW0     = (float)sqrt(w);
+    o->ecef_mm[0] = llround((n + h) * c * cos(lon) * 1e3);
+    o->ecef_mm[1] = llround((n + h) * c * sin(lon) * 1e3);
+    o->ecef_mm[2] = llround((n * (1.0 - ENU_E2) + h) * s * 1e3);
+}
+
+
+// sin(x) and 1 - cos(x) for small x (|x| < 0.2 rad: below float resolution)
+static inline float enuSin(float x) {
+    float x2 = x * x;
+    return x * (1.0f - x2 / 6.0f * (1.0f - x2 / 20.0f * (1.0f - x2 / 42.0f)));
+}
+
+static inline float enuVers(float x) {
+    float x2 = x * x;
+    return x2 * 0.5f * (1.0f - x2 / 12.0f * (1.0f - x2 / 30.0f));
+}
+
+// Any angle in ±π: halve into the polynomial range, then double back with
+// sin 2x = 2 sin x (1 - vers x) and vers 2x = 2 sin² x.  Only longitude
+// differences near the poles ever take the loop.
+static inline void enuSinVers(float x, float *sinX, float *versX) {
+    int k = 0;
+    for (; x > 0.2f || x < -0.2f; k++)
+        x *= 0.5f;
+    float sn = enuSin(x), vs = enuVers(x);
+    for (; k > 0; k--) {
+        float s2 = 2.0f * sn * (1.0f - vs);
+        vs = 2.0f * sn * sn;
+        sn = s2;
+    }
+    *sinX  = sn;
+    *versX = vs;
+}
+
+static inline int32_t enuRound(float m) {
+    float mm = m * 1000.0f;
+    return (int32_t)(mm >= 0.0f ? mm + 0.5f : mm - 0.5f);
+}
+
+/*
+ * With A = N + h, s/c = sin/cos of the fix latitude and dφ, dλ the angle
+ * differences to the origin (0 subscript):
+ *   e = A c sin dλ
+ *   n = A (sin dφ + s0 c vers dλ) - e² c0 (dN s + N0 ds)
+ *   u = dA - A (vers dφ + c c0 vers dλ) - e² s0 (dN s + N0 ds)
+ * where ds, dN and dA are the small differences s - s0, N - N0, A - A0.
+ */
+static inline void enuCore(const BN220_EnuOrigin *o, int32_t lat_e7, int32_t lon_e7, int32_t alt_mm,
+                           float out[3]) {
+    // 1) Angle differences; longitude wrapped to ±180°
+    int64_t dLonE7 = (int64_t)lon_e7 - o->lon_e7;
+    if (dLonE7 > 1800000000)
+        dLonE7 -= 3600000000LL;
+    else if (dLonE7 < -1800000000)
+        dLonE7 += 3600000000LL;
+    float dPhi = (float)((int64_t)lat_e7 - o->lat_e7) * (float)ENU_RAD_E7;
+    float dLam = (float)dLonE7 * (float)ENU_RAD_E7;
+
+    float sinDPhi = enuSin(dPhi), versDPhi = enuVers(dPhi);
+    float sinDLam, versDLam;
+    enuSinVers(dLam, &sinDLam, &versDLam);
+
+    // 2) Fix latitude terms as origin terms plus small differences
+    float s0 = o->sinLat, c0 = o->cosLat;
+    float ds = c0 * sinDPhi - s0 * versDPhi;
+    float s  = s0 + ds;
+    float c  = c0 - c0 * versDPhi - s0 * sinDPhi;
+
+    // 3) Radius differences: dN from w0 - w = e² ds (s + s0)
+    float sqrtW = sqrtf(1.0f - (float)ENU_E2 * s * s);
+    float dN    = (float)ENU_A * ((float)ENU_E2 * ds * (s + s0)) /
+                  (sqrtW * o->sqrtW0 * (sqrtW + o->sqrtW0));
+    float dA    = dN + (float)((int64_t)alt_mm - o->alt_mm) * 1e-3f;
+    float A     = o->n0_m + (float)o->alt_mm * 1e-3f + dA;
+    float eTerm = (float)ENU_E2 * (dN * s + o->n0_m * ds);
+
+    out[0] = A * c * sinDLam;
+    out[1] = A * (sinDPhi + s0 * c * versDLam) - c0 * eTerm;
+    out[2] = dA - A * (versDPhi + c * c0 * versDLam) - s0 * eTerm;
+}
+
+void enuFromLla(const BN220_EnuOrigin *o, int32_t lat_e7, int32_t lon_e7, int32_t alt_mm,
+                int32_t enu[3]) {
+    float m[3];
+    enuCore(o, lat_e7, lon_e7, alt_mm, m);
+    enu[0] = enuRound(m[0]);
+    enu[1] = enuRound(m[1]);
+    enu[2] = enuRound(m[2]);
+}
+
+void enuLlaToEcef(const BN220_EnuOrigin *o, int32_t lat_e7, int32_t lon_e7, int32_t alt_mm,
+                  int64_t ecef[3]) {
+    float m[3];
+    enuCore(o, lat_e7, lon_e7, alt_mm, m);
+
+    // ENU -> ECEF rotation (transpose of the origin's ECEF -> ENU matrix)
+    float sl = o->sinLat, cl = o->cosLat, so = o->sinLon, co = o->cosLon;
+    float t  = cl * m[2] - sl * m[1];   // component along the origin meridian plane
+    ecef[0]  = o->ecef_mm[0] + enuRound(co * t - so * m[0]);
+    ecef[1]  = o->ecef_mm[1] + enuRound(so * t + co * m[0]);
+    ecef[2]  = o->ecef_mm[2] + enuRound(cl * m[1] + sl * m[2]);
+}
+
+void enuBatch(const BN220_EnuOrigin *o, const int32_t *lat_e7, const int32_t *lon_e7,
+              const int32_t *alt_mm, size_t n, int32_t *east, int32_t *north, int32_t *up) {
+    for (size_t i = 0; i < n; i++) {
+        float m[3];
+        enuCore(o, lat_e7[i], lon_e7[i], alt_mm[i], m);
+        east[i]  = enuRound(m[0]);
+        north[i] = enuRound(m[1]);
+        up[i]    = enuRound(m[2]);
+    }
+}
+
+void enuBatchFix(const BN220_EnuOrigin *o, const BN220_Fix *fix, size_t n, int32_t (*enu)[3]) {
+    for (size_t i = 0; i < n; i++)
+        enuFromLla(o, fix[i].lat_e7, fix[i].lon_e7, fix[i].alt_mm, enu[i]);
+}
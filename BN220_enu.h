@@ -0,0 +1,91 @@
+/*
+ * BN220_enu.h — Local ENU frame
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_enu.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   WGS-84 position to local East-North-Up and ECEF in float32
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_ENU_H_
+#define INC_BN220_ENU_H_
+
+#include "BN220.h"
+
+/*
+ * WGS-84 geodetic (1e-7°, mm) to local East-North-Up millimetres around a
+ * fixed origin, and to ECEF.
+ *
+ * The origin's trigonometry and ECEF position are computed once, in
+ * double, by enuSetOrigin().  Per fix, everything runs in float32 without
+ * libm trig: the ENU coordinates are written in closed form in terms of
+ * the small angle differences to the origin (short polynomials for their
+ * sine and 1 - cosine) and the origin terms, so no large ECEF value is
+ * ever subtracted in single precision.  The error therefore scales with
+ * the distance to the origin: at most about 4e-7 of it (under 1 mm within
+ * 1 km, a few mm at 10 km, about 0.1 m at 300 km), and up to 8e-7 in polar
+ * frames spanning more than about 11° of longitude.  Intended for frames up
+ * to a few hundred kilometres across.
+ */
+typedef struct {
+    int32_t lat_e7, lon_e7, alt_mm;
+    int64_t ecef_mm[3];      // origin in ECEF (X, Y, Z)
+    float   sinLat, cosLat;  // rotation terms
+    float   sinLon, cosLon;
+    float   n0_m;            // prime vertical radius at the origin
+    float   sqrtW0;          // sqrt(1 - e^2 sin^2(lat))
+} BN220_EnuOrigin;
+
+/**
+ * @brief  Set the local frame origin (uses double trig once).
+ */
+void enuSetOrigin(BN220_EnuOrigin *o, int32_t lat_e7, int32_t lon_e7, int32_t alt_mm);
+
+/**
+ * @brief  ENU of one position, in mm.
+ *
+ * @param[out] enu  East, north, up.
+ */
+void enuFromLla(const BN220_EnuOrigin *o, int32_t lat_e7, int32_t lon_e7, int32_t alt_mm,
+                int32_t enu[3]);
+
+/**
+ * @brief  ECEF of one position, in mm (origin ECEF plus the rotated ENU).
+ */
+void enuLlaToEcef(const BN220_EnuOrigin *o, int32_t lat_e7, int32_t lon_e7, int32_t alt_mm,
+                  int64_t ecef[3]);
+
+/**
+ * @brief  ENU of n positions given as arrays (host-side columns).
+ */
+void enuBatch(const BN220_EnuOrigin *o, const int32_t *lat_e7, const int32_t *lon_e7,
+              const int32_t *alt_mm, size_t n, int32_t *east, int32_t *north, int32_t *up);
+
+/**
+ * @brief  ENU of n fixes, written as enu[i][0..2].
+ */
+void enuBatchFix(const BN220_EnuOrigin *o, const BN220_Fix *fix, size_t n, int32_t (*enu)[3]);
+
+#endif /* INC_BN220_ENU_H_ */
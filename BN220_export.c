@@ -0,0 +1,339 @@
+/*
+ * BN220_export.c — Track export
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_export.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Document structure, escaping and buffered (optionally deflated)
+ *          output for the GPX/KML/GeoJSON exporters.
+ * ---------------------------------------------------------------------------
+ */
+
+#include "BN220_export.h"
+#include "BN220_fmt.h"
+#include <stdio.h>
+#if BN220_EXPORT_GZIP
+#include <zlib.h>
+#endif
+
+#define EXPORT_RECORD_MAX 256   // longest rendered point, any format
+
+struct BN220_Exporter {
+    BN220_ExportWriteFn write;
+    void               *user;
+    uint8_t             format;
+    uint8_t             inSegment;
+    int                 ok;
+    uint32_t            segments;    // segments opened so far
+    uint64_t            segPoints;
+    int64_t             segStart, segEnd;
+    size_t              len;         // bytes held in text[]
+#if BN220_EXPORT_GZIP
+    int                 gzip;
+    z_stream            zs;
+    uint8_t             zbuf[BN220_EXPORT_BUF];
+#endif
+    char                text[BN220_EXPORT_BUF];
+};
+
+
+/* --- Output buffer -------------------------------------------------------- */
+
+static int exportDrain(BN220_Exporter *ex, int finish) {
+#if BN220_EXPORT_GZIP
+    if (ex->gzip) {
+        ex->zs.next_in  = (Bytef *)ex->text;
+        ex->zs.avail_in = (uInt)ex->len;
+        int rc;
+        do {
+            ex->zs.next_out  = ex->zbuf;
+            ex->zs.avail_out = sizeof(ex->zbuf);
+            rc = deflate(&ex->zs, finish ? Z_FINISH : Z_NO_FLUSH);
+            size_t out = sizeof(ex->zbuf) - ex->zs.avail_out;
+            if (rc == Z_STREAM_ERROR || (out && !ex->write(ex->user, ex->zbuf, out))) {
+                ex->len = 0;
+                return ex->ok = 0;
+            }
+        } while (ex->zs.avail_out == 0 || (finish && rc != Z_STREAM_END));
+        ex->len = 0;
+        return 1;
+    }
+#else
+    (void)finish;
+#endif
+    // A failed write drops the text; ok stays 0 from then on
+    int wrote = !ex->len || ex->write(ex->user, ex->text, ex->len);
+    ex->len   = 0;
+    if (!wrote)
+        ex->ok = 0;
+    return wrote;
+}
+
+// Cursor with room for at least @p need bytes
+static char *exportReserve(BN220_Exporter *ex, size_t need) {
+    if (ex->len + need > sizeof(ex->text))
+        exportDrain(ex, 0);
+    return ex->text + ex->len;
+}
+
+static void exportCommit(BN220_Exporter *ex, char *end) {
+    ex->len = (size_t)(end - ex->text);
+}
+
+static void exportPuts(BN220_Exporter *ex, const char *s) {
+    size_t n = strlen(s);
+    char  *p = exportReserve(ex, n);
+    memcpy(p, s, n);
+    exportCommit(ex, p + n);
+}
+
+// Name text, escaped for XML or JSON
+static void exportName(BN220_Exporter *ex, const char *s) {
+    for (; *s; s++) {
+        char         *p = exportReserve(ex, 8);
+        unsigned char c = (unsigned char)*s;
+        if (ex->format == BN220_EXPORT_GEOJSON) {
+            if (c == '"' || c == '\\') {
+                *p++ = '\\';
+                *p++ = (char)c;
+            } else if (c < 0x20) {
+                FMT_LIT(p, "\\u00");
+                *p++ = "0123456789abcdef"[c >> 4];
+                *p++ = "0123456789abcdef"[c & 15];
+            } else {
+                *p++ = (char)c;
+            }
+        } else if (c == '&') {
+            FMT_LIT(p, "&amp;");
+        } else if (c == '<') {
+            FMT_LIT(p, "&lt;");
+        } else if (c == '>') {
+            FMT_LIT(p, "&gt;");
+        } else if (c == '"') {
+            FMT_LIT(p, "&quot;");
+        } else if (c >= 0x20 || c == '\t' || c == '\n') {
+            *p++ = (char)c;
+        }
+        exportCommit(ex, p);
+    }
+}
+
+
+/* --- Document structure --------------------------------------------------- */
+
+static void exportSegmentOpen(BN220_Exporter *ex, const BN220_Fix *first) {
+    switch (ex->format) {
+    case BN220_EXPORT_GPX:
+        exportPuts(ex, "<trkseg>\n");
+        break;
+    case BN220_EXPORT_KML:
+        exportPuts(ex, "<Placemark><LineString><altitudeMode>absolute</altitudeMode><coordinates>\n");
+        break;
+    default:
+        exportPuts(ex, ex->segments ? ",\n" : "\n");
+        exportPuts(ex, "{\"type\":\"Feature\",\"geometry\":{\"type\":\"LineString\",\"coordinates\":[");
+        break;
+    }
+    ex->inSegment = 1;
+    ex->segments++;
+    ex->segPoints = 0;
+    ex->segStart  = first->utc_ms;
+}
+
+static void exportSegmentClose(BN220_Exporter *ex) {
+    char *p;
+    switch (ex->format) {
+    case BN220_EXPORT_GPX:
+        exportPuts(ex, "</trkseg>\n");
+        break;
+    case BN220_EXPORT_KML:
+        exportPuts(ex, "</coordinates></LineString></Placemark>\n");
+        break;
+    default:
+        p = exportReserve(ex, EXPORT_RECORD_MAX);
+        FMT_LIT(p, "]},\"properties\":{\"start\":\"");
+        p = fmtIso8601(p, ex->segStart);
+        FMT_LIT(p, "\",\"end\":\"");
+        p = fmtIso8601(p, ex->segEnd);
+        FMT_LIT(p, "\",\"points\":");
+        p = fmtU64(p, ex->segPoints);
+        FMT_LIT(p, "}}");
+        exportCommit(ex, p);
+        break;
+    }
+    ex->inSegment = 0;
+}
+
+// One point; the longest form (GPX) stays well under EXPORT_RECORD_MAX
+static void exportPoint(BN220_Exporter *ex, const BN220_Fix *f) {
+    char *p = exportReserve(ex, EXPORT_RECORD_MAX);
+    switch (ex->format) {
+    case BN220_EXPORT_GPX:
+        FMT_LIT(p, "<trkpt lat=\"");
+        p = fmtFixed(p, f->lat_e7, 7);
+        FMT_LIT(p, "\" lon=\"");
+        p = fmtFixed(p, f->lon_e7, 7);
+        FMT_LIT(p, "\"><ele>");
+        p = fmtFixed(p, f->alt_mm, 3);
+        FMT_LIT(p, "</ele><time>");
+        p = fmtIso8601(p, f->utc_ms);
+        FMT_LIT(p, "</time><sat>");
+        p = fmtU64(p, f->sats);
+        FMT_LIT(p, "</sat><hdop>");
+        p = fmtFixed(p, f->hdop_c, 2);
+        FMT_LIT(p, "</hdop></trkpt>\n");
+        break;
+    case BN220_EXPORT_KML:
+        p = fmtFixed(p, f->lon_e7, 7);
+        *p++ = ',';
+        p = fmtFixed(p, f->lat_e7, 7);
+        *p++ = ',';
+        p = fmtFixed(p, f->alt_mm, 3);
+        *p++ = '\n';
+        break;
+    default:
+        if (ex->segPoints)
+            *p++ = ',';
+        *p++ = '[';
+        p = fmtFixed(p, f->lon_e7, 7);
+        *p++ = ',';
+        p = fmtFixed(p, f->lat_e7, 7);
+        *p++ = ',';
+        p = fmtFixed(p, f->alt_mm, 3);
+        *p++ = ']';
+        break;
+    }
+    exportCommit(ex, p);
+    ex->segPoints++;
+    ex->segEnd = f->utc_ms;
+}
+
+
+/* --- Public API ----------------------------------------------------------- */
+
+BN220_Exporter *exportOpen(BN220_ExportFormat format, const char *name, int gzipLevel,
+                           BN220_ExportWriteFn write, void *user) {
+#if !BN220_EXPORT_GZIP
+    if (gzipLevel)
+        return NULL;
+#endif
+    if (format > BN220_EXPORT_GEOJSON || !write)
+        return NULL;
+    BN220_Exporter *ex = malloc(sizeof(*ex));
+    if (!ex)
+        return NULL;
+    memset(ex, 0, offsetof(BN220_Exporter, text));
+    ex->format = (uint8_t)format;
+    ex->write  = write;
+    ex->user   = user;
+    ex->ok     = 1;
+
+    // 1) Compressor: windowBits 15 + 16 selects the gzip wrapper
+#if BN220_EXPORT_GZIP
+    ex->gzip = gzipLevel > 0;
+    if (ex->gzip && deflateInit2(&ex->zs, gzipLevel, Z_DEFLATED, 15 + 16, 8,
+                                 Z_DEFAULT_STRATEGY) != Z_OK) {
+        free(ex);
+        return NULL;
+    }
+#endif
+
+    // 2) Document header
+    if (!name)
+        name = "track";
+    switch (ex->format) {
+    case BN220_EXPORT_GPX:
+        exportPuts(ex, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                       "<gpx version=\"1.1\" creator=\"BN220\" "
+                       "xmlns=\"http://www.topografix.com/GPX/1/1\">\n<trk><name>");
+        exportName(ex, name);
+        exportPuts(ex, "</name>\n");
+        break;
+    case BN220_EXPORT_KML:
+        exportPuts(ex, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                       "<kml xmlns=\"http://www.opengis.net/kml/2.2\">\n<Document><name>");
+        exportName(ex, name);
+        exportPuts(ex, "</name>\n");
+        break;
+    default:
+        exportPuts(ex, "{\"type\":\"FeatureCollection\",\"name\":\"");
+        exportName(ex, name);
+        exportPuts(ex, "\",\"features\":[");
+        break;
+    }
+    return ex;
+}
+
+int exportFixes(BN220_Exporter *ex, const BN220_Fix *fix, size_t n) {
+    for (size_t i = 0; ex->ok && i < n; i++) {
+        if (!fix[i].fix)
+            continue;
+        if (!ex->inSegment)
+            exportSegmentOpen(ex, &fix[i]);
+        exportPoint(ex, &fix[i]);
+    }
+    return ex->ok;
+}
+
+int exportBreak(BN220_Exporter *ex) {
+    if (ex->inSegment)
+        exportSegmentClose(ex);
+    return ex->ok;
+}
+
+void exportEpochSink(void *user, const BN220_Fix *fix) {
+    exportFixes((BN220_Exporter *)user, fix, 1);
+}
+
+int exportClose(BN220_Exporter *ex) {
+    if (!ex)
+        return 0;
+
+    // 1) Footer
+    exportBreak(ex);
+    switch (ex->format) {
+    case BN220_EXPORT_GPX:
+        exportPuts(ex, "</trk>\n</gpx>\n");
+        break;
+    case BN220_EXPORT_KML:
+        exportPuts(ex, "</Document>\n</kml>\n");
+        break;
+    default:
+        exportPuts(ex, "\n]}\n");
+        break;
+    }
+
+    // 2) Flush, finish the gzip stream and free
+    int ok = ex->ok && exportDrain(ex, 1);
+#if BN220_EXPORT_GZIP
+    if (ex->gzip)
+        deflateEnd(&ex->zs);
+#endif
+    free(ex);
+    return ok;
+}
+
+int exportFileWrite(void *user, const void *data, size_t len) {
+    return fwrite(data, 1, len, (FILE *)user) == len;
+}
@@ -0,0 +1,104 @@
+/*
+ * BN220_export.h — Track export
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_export.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Streaming GPX/KML/GeoJSON export of fixes through a fixed buffer,
+ *          optionally gzip-compressed.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_EXPORT_H_
+#define INC_BN220_EXPORT_H_
+
+#include "BN220.h"
+
+/*
+ * Streaming track export to GPX 1.1, KML 2.2 or GeoJSON (host side).
+ *
+ * Fixes are rendered with the integer formatters of BN220_fmt.h into one
+ * fixed output buffer that is handed to a write callback whenever it
+ * fills, optionally gzip-compressed on the way (BN220_EXPORT_GZIP=1, links
+ * zlib).  Memory use is the exporter itself, whatever the track length.
+ *
+ *   GPX      one <trk>, one <trkseg> per segment; trkpt with ele, time,
+ *            sat and hdop.
+ *   KML      one Placemark with an absolute-altitude LineString per
+ *            segment (KML cannot stream time stamps alongside).
+ *   GeoJSON  FeatureCollection with one LineString Feature per segment;
+ *            start, end and point count follow the geometry in properties.
+ *
+ * Fixes without a position fix (fix == 0) are skipped.
+ */
+typedef struct BN220_Exporter BN220_Exporter;
+
+typedef enum {
+    BN220_EXPORT_GPX = 0,
+    BN220_EXPORT_KML,
+    BN220_EXPORT_GEOJSON
+} BN220_ExportFormat;
+
+/* Output callback: returns 1 when all @p len bytes were written. */
+typedef int (*BN220_ExportWriteFn)(void *user, const void *data, size_t len);
+
+#define BN220_EXPORT_BUF 65536   // text (and compressed) buffer size
+
+/**
+ * @brief  Start a document.
+ *
+ * @param[in] format     Output format.
+ * @param[in] name       Track / document name; NULL for "track".
+ * @param[in] gzipLevel  0 for plain text, 1..9 for gzip output (needs
+ *                       BN220_EXPORT_GZIP, otherwise the call fails).
+ * @param[in] write      Output callback, e.g. exportFileWrite.
+ * @param[in] user       Passed to @p write.
+ */
+BN220_Exporter *exportOpen(BN220_ExportFormat format, const char *name, int gzipLevel,
+                           BN220_ExportWriteFn write, void *user);
+
+/**
+ * @brief  Append n fixes to the current segment (one is opened if needed).
+ *
+ * Returns 0 once a write failed; later calls keep failing.
+ */
+int exportFixes(BN220_Exporter *ex, const BN220_Fix *fix, size_t n);
+
+/* End the current segment; the next fix starts a new one (signal loss, stop). */
+int exportBreak(BN220_Exporter *ex);
+
+/**
+ * @brief  Close the document, flush and free @p ex.
+ *
+ * Returns 0 if any write failed since exportOpen.
+ */
+int exportClose(BN220_Exporter *ex);
+
+/* BN220_Context.onEpoch adapter, user = BN220_Exporter *. */
+void exportEpochSink(void *user, const BN220_Fix *fix);
+
+/* BN220_ExportWriteFn for stdio, user = FILE *. */
+int exportFileWrite(void *user, const void *data, size_t len);
+
+#endif /* INC_BN220_EXPORT_H_ */
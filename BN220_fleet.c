@@ -0,0 +1,324 @@
+/*
+ * BN220_fleet.c — Live fleet state table
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_fleet.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Open-addressing shards, record publication and epoch-based
+ *          reclamation for the fleet state store.
+ * ---------------------------------------------------------------------------
+ */
+
+#define _POSIX_C_SOURCE  200112L   // posix_memalign
+
+#include "BN220_fleet.h"
+
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 201112L || defined(__STDC_NO_ATOMICS__)
+#error "BN220_fleet.c needs C11 atomics: build it with -std=c11 or -std=gnu11"
+#endif
+
+#include <stdatomic.h>
+
+#define FLEET_CACHE_LINE    64
+#define FLEET_RECLAIM_EVERY 256   // updates between automatic reclaim passes
+#define FLEET_IDLE          0     // reader epoch value outside a read section
+
+typedef struct FleetRec {
+    BN220_Fix        fix;
+    struct FleetRec *next;     // free list / limbo list link (writer-private)
+    uint64_t         retired;  // global epoch when it was replaced
+} FleetRec;
+
+// 16-byte slots, four per cache line; key 0 marks an empty slot
+typedef struct {
+    _Atomic uint64_t          key;  // device id + 1
+    _Atomic(const FleetRec *) rec;
+} FleetSlot;
+
+typedef struct {
+    _Alignas(FLEET_CACHE_LINE)
+    FleetSlot *slots;
+    uint32_t   mask;
+    uint32_t   used;
+    uint32_t   sinceReclaim;
+    FleetRec  *freeList;   // recycled records, ready for reuse
+    FleetRec  *limbo;      // retired records, newest first
+} FleetShard;
+
+struct BN220_FleetReader {
+    _Alignas(FLEET_CACHE_LINE)
+    _Atomic uint64_t epoch;  // epoch pinned by this reader, FLEET_IDLE outside
+    atomic_int       inUse;
+};
+
+struct BN220_Fleet {
+    _Alignas(FLEET_CACHE_LINE)
+    _Atomic uint64_t   epoch;   // global epoch, starts at 1
+    uint32_t           shardMask;
+    uint32_t           shardBits;
+    uint32_t           maxReaders;
+    FleetShard        *shards;
+    BN220_FleetReader *readers;
+};
+
+
+static uint64_t fleetHash(uint64_t x) {
+    // splitmix64 finaliser: spreads sequential device ids over all slots
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+static uint32_t fleetPow2(uint32_t v) {
+    uint32_t p = 1;
+    while (p < v)
+        p <<= 1;
+    return p;
+}
+
+static void *fleetAlignedAlloc(size_t size) {
+    void *p;
+    if (posix_memalign(&p, FLEET_CACHE_LINE, size))
+        return NULL;
+    memset(p, 0, size);
+    return p;
+}
+
+
+BN220_Fleet *fleetCreate(uint32_t shards, uint32_t capacity, uint32_t maxReaders) {
+    BN220_Fleet *f = fleetAlignedAlloc(sizeof(*f));
+    if (!f)
+        return NULL;
+
+    shards = fleetPow2(shards ? shards : 1);
+    uint32_t perShard = fleetPow2((capacity + shards - 1) / shards);
+    if (perShard < 8)
+        perShard = 8;
+
+    atomic_init(&f->epoch, 1);
+    f->shardMask  = shards - 1;
+    while ((1u << f->shardBits) < shards)
+        f->shardBits++;
+    f->maxReaders = maxReaders;
+    f->shards     = fleetAlignedAlloc(sizeof(FleetShard) * shards);
+    f->readers    = fleetAlignedAlloc(sizeof(BN220_FleetReader) * (maxReaders ? maxReaders : 1));
+    if (!f->shards || !f->readers) {
+        fleetDestroy(f);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < shards; i++) {
+        f->shards[i].slots = fleetAlignedAlloc(sizeof(FleetSlot) * perShard);
+        f->shards[i].mask  = perShard - 1;
+        if (!f->shards[i].slots) {
+            fleetDestroy(f);
+            return NULL;
+        }
+    }
+    return f;
+}
+
+
+static void fleetFreeList(FleetRec *r) {
+    while (r) {
+        FleetRec *next = r->next;
+        free(r);
+        r = next;
+    }
+}
+
+void fleetDestroy(BN220_Fleet *fleet) {
+    if (!fleet)
+        return;
+    if (fleet->shards) {
+        for (uint32_t i = 0; i <= fleet->shardMask; i++) {
+            FleetShard *sh = &fleet->shards[i];
+            if (sh->slots) {
+                for (uint32_t j = 0; j <= sh->mask; j++)
+                    free((void *)atomic_load_explicit(&sh->slots[j].rec, memory_order_relaxed));
+            }
+            fleetFreeList(sh->freeList);
+            fleetFreeList(sh->limbo);
+            free(sh->slots);
+        }
+    }
+    free(fleet->shards);
+    free(fleet->readers);
+    free(fleet);
+}
+
+
+uint32_t fleetShardOf(const BN220_Fleet *fleet, uint64_t device) {
+    // Top bits pick the shard, low bits the slot, so the two stay independent
+    return fleet->shardBits ? (uint32_t)(fleetHash(device) >> (64 - fleet->shardBits)) : 0;
+}
+
+
+// Oldest epoch any reader may still be using; the current epoch if none
+static uint64_t fleetSafeEpoch(BN220_Fleet *fleet) {
+    uint64_t min = atomic_load(&fleet->epoch);
+    for (uint32_t i = 0; i < fleet->maxReaders; i++) {
+        uint64_t e = atomic_load(&fleet->readers[i].epoch);
+        if (e != FLEET_IDLE && e < min)
+            min = e;
+    }
+    return min;
+}
+
+
+void fleetReclaim(BN220_Fleet *fleet, uint32_t shard) {
+    FleetShard *sh = &fleet->shards[shard];
+
+    // 1) Move the global epoch on once every active reader has caught up
+    uint64_t cur  = atomic_load(&fleet->epoch);
+    uint64_t safe = fleetSafeEpoch(fleet);
+    if (safe == cur)
+        atomic_compare_exchange_strong(&fleet->epoch, &cur, cur + 1);
+
+    // 2) Records retired before the oldest pinned epoch are unreachable.
+    //    The limbo list is newest first, so cut it at the first old record.
+    FleetRec **pp = &sh->limbo;
+    while (*pp && (*pp)->retired >= safe)
+        pp = &(*pp)->next;
+
+    FleetRec *old = *pp;
+    *pp = NULL;
+    while (old) {
+        FleetRec *next = old->next;
+        old->next = sh->freeList;
+        sh->freeList = old;
+        old = next;
+    }
+    sh->sinceReclaim = 0;
+}
+
+
+int fleetUpdate(BN220_Fleet *fleet, uint64_t device, const BN220_Fix *fix) {
+    uint32_t    shard = fleetShardOf(fleet, device);
+    FleetShard *sh = &fleet->shards[shard];
+    uint64_t    key = device + 1;
+
+    // 1) Fresh record, recycled when possible
+    FleetRec *r = sh->freeList;
+    if (r) {
+        sh->freeList = r->next;
+    } else if (!(r = malloc(sizeof(*r)))) {
+        return 0;
+    }
+    r->fix  = *fix;
+    r->next = NULL;
+
+    // 2) Probe for the device or the first empty slot
+    for (uint32_t i = (uint32_t)fleetHash(device) & sh->mask, n = 0; n <= sh->mask;
+         i = (i + 1) & sh->mask, n++) {
+        FleetSlot *slot = &sh->slots[i];
+        uint64_t   k = atomic_load_explicit(&slot->key, memory_order_relaxed);
+
+        if (k == key) {
+            // 3a) Replace: publish, then retire the previous version
+            FleetRec *prev = (FleetRec *)atomic_exchange(&slot->rec, r);
+            prev->retired = atomic_load(&fleet->epoch);
+            prev->next    = sh->limbo;
+            sh->limbo     = prev;
+        } else if (k == 0) {
+            // 3b) Insert: record first, then the key that makes it visible
+            atomic_store_explicit(&slot->rec, r, memory_order_release);
+            atomic_store_explicit(&slot->key, key, memory_order_release);
+            sh->used++;
+        } else {
+            continue;
+        }
+
+        if (++sh->sinceReclaim >= FLEET_RECLAIM_EVERY)
+            fleetReclaim(fleet, shard);
+        return 1;
+    }
+
+    // Shard full
+    r->next = sh->freeList;
+    sh->freeList = r;
+    return 0;
+}
+
+
+BN220_FleetReader *fleetReaderRegister(BN220_Fleet *fleet) {
+    for (uint32_t i = 0; i < fleet->maxReaders; i++) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&fleet->readers[i].inUse, &expected, 1))
+            return &fleet->readers[i];
+    }
+    return NULL;
+}
+
+void fleetReaderRelease(BN220_FleetReader *reader) {
+    atomic_store(&reader->epoch, FLEET_IDLE);
+    atomic_store(&reader->inUse, 0);
+}
+
+
+void fleetReadBegin(BN220_Fleet *fleet, BN220_FleetReader *reader) {
+    // seq_cst store: the pin must be visible before any slot is read
+    atomic_store(&reader->epoch, atomic_load(&fleet->epoch));
+}
+
+void fleetReadEnd(BN220_FleetReader *reader) {
+    atomic_store_explicit(&reader->epoch, FLEET_IDLE, memory_order_release);
+}
+
+
+const BN220_Fix *fleetLookup(const BN220_Fleet *fleet, uint64_t device) {
+    const FleetShard *sh = &fleet->shards[fleetShardOf(fleet, device)];
+    uint64_t key = device + 1;
+
+    for (uint32_t i = (uint32_t)fleetHash(device) & sh->mask, n = 0; n <= sh->mask;
+         i = (i + 1) & sh->mask, n++) {
+        FleetSlot *slot = &sh->slots[i];
+        uint64_t   k = atomic_load_explicit(&slot->key, memory_order_acquire);
+
+        if (k == key)
+            return &atomic_load(&slot->rec)->fix;
+        if (k == 0)
+            return NULL;
+    }
+    return NULL;
+}
+
+
+int fleetGet(BN220_Fleet *fleet, BN220_FleetReader *reader, uint64_t device, BN220_Fix *out) {
+    fleetReadBegin(fleet, reader);
+    const BN220_Fix *fix = fleetLookup(fleet, device);
+    if (fix)
+        *out = *fix;
+    fleetReadEnd(reader);
+    return fix != NULL;
+}
+
+
+void fleetEpochSink(void *user, const BN220_Fix *fix) {
+    BN220_FleetFeed *feed = user;
+    fleetUpdate(feed->fleet, feed->device, fix);
+}
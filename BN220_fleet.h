@@ -0,0 +1,137 @@
+/*
+ * BN220_fleet.h — Live fleet state table
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_fleet.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Latest decoded fix per device in a sharded, cache-line aligned
+ *          open-addressing table with single-writer shards and epoch-based
+ *          reclamation, so readers never block writers.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_FLEET_H_
+#define INC_BN220_FLEET_H_
+
+#include "BN220.h"
+
+/*
+ * Latest fix per device for fleet backends.  Host only, and unlike the
+ * rest of the library this module needs C11 (<stdatomic.h>, _Alignas):
+ * build BN220_fleet.c with -std=c11 or -std=gnu11.
+ *
+ * The table is split into shards, each an open-addressing (linear probing)
+ * array of cache-line aligned slots.  Every shard has exactly one writer
+ * thread; route devices to writers with fleetShardOf().  Updates publish a
+ * new immutable record and retire the old one; readers pin the current
+ * epoch while they look, so they never take a lock and never block writers.
+ * Retired records are recycled once no reader can still hold them.
+ */
+typedef struct BN220_Fleet       BN220_Fleet;
+typedef struct BN220_FleetReader BN220_FleetReader;
+
+/**
+ * @brief  Create a store.
+ *
+ * @param[in] shards      Number of shards, rounded up to a power of two.
+ * @param[in] capacity    Total device slots; keep it at least 1.5x the
+ *                        number of devices.  Rounded up per shard.
+ * @param[in] maxReaders  Number of reader handles that can be registered.
+ *
+ * Returns NULL when out of memory.
+ */
+BN220_Fleet *fleetCreate(uint32_t shards, uint32_t capacity, uint32_t maxReaders);
+
+/**
+ * @brief  Free the store.  No reader or writer may be active.
+ */
+void fleetDestroy(BN220_Fleet *fleet);
+
+/**
+ * @brief  Shard that owns @p device; all its updates must come from one thread.
+ */
+uint32_t fleetShardOf(const BN220_Fleet *fleet, uint64_t device);
+
+/**
+ * @brief  Insert or replace the latest fix of @p device.
+ *
+ * Must be called only by the writer of fleetShardOf(device).  Returns 0 when
+ * the shard is full or out of memory, 1 otherwise.
+ */
+int fleetUpdate(BN220_Fleet *fleet, uint64_t device, const BN220_Fix *fix);
+
+/**
+ * @brief  Recycle retired records of a shard that no reader can still see.
+ *
+ * fleetUpdate does this on its own every few hundred updates; call it from
+ * an idle writer to release memory sooner.
+ */
+void fleetReclaim(BN220_Fleet *fleet, uint32_t shard);
+
+/**
+ * @brief  Register a reader thread.  Returns NULL when all handles are in use.
+ */
+BN220_FleetReader *fleetReaderRegister(BN220_Fleet *fleet);
+
+/**
+ * @brief  Give a reader handle back.
+ */
+void fleetReaderRelease(BN220_FleetReader *reader);
+
+/**
+ * @brief  Enter / leave a read-side critical section.
+ *
+ * Pointers returned by fleetLookup stay valid until fleetReadEnd.  Keep the
+ * section short: a reader that stays inside holds back reclamation.
+ */
+void fleetReadBegin(BN220_Fleet *fleet, BN220_FleetReader *reader);
+void fleetReadEnd(BN220_FleetReader *reader);
+
+/**
+ * @brief  Latest fix of @p device inside a read section, or NULL if unknown.
+ */
+const BN220_Fix *fleetLookup(const BN220_Fleet *fleet, uint64_t device);
+
+/**
+ * @brief  Copy the latest fix of @p device; wraps begin/lookup/end.
+ *
+ * Returns 1 when the device is known.
+ */
+int fleetGet(BN220_Fleet *fleet, BN220_FleetReader *reader, uint64_t device, BN220_Fix *out);
+
+/*
+ * Adapter so a per-device parser context can feed the store directly:
+ *
+ *   BN220_FleetFeed feed = { fleet, device_id };
+ *   ctx.onEpoch = fleetEpochSink;
+ *   ctx.user    = &feed;
+ */
+typedef struct {
+    BN220_Fleet *fleet;
+    uint64_t     device;
+} BN220_FleetFeed;
+
+void fleetEpochSink(void *user, const BN220_Fix *fix);
+
+#endif /* INC_BN220_FLEET_H_ */
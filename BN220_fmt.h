@@ -0,0 +1,157 @@
+/*
+ * BN220_fmt.h — Integer text formatting
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_fmt.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Exact integer, fixed-point and ISO 8601 formatting without printf,
+ *          shared by the text exporters.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_FMT_H_
+#define INC_BN220_FMT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/*
+ * Integer-to-text helpers shared by the text exporters.
+ *
+ * Every function writes at the cursor and returns the new cursor; nothing
+ * is NUL-terminated.  Digits come two at a time from a 200-byte table, and
+ * fixed-point values (1e-7 degrees, millimetres, hdop x 100) are printed
+ * from their integer form, so no float formatting or libc call is involved
+ * and the output is exact.  The caller guarantees room: at most 20 bytes
+ * per number and 24 for a timestamp.
+ */
+
+static const char fmtDigits2[200] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static inline char *fmtPut2(char *p, unsigned v) {
+    p[0] = fmtDigits2[2 * v];
+    p[1] = fmtDigits2[2 * v + 1];
+    return p + 2;
+}
+
+/* Unsigned decimal. */
+static inline char *fmtU64(char *p, uint64_t v) {
+    char  tmp[20];
+    char *t = tmp + sizeof(tmp);
+    while (v >= 100) {
+        t -= 2;
+        fmtPut2(t, (unsigned)(v % 100));
+        v /= 100;
+    }
+    if (v >= 10) {
+        t -= 2;
+        fmtPut2(t, (unsigned)v);
+    } else {
+        *--t = (char)('0' + v);
+    }
+    while (t < tmp + sizeof(tmp))
+        *p++ = *t++;
+    return p;
+}
+
+static inline char *fmtI64(char *p, int64_t v) {
+    if (v < 0) {
+        *p++ = '-';
+        return fmtU64(p, 0 - (uint64_t)v);
+    }
+    return fmtU64(p, (uint64_t)v);
+}
+
+/*
+ * Fixed point: v / 10^decimals with exactly @p decimals digits after the
+ * point (fmtFixed(p, -4123456789, 7) -> "-412.3456789").
+ */
+static inline char *fmtFixed(char *p, int64_t v, unsigned decimals) {
+    uint64_t u = v < 0 ? 0 - (uint64_t)v : (uint64_t)v, scale = 1;
+    for (unsigned i = 0; i < decimals; i++)
+        scale *= 10;
+    if (v < 0)
+        *p++ = '-';
+    p = fmtU64(p, u / scale);
+    if (decimals) {
+        uint64_t frac = u % scale;
+        *p++ = '.';
+        for (unsigned i = decimals; i-- > 0;) {
+            p[i] = (char)('0' + frac % 10);
+            frac /= 10;
+        }
+        p += decimals;
+    }
+    return p;
+}
+
+/*
+ * ISO 8601 UTC with milliseconds, "2026-10-18T09:41:07.250Z" (24 bytes).
+ * Civil date from days since 1970 as in H. Hinnant's days_from_civil
+ * inverse; valid for years 0..9999.
+ */
+static inline char *fmtIso8601(char *p, int64_t utc_ms) {
+    int64_t  days = utc_ms >= 0 ? utc_ms / 86400000 : -((-utc_ms + 86399999) / 86400000);
+    uint32_t ms   = (uint32_t)(utc_ms - days * 86400000);
+
+    // 1) Date
+    int64_t  z   = days + 719468;
+    int64_t  era = (z >= 0 ? z : z - 146096) / 146097;
+    uint32_t doe = (uint32_t)(z - era * 146097);
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    uint32_t mp  = (5 * doy + 2) / 153;
+    uint32_t d   = doy - (153 * mp + 2) / 5 + 1;
+    uint32_t m   = mp < 10 ? mp + 3 : mp - 9;
+    uint32_t y   = (uint32_t)(yoe + era * 400) + (m <= 2);
+
+    p    = fmtPut2(p, (y / 100) % 100);
+    p    = fmtPut2(p, y % 100);
+    *p++ = '-';
+    p    = fmtPut2(p, m);
+    *p++ = '-';
+    p    = fmtPut2(p, d);
+
+    // 2) Time of day
+    *p++ = 'T';
+    p    = fmtPut2(p, ms / 3600000);
+    *p++ = ':';
+    p    = fmtPut2(p, ms / 60000 % 60);
+    *p++ = ':';
+    p    = fmtPut2(p, ms / 1000 % 60);
+    *p++ = '.';
+    *p++ = (char)('0' + ms % 1000 / 100);
+    p    = fmtPut2(p, ms % 100);
+    *p++ = 'Z';
+    return p;
+}
+
+/* Copy a literal fragment (length known at compile time). */
+#define FMT_LIT(p, s) ((p) = (char *)memcpy((p), (s), sizeof(s) - 1) + sizeof(s) - 1)
+
+#endif /* INC_BN220_FMT_H_ */
@@ -0,0 +1,142 @@
+/*
+ * BN220_geom.c — Satellite geometry
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_geom.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   DOP for satellite subsets from the GSV table
+ * ---------------------------------------------------------------------------
+ */
+
+#include "BN220_geom.h"
+#include <math.h>
+
+// sin of 0..90 whole degrees
+static const float geomSinTable[91] = {
+    0.0f, 0.0174524064f, 0.0348994967f, 0.0523359562f, 0.0697564737f, 0.0871557427f, 0.104528463f, 0.121869343f,
+    0.139173101f, 0.156434465f, 0.173648178f, 0.190808995f, 0.207911691f, 0.224951054f, 0.241921896f, 0.258819045f,
+    0.275637356f, 0.292371705f, 0.309016994f, 0.325568154f, 0.342020143f, 0.35836795f, 0.374606593f, 0.390731128f,
+    0.406736643f, 0.422618262f, 0.438371147f, 0.4539905f, 0.469471563f, 0.48480962f, 0.5f, 0.515038075f,
+    0.529919264f, 0.544639035f, 0.559192903f, 0.573576436f, 0.587785252f, 0.601815023f, 0.615661475f, 0.629320391f,
+    0.64278761f, 0.656059029f, 0.669130606f, 0.68199836f, 0.69465837f, 0.707106781f, 0.7193398f, 0.731353702f,
+    0.743144825f, 0.75470958f, 0.766044443f, 0.777145961f, 0.788010754f, 0.79863551f, 0.809016994f, 0.819152044f,
+    0.829037573f, 0.838670568f, 0.848048096f, 0.857167301f, 0.866025404f, 0.874619707f, 0.882947593f, 0.891006524f,
+    0.898794046f, 0.906307787f, 0.913545458f, 0.920504853f, 0.927183855f, 0.933580426f, 0.939692621f, 0.945518576f,
+    0.951056516f, 0.956304756f, 0.961261696f, 0.965925826f, 0.970295726f, 0.974370065f, 0.978147601f, 0.981627183f,
+    0.984807753f, 0.987688341f, 0.990268069f, 0.992546152f, 0.994521895f, 0.996194698f, 0.99756405f, 0.998629535f,
+    0.999390827f, 0.999847695f, 1.0f,
+};
+
+// sin and cos of a whole-degree angle in [0, 360)
+static void geomSinCos(unsigned deg, float *s, float *c) {
+    unsigned q = deg / 90, r = deg % 90;
+    float    a = geomSinTable[r], b = geomSinTable[90 - r];
+    switch (q) {
+    case 0:  *s =  a; *c =  b; break;
+    case 1:  *s =  b; *c = -a; break;
+    case 2:  *s = -a; *c = -b; break;
+    default: *s = -b; *c =  a; break;
+    }
+}
+
+static int geomSelected(const BN220_Sat *sat, const BN220_GeomMask *mask) {
+    if (sat->azim == BN220_SAT_NO_POS || sat->elev < 0)
+        return 0;
+    if (!mask)
+        return 1;
+    return sat->elev >= mask->minElev && sat->snr >= mask->minSnr && (!mask->usedOnly || sat->used);
+}
+
+int geomDop(const BN220_Sat *sats, size_t n, const BN220_GeomMask *mask, BN220_Dop *dop) {
+    float h[4][4] = { { 0 } };   // normal matrix, upper triangle
+    float l[4][4] = { { 0 } };   // its Cholesky factor, lower triangle
+    float m[4][4] = { { 0 } };   // inverse of l
+    int   used = 0;
+
+    memset(dop, 0, sizeof(*dop));
+
+    // 1) Accumulate the normal matrix over the selected lines of sight
+    for (size_t i = 0; i < n; i++) {
+        if (!geomSelected(&sats[i], mask))
+            continue;
+        float se, ce, sa, ca;
+        geomSinCos((unsigned)sats[i].elev, &se, &ce);
+        geomSinCos(sats[i].azim, &sa, &ca);
+        const float r[4] = { ce * sa, ce * ca, se, 1.0f };
+        for (int a = 0; a < 4; a++)
+            for (int b = a; b < 4; b++)
+                h[a][b] += r[a] * r[b];
+        used++;
+    }
+    dop->sats = (uint8_t)(used > 255 ? 255 : used);
+    if (used < 4)
+        return 0;
+
+    // 2) Cholesky; a pivot that cancels down to rounding noise means the
+    //    lines of sight do not span all four unknowns
+    for (int j = 0; j < 4; j++) {
+        float d = h[j][j];
+        for (int k = 0; k < j; k++)
+            d -= l[j][k] * l[j][k];
+        if (!(d > 1e-6f * h[j][j]))
+            return 0;
+        l[j][j] = sqrtf(d);
+        for (int i = j + 1; i < 4; i++) {
+            float v = h[j][i];
+            for (int k = 0; k < j; k++)
+                v -= l[i][k] * l[j][k];
+            l[i][j] = v / l[j][j];
+        }
+    }
+
+    // 3) Invert the factor; diag(H^-1) is the column sums of squares of l^-1
+    for (int j = 0; j < 4; j++) {
+        m[j][j] = 1.0f / l[j][j];
+        for (int i = j + 1; i < 4; i++) {
+            float v = 0.0f;
+            for (int k = j; k < i; k++)
+                v -= l[i][k] * m[k][j];
+            m[i][j] = v / l[i][i];
+        }
+    }
+    float q[4];
+    for (int j = 0; j < 4; j++) {
+        q[j] = 0.0f;
+        for (int i = j; i < 4; i++)
+            q[j] += m[i][j] * m[i][j];
+    }
+
+    dop->hdop = sqrtf(q[0] + q[1]);
+    dop->vdop = sqrtf(q[2]);
+    dop->pdop = sqrtf(q[0] + q[1] + q[2]);
+    dop->tdop = sqrtf(q[3]);
+    dop->gdop = sqrtf(q[0] + q[1] + q[2] + q[3]);
+    return 1;
+}
+
+#if BN220_ENABLE_GSV
+int geomDopGps(const BN220_GPS *gps_data, const BN220_GeomMask *mask, BN220_Dop *dop) {
+    return geomDop(gps_data->sats, gps_data->satCount, mask, dop);
+}
+#endif
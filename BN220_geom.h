@@ -0,0 +1,84 @@
+/*
+ * BN220_geom.h — Satellite geometry
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_geom.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   DOP for satellite subsets from the GSV table
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_GEOM_H_
+#define INC_BN220_GEOM_H_
+
+#include "BN220.h"
+
+/*
+ * Dilution of precision from the decoded satellite table, for any subset
+ * of the satellites in view (elevation mask, minimum SNR, GSA-used only).
+ *
+ * Each selected satellite adds its line-of-sight row
+ * [cos el sin az, cos el cos az, sin el, 1] to the 4x4 normal matrix
+ * (east, north, up, clock); the diagonal of its inverse, through a
+ * fixed-size float32 Cholesky factorisation, gives the DOPs.  Angles are
+ * whole degrees, so the trigonometry is a 91-entry sine table: a full
+ * table costs a few hundred multiply-adds, fine for every epoch.
+ *
+ * One clock term is shared by all constellations, so with GPS and GLONASS
+ * mixed the result is slightly optimistic compared with the receiver's
+ * own solution, which estimates an inter-system offset.
+ */
+
+typedef struct {
+    int8_t  minElev;   // elevation mask in degrees
+    uint8_t minSnr;    // minimum C/N0 in dB-Hz; 0 also keeps untracked satellites
+    uint8_t usedOnly;  // 1: only satellites listed in the GSA
+} BN220_GeomMask;
+
+typedef struct {
+    float   gdop, pdop, hdop, vdop, tdop;
+    uint8_t sats;      // satellites that passed the mask
+} BN220_Dop;
+
+/**
+ * @brief  DOPs of the satellites in @p sats that pass @p mask.
+ *
+ * @param[in]  sats  Satellite table, e.g. gps.sats.
+ * @param[in]  n     Entries in @p sats.
+ * @param[in]  mask  Selection; NULL keeps every satellite with a position.
+ * @param[out] dop   DOPs and satellite count.
+ *
+ * Returns 0 when fewer than four satellites pass or the geometry is
+ * degenerate; dop->sats is still set.
+ */
+int geomDop(const BN220_Sat *sats, size_t n, const BN220_GeomMask *mask, BN220_Dop *dop);
+
+#if BN220_ENABLE_GSV
+/**
+ * @brief  geomDop() on the table of a decoded BN220_GPS.
+ */
+int geomDopGps(const BN220_GPS *gps_data, const BN220_GeomMask *mask, BN220_Dop *dop);
+#endif
+
+#endif /* INC_BN220_GEOM_H_ */
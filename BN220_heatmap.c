@@ -0,0 +1,450 @@
+/*
+ * BN220_heatmap.c — Slippy-map heatmap aggregation
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_heatmap.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Mercator table, batched projection, sharded tile maps, parallel
+ *          shard merge and sparse tile encoding.
+ * ---------------------------------------------------------------------------
+ */
+
+#include "BN220_heatmap.h"
+#include <math.h>
+#include <pthread.h>
+
+#define HEAT_LAT_MAX   850511287        // Web Mercator limit in 1e-7 degrees
+#define HEAT_LUT_STEP  10000            // table spacing: 0.001°
+#define HEAT_LUT_SIZE  (2 * HEAT_LAT_MAX / HEAT_LUT_STEP + 2)
+#define HEAT_BLOCK     256              // points projected per batch
+#define HEAT_PI        3.14159265358979323846
+
+typedef struct {
+    uint64_t  key;    // tx << 32 | ty
+    uint32_t *bins;   // NULL marks an empty slot
+} HeatSlot;
+
+typedef struct {
+    HeatSlot *slots;
+    uint32_t  mask;
+    uint32_t  used;
+} HeatMap;
+
+struct BN220_Heatmap {
+    uint8_t         zoom, binShift;
+    uint16_t        side;
+    unsigned        workers;
+    unsigned        shards;   // power of two >= workers
+    uint8_t         shardBits;  // log2(shards)
+    HeatMap        *maps;     // [worker * shards + shard]
+    BN220_HeatTile *tiles;
+    size_t          ntiles;
+};
+
+
+/* --- Projection ----------------------------------------------------------- */
+
+// Mercator y in 2^-32 units of the world height, every 0.001° of latitude
+static uint32_t       *heatLut;
+static pthread_once_t  heatLutOnce = PTHREAD_ONCE_INIT;
+
+static void heatLutBuild(void) {
+    uint32_t *lut = malloc(sizeof(uint32_t) * HEAT_LUT_SIZE);
+    if (!lut)
+        return;
+    for (size_t i = 0; i < HEAT_LUT_SIZE; i++) {
+        double lat = ((double)i * HEAT_LUT_STEP - HEAT_LAT_MAX) * 1e-7 * HEAT_PI / 180.0;
+        double y = (0.5 - log(tan(HEAT_PI / 4.0 + lat / 2.0)) / (2.0 * HEAT_PI)) * 4294967296.0;
+        lut[i] = y <= 0.0 ? 0 : y >= 4294967295.0 ? 0xFFFFFFFFu : (uint32_t)y;
+    }
+    heatLut = lut;
+}
+
+static inline uint32_t heatX32(int32_t lon_e7) {
+    // Constant divisor: compiled to a multiply-high, no division per point
+    return (uint32_t)(((uint64_t)((int64_t)lon_e7 + 1800000000) << 32) / 3600000000u);
+}
+
+static inline uint32_t heatY32(int32_t lat_e7) {
+    int32_t  lat  = lat_e7 < -HEAT_LAT_MAX ? -HEAT_LAT_MAX : lat_e7 > HEAT_LAT_MAX ? HEAT_LAT_MAX : lat_e7;
+    uint32_t off  = (uint32_t)(lat + HEAT_LAT_MAX);
+    uint32_t i    = off / HEAT_LUT_STEP;
+    uint32_t frac = off % HEAT_LUT_STEP;
+    uint64_t span = heatLut[i] - heatLut[i + 1];   // y falls as latitude rises
+    return heatLut[i] - (uint32_t)(span * frac / HEAT_LUT_STEP);
+}
+
+int heatProject(const int32_t *lat_e7, const int32_t *lon_e7, size_t n, uint8_t zoom,
+                uint32_t *px, uint32_t *py) {
+    if (zoom > 24)
+        return 0;
+    pthread_once(&heatLutOnce, heatLutBuild);
+    if (!heatLut)
+        return 0;
+    unsigned shift = 32u - 8u - zoom;
+    for (size_t i = 0; i < n; i++) {
+        px[i] = heatX32(lon_e7[i]) >> shift;
+        py[i] = heatY32(lat_e7[i]) >> shift;
+    }
+    return 1;
+}
+
+
+/* --- Tile maps ------------------------------------------------------------ */
+
+static uint32_t heatHash(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33;
+    return (uint32_t)x;
+}
+
+// Top bits pick the shard, low bits the slot, so the two stay independent
+static inline uint32_t heatShardOf(const BN220_Heatmap *heat, uint64_t key) {
+    return heat->shardBits ? heatHash(key) >> (32 - heat->shardBits) : 0;
+}
+
+static int heatMapInit(HeatMap *m, uint32_t size) {
+    m->slots = calloc(size, sizeof(HeatSlot));
+    m->mask  = size - 1;
+    m->used  = 0;
+    return m->slots != NULL;
+}
+
+static void heatMapFree(HeatMap *m) {
+    for (uint32_t i = 0; m->slots && i <= m->mask; i++)
+        free(m->slots[i].bins);
+    free(m->slots);
+    m->slots = NULL;
+}
+
+static HeatSlot *heatMapSlot(HeatMap *m, uint64_t key) {
+    for (uint32_t i = heatHash(key) & m->mask;; i = (i + 1) & m->mask) {
+        if (!m->slots[i].bins || m->slots[i].key == key)
+            return &m->slots[i];
+    }
+}
+
+static int heatMapGrow(HeatMap *m) {
+    HeatMap old = *m;
+    if (!heatMapInit(m, (old.mask + 1) * 2))
+        return *m = old, 0;
+    for (uint32_t i = 0; i <= old.mask; i++) {
+        if (old.slots[i].bins) {
+            *heatMapSlot(m, old.slots[i].key) = old.slots[i];
+            m->used++;
+        }
+    }
+    free(old.slots);
+    return 1;
+}
+
+// Bins of a tile, created zeroed on first use
+static uint32_t *heatMapBins(HeatMap *m, uint64_t key, size_t bins) {
+    HeatSlot *s = heatMapSlot(m, key);
+    if (s->bins)
+        return s->bins;
+
+    if ((m->used + 1) * 4 > (m->mask + 1) * 3) {
+        if (!heatMapGrow(m))
+            return NULL;
+        s = heatMapSlot(m, key);
+    }
+    if (!(s->bins = calloc(bins, sizeof(uint32_t))))
+        return NULL;
+    s->key = key;
+    m->used++;
+    return s->bins;
+}
+
+
+BN220_Heatmap *heatCreate(uint8_t zoom, uint8_t binShift, unsigned workers) {
+    if (zoom > 24 || binShift > 8)
+        return NULL;
+    pthread_once(&heatLutOnce, heatLutBuild);
+    if (!heatLut)
+        return NULL;
+
+    BN220_Heatmap *h = calloc(1, sizeof(*h));
+    if (!h)
+        return NULL;
+    h->zoom     = zoom;
+    h->binShift = binShift;
+    h->side     = (uint16_t)(256u >> binShift);
+    h->workers  = workers ? workers : 1;
+    h->shards   = 1;
+    while (h->shards < h->workers) {
+        h->shards <<= 1;
+        h->shardBits++;
+    }
+
+    h->maps = calloc((size_t)h->workers * h->shards, sizeof(HeatMap));
+    for (size_t i = 0; h->maps && i < (size_t)h->workers * h->shards; i++) {
+        if (!heatMapInit(&h->maps[i], 64)) {
+            heatDestroy(h);
+            return NULL;
+        }
+    }
+    if (!h->maps) {
+        free(h);
+        return NULL;
+    }
+    return h;
+}
+
+void heatDestroy(BN220_Heatmap *heat) {
+    if (!heat)
+        return;
+    for (size_t i = 0; heat->maps && i < (size_t)heat->workers * heat->shards; i++)
+        heatMapFree(&heat->maps[i]);
+    free(heat->maps);
+    free(heat->tiles);
+    free(heat);
+}
+
+
+/* --- Counting ------------------------------------------------------------- */
+
+int heatAdd(BN220_Heatmap *heat, unsigned worker, const int32_t *lat_e7, const int32_t *lon_e7,
+            size_t n) {
+    HeatMap  *maps = &heat->maps[(size_t)worker * heat->shards];
+    size_t    bins = (size_t)heat->side * heat->side;
+    uint32_t  px[HEAT_BLOCK], py[HEAT_BLOCK];
+    uint64_t  lastKey = UINT64_MAX;
+    uint32_t *last = NULL;
+
+    for (size_t base = 0; base < n; base += HEAT_BLOCK) {
+        size_t m = n - base < HEAT_BLOCK ? n - base : HEAT_BLOCK;
+
+        // 1) Project a block at once (no table lookups in the counting loop)
+        if (!heatProject(lat_e7 + base, lon_e7 + base, m, heat->zoom, px, py))
+            return 0;
+
+        // 2) Count; tracks stay on one tile for long runs, so cache it
+        for (size_t i = 0; i < m; i++) {
+            uint64_t key = ((uint64_t)(px[i] >> 8) << 32) | (py[i] >> 8);
+            if (key != lastKey) {
+                last = heatMapBins(&maps[heatShardOf(heat, key)], key, bins);
+                if (!last)
+                    return 0;
+                lastKey = key;
+            }
+            uint32_t bx = (px[i] & 0xFF) >> heat->binShift;
+            uint32_t by = (py[i] & 0xFF) >> heat->binShift;
+            last[by * heat->side + bx]++;
+        }
+    }
+    return 1;
+}
+
+
+typedef struct {
+    BN220_Heatmap *heat;
+    unsigned       worker;
+    const int32_t *lat, *lon;
+    size_t         n;
+    int            ok;
+} HeatJob;
+
+static void *heatAddMain(void *arg) {
+    HeatJob *j = arg;
+    j->ok = heatAdd(j->heat, j->worker, j->lat, j->lon, j->n);
+    return NULL;
+}
+
+// One job per worker; the last one runs on the calling thread
+static int heatRun(BN220_Heatmap *heat, HeatJob *job, void *(*fn)(void *)) {
+    pthread_t *tid = malloc(sizeof(pthread_t) * heat->workers);
+    unsigned   started = 0;
+    int        ok = tid != NULL;
+
+    for (; ok && started + 1 < heat->workers; started++) {
+        if (pthread_create(&tid[started], NULL, fn, &job[started]) != 0) {
+            ok = 0;
+            break;
+        }
+    }
+    if (ok)
+        fn(&job[heat->workers - 1]);
+    for (unsigned i = 0; i < started; i++)
+        pthread_join(tid[i], NULL);
+    for (unsigned i = 0; ok && i < heat->workers; i++)
+        ok = job[i].ok;
+    free(tid);
+    return ok;
+}
+
+int heatAddParallel(BN220_Heatmap *heat, const int32_t *lat_e7, const int32_t *lon_e7, size_t n) {
+    HeatJob *job = malloc(sizeof(HeatJob) * heat->workers);
+    if (!job)
+        return 0;
+    for (unsigned w = 0; w < heat->workers; w++) {
+        size_t lo = n * w / heat->workers, hi = n * (w + 1) / heat->workers;
+        job[w] = (HeatJob){ heat, w, lat_e7 + lo, lon_e7 + lo, hi - lo, 0 };
+    }
+    int ok = heatRun(heat, job, heatAddMain);
+    free(job);
+    return ok;
+}
+
+
+/* --- Merge ---------------------------------------------------------------- */
+
+// Fold shard s of every worker into worker 0; bins are moved when possible
+static void *heatMergeMain(void *arg) {
+    HeatJob       *j    = arg;
+    BN220_Heatmap *heat = j->heat;
+    size_t         bins = (size_t)heat->side * heat->side;
+
+    j->ok = 1;
+    for (unsigned s = j->worker; s < heat->shards; s += heat->workers) {
+        HeatMap *dst = &heat->maps[s];
+        for (unsigned w = 1; w < heat->workers; w++) {
+            HeatMap *src = &heat->maps[(size_t)w * heat->shards + s];
+            for (uint32_t i = 0; i <= src->mask; i++) {
+                HeatSlot *from = &src->slots[i];
+                if (!from->bins)
+                    continue;
+
+                HeatSlot *to = heatMapSlot(dst, from->key);
+                if (!to->bins) {
+                    if ((dst->used + 1) * 4 > (dst->mask + 1) * 3) {
+                        if (!heatMapGrow(dst)) {
+                            j->ok = 0;
+                            return NULL;
+                        }
+                        to = heatMapSlot(dst, from->key);
+                    }
+                    *to = *from;
+                    dst->used++;
+                } else {
+                    for (size_t b = 0; b < bins; b++)
+                        to->bins[b] += from->bins[b];
+                    free(from->bins);
+                }
+                from->bins = NULL;
+            }
+            src->used = 0;
+        }
+    }
+    return NULL;
+}
+
+static int heatTileCmp(const void *a, const void *b) {
+    const BN220_HeatTile *x = a, *y = b;
+    if (x->y != y->y)
+        return x->y < y->y ? -1 : 1;
+    return (x->x > y->x) - (x->x < y->x);
+}
+
+int heatMerge(BN220_Heatmap *heat) {
+    HeatJob *job = malloc(sizeof(HeatJob) * heat->workers);
+    if (!job)
+        return 0;
+    for (unsigned w = 0; w < heat->workers; w++)
+        job[w] = (HeatJob){ .heat = heat, .worker = w };
+
+    // 1) Shards are independent: merge them in parallel
+    int ok = heatRun(heat, job, heatMergeMain);
+    free(job);
+    if (!ok)
+        return 0;
+
+    // 2) Tile list from worker 0's shards
+    size_t count = 0;
+    for (unsigned s = 0; s < heat->shards; s++)
+        count += heat->maps[s].used;
+
+    BN220_HeatTile *tiles = malloc(sizeof(BN220_HeatTile) * (count ? count : 1));
+    if (!tiles)
+        return 0;
+
+    size_t bins = (size_t)heat->side * heat->side, n = 0;
+    for (unsigned s = 0; s < heat->shards; s++) {
+        const HeatMap *m = &heat->maps[s];
+        for (uint32_t i = 0; i <= m->mask; i++) {
+            if (!m->slots[i].bins)
+                continue;
+            BN220_HeatTile *t = &tiles[n++];
+            t->x     = (uint32_t)(m->slots[i].key >> 32);
+            t->y     = (uint32_t)m->slots[i].key;
+            t->zoom  = heat->zoom;
+            t->side  = heat->side;
+            t->bins  = m->slots[i].bins;
+            t->total = 0;
+            for (size_t b = 0; b < bins; b++)
+                t->total += t->bins[b];
+        }
+    }
+    qsort(tiles, n, sizeof(*tiles), heatTileCmp);
+
+    free(heat->tiles);
+    heat->tiles  = tiles;
+    heat->ntiles = n;
+    return 1;
+}
+
+size_t heatTileCount(const BN220_Heatmap *heat) {
+    return heat->ntiles;
+}
+
+const BN220_HeatTile *heatTile(const BN220_Heatmap *heat, size_t i) {
+    return i < heat->ntiles ? &heat->tiles[i] : NULL;
+}
+
+
+/* --- Output --------------------------------------------------------------- */
+
+static size_t heatVarint(uint8_t *out, size_t pos, size_t cap, uint64_t v) {
+    do {
+        if (pos >= cap)
+            return cap + 1;
+        out[pos++] = (uint8_t)((v & 0x7F) | (v > 0x7F ? 0x80 : 0));
+        v >>= 7;
+    } while (v);
+    return pos;
+}
+
+size_t heatEncodeTile(const BN220_HeatTile *tile, uint8_t *out, size_t cap) {
+    size_t bins = (size_t)tile->side * tile->side, nnz = 0;
+    for (size_t b = 0; b < bins; b++)
+        nnz += tile->bins[b] != 0;
+
+    size_t pos = 0;
+    pos = heatVarint(out, pos, cap, tile->zoom);
+    pos = heatVarint(out, pos, cap, tile->x);
+    pos = heatVarint(out, pos, cap, tile->y);
+    pos = heatVarint(out, pos, cap, tile->side);
+    pos = heatVarint(out, pos, cap, nnz);
+
+    size_t prev = 0;
+    for (size_t b = 0; b < bins && pos <= cap; b++) {
+        if (!tile->bins[b])
+            continue;
+        pos  = heatVarint(out, pos, cap, b - prev);
+        pos  = heatVarint(out, pos, cap, tile->bins[b]);
+        prev = b;
+    }
+    return pos <= cap ? pos : 0;
+}
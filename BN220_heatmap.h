@@ -0,0 +1,111 @@
+/*
+ * BN220_heatmap.h — Slippy-map heatmap aggregation
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_heatmap.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Integer Web Mercator projection and per-worker sharded tile
+ *          counters merged into compact tiles.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_HEATMAP_H_
+#define INC_BN220_HEATMAP_H_
+
+#include "BN220.h"
+
+/*
+ * Heatmap aggregation on slippy-map (Web Mercator, 256 px) tiles.
+ *
+ * Fixes are projected to global pixel coordinates with integer math: x is a
+ * constant division of the longitude, y interpolates a Mercator table
+ * indexed by latitude, so no libm call is made per point.  Pixels are
+ * counted in bins of 2^binShift x 2^binShift inside their tile.  Every
+ * worker owns a tile hash map split into shards; heatMerge() combines the
+ * workers shard by shard in parallel, so workers never share a cache line
+ * while counting.
+ */
+typedef struct BN220_Heatmap BN220_Heatmap;
+
+typedef struct {
+    uint32_t        x, y;      // tile index at zoom
+    uint8_t         zoom;
+    uint16_t        side;      // bins per tile edge
+    uint64_t        total;     // sum of all bins
+    const uint32_t *bins;      // side x side counters, row-major, north first
+} BN220_HeatTile;
+
+/**
+ * @brief  Project n points to global pixel coordinates at @p zoom (<= 24).
+ *
+ * Latitudes are clamped to the Web Mercator limit (±85.0511°).  Returns 0
+ * for a zoom above 24 or if the projection table could not be allocated.
+ */
+int heatProject(const int32_t *lat_e7, const int32_t *lon_e7, size_t n, uint8_t zoom,
+                uint32_t *px, uint32_t *py);
+
+/**
+ * @brief  Create an aggregator.
+ *
+ * @param[in] zoom      Tile zoom level, 0..24.
+ * @param[in] binShift  log2 of the bin edge in pixels, 0..8 (2 = 4x4 px bins).
+ * @param[in] workers   Threads that will count; each gets its own maps.
+ */
+BN220_Heatmap *heatCreate(uint8_t zoom, uint8_t binShift, unsigned workers);
+
+void heatDestroy(BN220_Heatmap *heat);
+
+/**
+ * @brief  Count points on behalf of @p worker (one thread per worker index).
+ *
+ * Returns 0 when out of memory.
+ */
+int heatAdd(BN220_Heatmap *heat, unsigned worker, const int32_t *lat_e7, const int32_t *lon_e7,
+            size_t n);
+
+/**
+ * @brief  Split n points over all workers on their own threads.
+ */
+int heatAddParallel(BN220_Heatmap *heat, const int32_t *lat_e7, const int32_t *lon_e7, size_t n);
+
+/**
+ * @brief  Merge the worker maps into the tile list (tiles sorted by y, x).
+ *
+ * Counting may continue afterwards; merge again to refresh the list.
+ * Tiles returned earlier are invalidated.  Returns 0 on failure.
+ */
+int heatMerge(BN220_Heatmap *heat);
+
+size_t heatTileCount(const BN220_Heatmap *heat);
+const BN220_HeatTile *heatTile(const BN220_Heatmap *heat, size_t i);
+
+/**
+ * @brief  Sparse tile encoding: varints zoom, x, y, side, nnz, then per
+ *         non-zero bin (index gap, count).
+ *
+ * Returns the encoded size, or 0 if @p cap is too small.
+ */
+size_t heatEncodeTile(const BN220_HeatTile *tile, uint8_t *out, size_t cap);
+
+#endif /* INC_BN220_HEATMAP_H_ */
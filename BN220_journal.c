@@ -0,0 +1,323 @@
+/*
+ * BN220_journal.c — Fix journal
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_journal.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Block staging and sealing, group commit, recovery scan and the
+ *          pwrite/fdatasync file store.
+ * ---------------------------------------------------------------------------
+ */
+
+#define _FILE_OFFSET_BITS 64
+#define _POSIX_C_SOURCE  200809L   // pread, pwrite, fdatasync
+
+#include "BN220_journal.h"
+#if !BN220_PLATFORM_HAL
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define JOURNAL_MAGIC 0x314A4E42u   // "BNJ1"
+
+// Trailer fields, from the start of the trailer
+#define JT_MAGIC  0
+#define JT_SEQ    4
+#define JT_COUNT  8
+#define JT_GEN    10
+#define JT_CRC    12
+
+/* CRC-32 (IEEE, reflected), four bits per step: a 64-byte table for flash */
+static const uint32_t journalCrcTable[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+static uint32_t journalCrc(const uint8_t *p, size_t n) {
+    uint32_t crc = 0xFFFFFFFFu;
+    while (n--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ journalCrcTable[crc & 15];
+        crc = (crc >> 4) ^ journalCrcTable[crc & 15];
+    }
+    return ~crc;
+}
+
+static void journalPut16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void journalPut32(uint8_t *p, uint32_t v) {
+    journalPut16(p, (uint16_t)v);
+    journalPut16(p + 2, (uint16_t)(v >> 16));
+}
+
+static uint16_t journalGet16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t journalGet32(const uint8_t *p) {
+    return journalGet16(p) | ((uint32_t)journalGet16(p + 2) << 16);
+}
+
+
+static uint64_t journalOffset(const BN220_Journal *j, uint32_t seq) {
+    uint32_t slot = j->capacity ? seq % j->capacity : seq;
+    return (uint64_t)slot * j->blockSize;
+}
+
+// Close staged block @p idx holding @p count records
+static void journalSeal(BN220_Journal *j, uint32_t idx, uint16_t count) {
+    uint8_t *block = j->buf + (size_t)idx * j->blockSize;
+    uint8_t *t     = block + j->blockSize - BN220_JOURNAL_TRAILER;
+    size_t   used  = (size_t)count * sizeof(BN220_LogRecord);
+
+    memset(block + used, 0, (size_t)(t - block) - used);
+    journalPut32(t + JT_MAGIC, JOURNAL_MAGIC);
+    journalPut32(t + JT_SEQ, j->nextSeq + idx);
+    journalPut16(t + JT_COUNT, count);
+    journalPut16(t + JT_GEN, j->gen);
+    journalPut32(t + JT_CRC, journalCrc(block, j->blockSize - 4));
+}
+
+// Record count of a block read back, or -1 if it is not valid block @p seq
+static int journalCheck(const BN220_Journal *j, const uint8_t *block, uint32_t slot, uint32_t *seq,
+                        uint16_t *gen) {
+    const uint8_t *t = block + j->blockSize - BN220_JOURNAL_TRAILER;
+    uint16_t       count = journalGet16(t + JT_COUNT);
+
+    if (journalGet32(t + JT_MAGIC) != JOURNAL_MAGIC || count > j->perBlock ||
+        journalGet32(t + JT_CRC) != journalCrc(block, j->blockSize - 4))
+        return -1;
+    *seq = journalGet32(t + JT_SEQ);
+    *gen = journalGet16(t + JT_GEN);
+    if ((j->capacity ? *seq % j->capacity : *seq) != slot)
+        return -1;
+    return count;
+}
+
+
+int journalInit(BN220_Journal *j, const BN220_JournalStore *store, void *buf, size_t bufSize,
+                uint32_t blockSize, uint32_t capacity, uint32_t commitMs) {
+    memset(j, 0, sizeof(*j));
+    if (blockSize < BN220_JOURNAL_TRAILER + sizeof(BN220_LogRecord) || bufSize < blockSize ||
+        BN220_JOURNAL_PER_BLOCK(blockSize) > UINT16_MAX)
+        return 0;
+    j->store     = *store;
+    j->buf       = buf;
+    j->bufBlocks = (uint32_t)(bufSize / blockSize);
+    j->blockSize = blockSize;
+    j->capacity  = capacity;
+    j->commitMs  = commitMs;
+    j->perBlock  = (uint16_t)BN220_JOURNAL_PER_BLOCK(blockSize);
+    return 1;
+}
+
+int journalCommit(BN220_Journal *j) {
+    // 1) The open block is sealed as it is; it becomes an ordinary staged block
+    if (j->fill) {
+        journalSeal(j, j->staged, j->fill);
+        j->staged++;
+        j->fill = 0;
+    }
+    if (!j->staged)
+        return 1;
+
+    // 2) One write per contiguous run (two when a circular store wraps), one sync
+    uint32_t run = j->staged;
+    if (j->capacity && j->nextSeq % j->capacity + run > j->capacity)
+        run = j->capacity - j->nextSeq % j->capacity;
+    size_t bs = j->blockSize;
+    if (!j->store.write(j->store.user, journalOffset(j, j->nextSeq), j->buf, run * bs))
+        return 0;
+    if (run < j->staged &&
+        !j->store.write(j->store.user, 0, j->buf + run * bs, (j->staged - run) * bs))
+        return 0;
+    if (j->store.sync && !j->store.sync(j->store.user))
+        return 0;
+
+    j->nextSeq += j->staged;
+    j->blocks  += j->staged;
+    j->commits++;
+    j->staged = 0;
+    return 1;
+}
+
+int journalTick(BN220_Journal *j, uint32_t now_ms) {
+    if ((j->staged || j->fill) && now_ms - j->oldest_ms >= j->commitMs)
+        return journalCommit(j);
+    return 1;
+}
+
+int journalAppend(BN220_Journal *j, const BN220_LogRecord *recs, size_t n, uint32_t now_ms) {
+    int ok = 1;
+    for (size_t i = 0; i < n; i++) {
+        // 1) Staging full after a failed commit: retry, else drop the rest
+        if (j->staged == j->bufBlocks && !journalCommit(j))
+            return 0;
+
+        if (!j->staged && !j->fill)
+            j->oldest_ms = now_ms;
+        BN220_LogRecord *dst = (BN220_LogRecord *)(j->buf + (size_t)j->staged * j->blockSize);
+        dst[j->fill++] = recs[i];
+
+        // 2) Size commit once every staging block is sealed
+        if (j->fill == j->perBlock) {
+            journalSeal(j, j->staged, j->fill);
+            j->staged++;
+            j->fill = 0;
+            if (j->staged == j->bufBlocks)
+                ok = journalCommit(j);
+        }
+    }
+    return journalTick(j, now_ms) && ok;
+}
+
+
+uint64_t journalRecover(BN220_Journal *j, BN220_LogSink replay, void *user) {
+    uint8_t *block = j->buf;
+    uint64_t total = 0;
+    uint32_t seq, newest = 0, slot = 0;
+    uint16_t gen, maxGen = 0, topGen = 0;
+    int      found = 0, seen = 0, count;
+
+    if (!j->capacity) {
+        // 1a) Growing store: blocks in slot order up to the first invalid one
+        //     or the first one of an older generation (an unfinished group)
+        for (; j->store.read(j->store.user, (uint64_t)slot * j->blockSize, block, j->blockSize);
+             slot++) {
+            if ((count = journalCheck(j, block, slot, &seq, &gen)) < 0 ||
+                (found && (int16_t)(gen - maxGen) < 0))
+                break;
+            if (replay && count && !replay(user, (const BN220_LogRecord *)block, (size_t)count))
+                replay = NULL;
+            total  += (uint64_t)count;
+            maxGen  = gen;
+            newest  = seq;
+            found   = 1;
+        }
+        topGen = maxGen;
+        seen   = found;
+
+        // 1b) Past the break, valid blocks of a group whose first block was
+        //     torn may remain; the next generation must be newer than those too
+        for (; j->store.read(j->store.user, (uint64_t)slot * j->blockSize, block, j->blockSize);
+             slot++) {
+            if (journalCheck(j, block, slot, &seq, &gen) < 0)
+                continue;
+            if (!seen || (int16_t)(gen - topGen) > 0)
+                topGen = gen;
+            seen = 1;
+        }
+    } else {
+        // 1c) Circular store: the newest block of the newest generation...
+        for (; slot < j->capacity; slot++) {
+            if (!j->store.read(j->store.user, (uint64_t)slot * j->blockSize, block, j->blockSize) ||
+                journalCheck(j, block, slot, &seq, &gen) < 0)
+                continue;
+            if (!found || (int16_t)(gen - maxGen) > 0 ||
+                (gen == maxGen && (int32_t)(seq - newest) > 0)) {
+                maxGen = gen;
+                newest = seq;
+            }
+            found = 1;
+        }
+        topGen = maxGen;
+        seen   = found;
+
+        // ...then the ring from the oldest slot, replaying blocks up to it
+        for (uint32_t k = 1; found && k <= j->capacity; k++) {
+            uint32_t want = newest - j->capacity + k;
+            if (!j->store.read(j->store.user, journalOffset(j, want), block, j->blockSize) ||
+                (count = journalCheck(j, block, want % j->capacity, &seq, &gen)) < 0 || seq != want)
+                continue;
+            if (replay && count && !replay(user, (const BN220_LogRecord *)block, (size_t)count))
+                replay = NULL;
+            total += (uint64_t)count;
+        }
+    }
+
+    // 2) Continue after the newest block with a generation above any on the medium
+    j->nextSeq = found ? newest + 1 : 0;
+    j->gen     = seen ? (uint16_t)(topGen + 1) : 0;
+    j->staged  = 0;
+    j->fill    = 0;
+    return total;
+}
+
+
+#if !BN220_PLATFORM_HAL
+/* --- Host file store ------------------------------------------------------ */
+
+static int journalFileWrite(void *user, uint64_t offset, const void *data, size_t len) {
+    int            fd = (int)(intptr_t)user;
+    const uint8_t *p  = data;
+    while (len) {
+        ssize_t n = pwrite(fd, p, len, (off_t)offset);
+        if (n <= 0)
+            return 0;
+        p      += n;
+        offset += (uint64_t)n;
+        len    -= (size_t)n;
+    }
+    return 1;
+}
+
+static int journalFileRead(void *user, uint64_t offset, void *data, size_t len) {
+    int      fd = (int)(intptr_t)user;
+    uint8_t *p  = data;
+    while (len) {
+        ssize_t n = pread(fd, p, len, (off_t)offset);
+        if (n <= 0)
+            return 0;
+        p      += n;
+        offset += (uint64_t)n;
+        len    -= (size_t)n;
+    }
+    return 1;
+}
+
+static int journalFileSync(void *user) {
+    return fdatasync((int)(intptr_t)user) == 0;
+}
+
+int journalFileOpen(BN220_JournalStore *store, const char *path) {
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+        return 0;
+    store->write = journalFileWrite;
+    store->read  = journalFileRead;
+    store->sync  = journalFileSync;
+    store->user  = (void *)(intptr_t)fd;
+    return 1;
+}
+
+void journalFileClose(BN220_JournalStore *store) {
+    if (store->write == journalFileWrite)
+        close((int)(intptr_t)store->user);
+    store->user  = NULL;
+    store->write = NULL;
+}
+#endif
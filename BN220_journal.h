@@ -0,0 +1,154 @@
+/*
+ * BN220_journal.h — Fix journal
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_journal.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Append-only, group-committed fix journal with CRC block trailers
+ *          and recovery scan, on flash or files.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_JOURNAL_H_
+#define INC_BN220_JOURNAL_H_
+
+#include "BN220.h"
+#include "BN220_merge.h"
+
+/*
+ * Append-only fix journal with group commit, for SD/flash on the MCU and
+ * files on the host.
+ *
+ * Records (BN220_LogRecord) are staged in a caller buffer of whole blocks
+ * and reach storage only at a commit: all staged blocks go out in one
+ * block-aligned write, followed by one sync.  A commit happens when the
+ * staging buffer is full (size) or when the oldest staged record is
+ * commitMs old (time), so storage sees one write per group instead of one
+ * per epoch.  A time commit seals the open block even if it is not full;
+ * committed blocks are never rewritten, which keeps flash pages program-
+ * once and a torn write from damaging earlier data.
+ *
+ * Block layout (blockSize bytes): records from offset 0, zero padding, and
+ * a 16-byte trailer: magic "BNJ1", sequence number, record count,
+ * generation, CRC-32 of everything before the CRC (little endian).  Block
+ * seq lives at slot seq (growing store) or seq % capacity (circular store).
+ * journalRecover() scans the slots, replays every block whose CRC and slot
+ * match in sequence order, and positions the writer after the newest one.
+ * Recovery continues with a generation above every valid block on the
+ * medium, including blocks past the replayed ones, so blocks left over from
+ * a group that never finished before a crash are not mistaken for newer
+ * data.  A growing store is therefore read to its end: read() must return 0
+ * past the journal's extent (end of file, or of the partition on SD).
+ */
+
+/*
+ * Storage behind the journal; offsets and lengths are multiples of the
+ * block size.  On flash, write() must erase a sector before programming
+ * its first block.  read() returns 0 past the end of the medium.
+ */
+typedef struct {
+    int   (*write)(void *user, uint64_t offset, const void *data, size_t len);
+    int   (*read)(void *user, uint64_t offset, void *data, size_t len);
+    int   (*sync)(void *user);   // durability barrier; may be NULL
+    void   *user;
+} BN220_JournalStore;
+
+typedef struct {
+    BN220_JournalStore store;
+    uint8_t  *buf;           // staging: bufBlocks x blockSize
+    uint32_t  bufBlocks;
+    uint32_t  blockSize;
+    uint32_t  capacity;      // blocks in a circular store, 0 = growing
+    uint32_t  commitMs;      // time commit bound
+    uint32_t  nextSeq;       // sequence number of buf[0]
+    uint16_t  gen;           // generation: bumped by every journalRecover
+    uint32_t  staged;        // sealed blocks in buf
+    uint16_t  fill;          // records in the open block
+    uint16_t  perBlock;      // records per block
+    uint32_t  oldest_ms;     // arrival of the oldest staged record
+    uint64_t  commits;       // write + sync groups issued
+    uint64_t  blocks;        // blocks written
+} BN220_Journal;
+
+#define BN220_JOURNAL_TRAILER 16
+#define BN220_JOURNAL_PER_BLOCK(blockSize) \
+    (((blockSize) - BN220_JOURNAL_TRAILER) / sizeof(BN220_LogRecord))
+
+/**
+ * @brief  Initialise a journal.
+ *
+ * @param[out] j          Journal state.
+ * @param[in]  store      Storage; copied.
+ * @param[in]  buf        Staging buffer, aligned for BN220_LogRecord.
+ * @param[in]  bufSize    Its size; whole blocks are used (at least one).
+ * @param[in]  blockSize  Block size, e.g. 512 (SD sector) or 4096 (page).
+ * @param[in]  capacity   Blocks in a circular store, 0 for a growing file.
+ * @param[in]  commitMs   Longest a record may stay staged.
+ *
+ * Returns 0 for a block size that holds no record or a buffer below one block.
+ */
+int journalInit(BN220_Journal *j, const BN220_JournalStore *store, void *buf, size_t bufSize,
+                uint32_t blockSize, uint32_t capacity, uint32_t commitMs);
+
+/**
+ * @brief  Replay an existing journal into @p replay and continue after it.
+ *
+ * Call once after journalInit when reopening a store.  Returns the number
+ * of records replayed; @p replay may be NULL to only find the end.
+ */
+uint64_t journalRecover(BN220_Journal *j, BN220_LogSink replay, void *user);
+
+/**
+ * @brief  Stage records; commits when the staging buffer fills or the
+ *         oldest staged record is commitMs old.
+ *
+ * @param[in] now_ms  Monotonic milliseconds (HAL_GetTick on the MCU).
+ *
+ * Returns 0 if a commit failed: staged blocks are kept for the next commit,
+ * records that no longer fit the full staging buffer are dropped.
+ */
+int journalAppend(BN220_Journal *j, const BN220_LogRecord *recs, size_t n, uint32_t now_ms);
+
+/**
+ * @brief  Time check without new records; call periodically.
+ */
+int journalTick(BN220_Journal *j, uint32_t now_ms);
+
+/**
+ * @brief  Write and sync everything staged now (shutdown, power fail).
+ */
+int journalCommit(BN220_Journal *j);
+
+#if !BN220_PLATFORM_HAL
+/**
+ * @brief  Store on a local file: pwrite, pread and fdatasync.
+ *
+ * The file is created if missing and never truncated; run journalRecover
+ * to continue an existing journal.  Returns 0 on error.
+ */
+int  journalFileOpen(BN220_JournalStore *store, const char *path);
+void journalFileClose(BN220_JournalStore *store);
+#endif
+
+#endif /* INC_BN220_JOURNAL_H_ */
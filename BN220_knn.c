@@ -0,0 +1,305 @@
+/*
+ * BN220_knn.c — Live k-nearest-devices index
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_knn.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Cell hashing, O(1) in-place updates and ring-expansion k-NN search
+ *          with a bounded max-heap.
+ * ---------------------------------------------------------------------------
+ */
+
+#include "BN220_knn.h"
+#include <math.h>
+
+#define GRID_NONE     0xFFFFFFFFu
+#define GRID_LON_SPAN 3600000000LL  // 360° in 1e-7 degrees
+#define GRID_LAT_SPAN 1800000000LL  // 180° in 1e-7 degrees
+#define GRID_M_PER_E7 (6371008.8 * 3.14159265358979323846 / 180.0 / 1e7)
+
+struct BN220_Grid {
+    int32_t   cell;        // cell size in 1e-7 degrees
+    int32_t   ncx, ncy;    // cells around the globe / pole to pole
+    uint32_t  bucketMask;
+    uint32_t  maxDevices;
+    uint32_t *head;        // first device of each bucket
+    uint32_t *next, *prev; // intrusive bucket lists
+    int32_t  *lat, *lon;   // last position
+    int32_t  *cx, *cy;     // cell of the last position
+    uint8_t  *present;
+};
+
+
+static uint32_t gridBucket(const BN220_Grid *g, int32_t cx, int32_t cy) {
+    uint64_t x = ((uint64_t)(uint32_t)cx << 32) | (uint32_t)cy;
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33;
+    return (uint32_t)x & g->bucketMask;
+}
+
+static inline int32_t gridWrapX(const BN220_Grid *g, int32_t cx) {
+    cx %= g->ncx;
+    return cx < 0 ? cx + g->ncx : cx;
+}
+
+static inline int32_t gridCellX(const BN220_Grid *g, int32_t lon_e7) {
+    return gridWrapX(g, (int32_t)(((int64_t)lon_e7 + GRID_LON_SPAN / 2) / g->cell));
+}
+
+static inline int32_t gridCellY(const BN220_Grid *g, int32_t lat_e7) {
+    int32_t cy = (int32_t)(((int64_t)lat_e7 + GRID_LAT_SPAN / 2) / g->cell);
+    return cy < g->ncy ? cy : g->ncy - 1;
+}
+
+
+BN220_Grid *gridCreate(uint32_t maxDevices, int32_t cell_e7, uint32_t buckets) {
+    if (cell_e7 <= 0)
+        return NULL;
+
+    BN220_Grid *g = calloc(1, sizeof(*g));
+    if (!g)
+        return NULL;
+
+    uint32_t nb = 1;
+    while (nb < buckets)
+        nb <<= 1;
+
+    g->cell       = cell_e7;
+    g->ncx        = (int32_t)((GRID_LON_SPAN + cell_e7 - 1) / cell_e7);
+    g->ncy        = (int32_t)((GRID_LAT_SPAN + cell_e7 - 1) / cell_e7 + 1);
+    g->bucketMask = nb - 1;
+    g->maxDevices = maxDevices;
+    g->head    = malloc(sizeof(uint32_t) * nb);
+    g->next    = malloc(sizeof(uint32_t) * maxDevices);
+    g->prev    = malloc(sizeof(uint32_t) * maxDevices);
+    g->lat     = malloc(sizeof(int32_t) * maxDevices);
+    g->lon     = malloc(sizeof(int32_t) * maxDevices);
+    g->cx      = malloc(sizeof(int32_t) * maxDevices);
+    g->cy      = malloc(sizeof(int32_t) * maxDevices);
+    g->present = calloc(maxDevices, 1);
+    if (!g->head || !g->next || !g->prev || !g->lat || !g->lon || !g->cx || !g->cy || !g->present) {
+        gridDestroy(g);
+        return NULL;
+    }
+    memset(g->head, 0xFF, sizeof(uint32_t) * nb);
+    return g;
+}
+
+
+void gridDestroy(BN220_Grid *grid) {
+    if (!grid)
+        return;
+    free(grid->head);
+    free(grid->next);
+    free(grid->prev);
+    free(grid->lat);
+    free(grid->lon);
+    free(grid->cx);
+    free(grid->cy);
+    free(grid->present);
+    free(grid);
+}
+
+
+static void gridUnlink(BN220_Grid *g, uint32_t d) {
+    uint32_t n = g->next[d], p = g->prev[d];
+    if (p != GRID_NONE)
+        g->next[p] = n;
+    else
+        g->head[gridBucket(g, g->cx[d], g->cy[d])] = n;
+    if (n != GRID_NONE)
+        g->prev[n] = p;
+}
+
+static void gridLink(BN220_Grid *g, uint32_t d) {
+    uint32_t b = gridBucket(g, g->cx[d], g->cy[d]);
+    g->prev[d] = GRID_NONE;
+    g->next[d] = g->head[b];
+    if (g->head[b] != GRID_NONE)
+        g->prev[g->head[b]] = d;
+    g->head[b] = d;
+}
+
+
+int gridUpdate(BN220_Grid *grid, uint32_t device, int32_t lat_e7, int32_t lon_e7) {
+    if (device >= grid->maxDevices)
+        return 0;
+
+    int32_t cx = gridCellX(grid, lon_e7);
+    int32_t cy = gridCellY(grid, lat_e7);
+
+    grid->lat[device] = lat_e7;
+    grid->lon[device] = lon_e7;
+
+    // 1) Common case: still in the same cell, coordinates only
+    if (grid->present[device] && grid->cx[device] == cx && grid->cy[device] == cy)
+        return 1;
+
+    // 2) Moved to another cell (or new): relink
+    if (grid->present[device])
+        gridUnlink(grid, device);
+    grid->cx[device] = cx;
+    grid->cy[device] = cy;
+    gridLink(grid, device);
+    grid->present[device] = 1;
+    return 1;
+}
+
+
+void gridRemove(BN220_Grid *grid, uint32_t device) {
+    if (device >= grid->maxDevices || !grid->present[device])
+        return;
+    gridUnlink(grid, device);
+    grid->present[device] = 0;
+}
+
+
+// Bounded max-heap on squared distance; the root is the current k-th best
+typedef struct {
+    uint32_t *dev;
+    float    *d2;
+    size_t    n, k;
+} GridHeap;
+
+static void gridHeapSift(GridHeap *h, size_t i) {
+    for (;;) {
+        size_t l = 2 * i + 1, r = l + 1, m = i;
+        if (l < h->n && h->d2[l] > h->d2[m]) m = l;
+        if (r < h->n && h->d2[r] > h->d2[m]) m = r;
+        if (m == i)
+            return;
+        float    td = h->d2[i];  h->d2[i]  = h->d2[m];  h->d2[m]  = td;
+        uint32_t tv = h->dev[i]; h->dev[i] = h->dev[m]; h->dev[m] = tv;
+        i = m;
+    }
+}
+
+static void gridHeapPush(GridHeap *h, uint32_t dev, float d2) {
+    if (h->n < h->k) {
+        size_t i = h->n++;
+        while (i > 0 && h->d2[(i - 1) / 2] < d2) {
+            h->d2[i]  = h->d2[(i - 1) / 2];
+            h->dev[i] = h->dev[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        h->d2[i]  = d2;
+        h->dev[i] = dev;
+    } else if (d2 < h->d2[0]) {
+        h->d2[0]  = d2;
+        h->dev[0] = dev;
+        gridHeapSift(h, 0);
+    }
+}
+
+
+size_t gridNearest(const BN220_Grid *grid, int32_t lat_e7, int32_t lon_e7, size_t k,
+                   float maxDist_m, uint32_t *device, float *dist_m) {
+    if (!k || !dist_m)
+        return 0;
+
+    float *d2 = dist_m;
+    GridHeap h = { device, d2, 0, k };
+
+    const float my = (float)GRID_M_PER_E7;
+    const float mx = (float)(GRID_M_PER_E7 * cos(lat_e7 * 1e-7 * 3.14159265358979323846 / 180.0));
+    const float maxD2 = maxDist_m * maxDist_m;
+
+    int32_t qcx = gridCellX(grid, lon_e7);
+    int32_t qcy = gridCellY(grid, lat_e7);
+
+    // Offsets of the query inside its own cell, for the ring distance bound
+    float fx = (float)(((int64_t)lon_e7 + GRID_LON_SPAN / 2) % grid->cell);
+    float fy = (float)(((int64_t)lat_e7 + GRID_LAT_SPAN / 2) % grid->cell);
+    int32_t maxRing = grid->ncx / 2 > grid->ncy ? grid->ncx / 2 : grid->ncy;
+
+    // A cell is my/mx times narrower in metres east-west than north-south,
+    // so ring r spans rx(r) = r*my/mx columns each side (the whole circle
+    // near the poles) and the bound grows at the same rate along both axes
+    const double  aspect = mx > 0.0f ? (double)my / mx : (double)maxRing;
+    const int32_t rxMax  = grid->ncx / 2;
+    int32_t rxPrev = 0;
+
+    for (int32_t r = 0; r <= maxRing; r++) {
+        double  rxd = ceil(r * aspect);
+        int32_t rx  = rxd < rxMax ? (int32_t)rxd : rxMax;
+
+        // 1) Nothing outside the rings walked so far can beat the k-th best
+        if (r > 0) {
+            float by = fminf(fy, (float)grid->cell - fy) + (float)(r - 1) * (float)grid->cell;
+            float b  = by * my;
+            if (2 * rxPrev + 1 < grid->ncx) {
+                float bx = fminf(fx, (float)grid->cell - fx) + (float)rxPrev * (float)grid->cell;
+                b = fminf(b, bx * mx);
+            }
+            if (b * b > maxD2 || (h.n == k && b * b >= h.d2[0]))
+                break;
+        }
+
+        // 2) Visit the new cells: rows +-r across the full width, and the
+        //    columns rxPrev < |i| <= rx of the rows inside
+        for (int32_t j = -r; j <= r; j++) {
+            int32_t cy = qcy + j;
+            if (cy < 0 || cy >= grid->ncy)
+                continue;
+            int32_t edge = (j == -r || j == r);
+            for (int32_t i = -rx; i <= rx; i++) {
+                if (!edge && i == -rxPrev)
+                    i = rxPrev + 1;
+                if (i > rx)
+                    break;
+                if (i > 0 && i >= grid->ncx - rx)
+                    continue;       // wrapped onto column -i, visited already
+                int32_t  cx = gridWrapX(grid, qcx + i);
+                uint32_t d  = grid->head[gridBucket(grid, cx, cy)];
+
+                for (; d != GRID_NONE; d = grid->next[d]) {
+                    if (grid->cx[d] != cx || grid->cy[d] != cy)
+                        continue;   // another cell sharing the bucket
+                    int64_t dlon = (int64_t)grid->lon[d] - lon_e7;
+                    if (dlon >  GRID_LON_SPAN / 2) dlon -= GRID_LON_SPAN;
+                    if (dlon < -GRID_LON_SPAN / 2) dlon += GRID_LON_SPAN;
+                    float dx = (float)dlon * mx;
+                    float dy = (float)(grid->lat[d] - lat_e7) * my;
+                    float dd = dx * dx + dy * dy;
+                    if (dd <= maxD2)
+                        gridHeapPush(&h, d, dd);
+                }
+            }
+        }
+        rxPrev = rx;
+    }
+
+    // 3) Heap to ascending order
+    size_t found = h.n;
+    while (h.n > 1) {
+        size_t last = --h.n;
+        float    td = d2[0];     d2[0]     = d2[last];     d2[last]     = td;
+        uint32_t tv = device[0]; device[0] = device[last]; device[last] = tv;
+        gridHeapSift(&h, 0);
+    }
+    for (size_t i = 0; i < found; i++)
+        dist_m[i] = sqrtf(dist_m[i]);
+    return found;
+}
@@ -0,0 +1,98 @@
+/*
+ * BN220_knn.h — Live k-nearest-devices index
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_knn.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Incrementally maintained spatial-hash grid over device positions
+ *          with ring-expanding k-nearest-neighbour queries.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_KNN_H_
+#define INC_BN220_KNN_H_
+
+#include "BN220.h"
+
+/*
+ * Spatial index over the latest position of every device (host side).
+ *
+ * Positions are bucketed into square cells of cell_e7 x cell_e7 (1e-7
+ * degree units); non-empty cells are found through a spatial hash, and every
+ * bucket holds an intrusive doubly linked list of devices.  An update that
+ * stays inside its cell only rewrites the coordinates; crossing a cell
+ * boundary is an O(1) unlink/link.  Queries walk rings of cells outwards
+ * until no unvisited cell can hold a closer device.
+ *
+ * Devices are addressed by a dense index 0..maxDevices-1 assigned by the
+ * caller.  The index is not thread-safe: serialise updates and queries, or
+ * keep one index per shard.
+ */
+typedef struct BN220_Grid BN220_Grid;
+
+/**
+ * @brief  Create an index.
+ *
+ * @param[in] maxDevices  Number of device indices.
+ * @param[in] cell_e7     Cell size in 1e-7 degrees (e.g. 50000 = 0.005°,
+ *                        about 550 m); pick roughly the typical k-NN radius.
+ * @param[in] buckets     Spatial hash buckets, rounded up to a power of two;
+ *                        about the number of occupied cells.
+ */
+BN220_Grid *gridCreate(uint32_t maxDevices, int32_t cell_e7, uint32_t buckets);
+
+void gridDestroy(BN220_Grid *grid);
+
+/**
+ * @brief  Set the position of @p device (inserting it if needed).
+ *
+ * Returns 0 when @p device is out of range.
+ */
+int gridUpdate(BN220_Grid *grid, uint32_t device, int32_t lat_e7, int32_t lon_e7);
+
+/**
+ * @brief  Remove @p device from the index.
+ */
+void gridRemove(BN220_Grid *grid, uint32_t device);
+
+/**
+ * @brief  The @p k devices closest to a point.
+ *
+ * @param[in]  grid       Index.
+ * @param[in]  lat_e7     Query latitude.
+ * @param[in]  lon_e7     Query longitude.
+ * @param[in]  k          Number of neighbours wanted.
+ * @param[in]  maxDist_m  Search radius in metres; bounds the work on sparse data.
+ * @param[out] device     k device indices, nearest first.
+ * @param[out] dist_m     k distances in metres (equirectangular); also the
+ *                        working storage of the query, so it is required.
+ *
+ * Rings are widened east-west by 1/cos(lat), up to the whole circle near
+ * the poles, so the searched radius grows evenly in metres on both axes.
+ * Returns the number of devices found (at most @p k).
+ */
+size_t gridNearest(const BN220_Grid *grid, int32_t lat_e7, int32_t lon_e7, size_t k,
+                   float maxDist_m, uint32_t *device, float *dist_m);
+
+#endif /* INC_BN220_KNN_H_ */
@@ -0,0 +1,345 @@
+/*
+ * BN220_merge.c — Time-ordered merge of device logs
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_merge.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Loser tree, pread-based log file sources and quantile-split
+ *          parallel driver.
+ * ---------------------------------------------------------------------------
+ */
+
+#define _FILE_OFFSET_BITS 64
+#define _POSIX_C_SOURCE  200809L   // pread
+
+#include "BN220_merge.h"
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <pthread.h>
+
+#define MERGE_SAMPLES   64          // utc_ms samples per file for range splits
+#define MERGE_REC       ((off_t)sizeof(BN220_LogRecord))
+#define MERGE_UTC_AT(i) ((off_t)(i) * MERGE_REC + (off_t)offsetof(BN220_LogRecord, fix.utc_ms))
+
+typedef struct {
+    BN220_LogSource  src;
+    BN220_LogRecord *buf;
+    size_t           pos, len;
+    int              done;
+} MergeInput;
+
+
+// Order of two inputs by head timestamp; exhausted inputs sort last
+static inline int mergeLess(const MergeInput *in, uint32_t a, uint32_t b) {
+    if (in[a].done || in[b].done)
+        return !in[a].done || (in[b].done && a < b);
+    int64_t ta = in[a].buf[in[a].pos].fix.utc_ms;
+    int64_t tb = in[b].buf[in[b].pos].fix.utc_ms;
+    return ta < tb || (ta == tb && a < b);
+}
+
+static void mergeRefill(MergeInput *m, size_t cap) {
+    m->pos = 0;
+    m->len = m->src.read(m->src.user, m->buf, cap);
+    m->done = m->len == 0;
+}
+
+
+int mergeRun(const BN220_LogSource *src, size_t n, int64_t t0, int64_t t1, size_t bufRecords,
+             BN220_LogSink sink, void *user, uint64_t *merged) {
+    uint64_t count = 0;
+    if (merged)
+        *merged = 0;
+    if (!n)
+        return 1;
+    if (!bufRecords)
+        bufRecords = 1;
+
+    MergeInput      *in    = calloc(n, sizeof(MergeInput));
+    uint32_t        *loser = malloc(sizeof(uint32_t) * n);
+    BN220_LogRecord *out   = malloc(sizeof(BN220_LogRecord) * bufRecords * (n + 1));
+    int ok = in && loser && out;
+
+    // 1) Fill every input buffer
+    for (size_t i = 0; ok && i < n; i++) {
+        in[i].src = src[i];
+        in[i].buf = out + bufRecords * (i + 1);
+        mergeRefill(&in[i], bufRecords);
+    }
+
+    // 2) Build the loser tree bottom-up: leaves are nodes n..2n-1, inner
+    //    nodes 1..n-1 keep the loser of their match, the winner moves up
+    uint32_t  winner = 0;
+    uint32_t *up = ok ? malloc(sizeof(uint32_t) * 2 * n) : NULL;
+    ok = ok && up;
+    if (ok) {
+        for (size_t i = 0; i < n; i++)
+            up[n + i] = (uint32_t)i;
+        for (size_t node = n - 1; node >= 1; node--) {
+            uint32_t l = up[2 * node], r = up[2 * node + 1];
+            int lw = mergeLess(in, l, r);
+            up[node]    = lw ? l : r;
+            loser[node] = lw ? r : l;
+        }
+        winner = n > 1 ? up[1] : 0;
+    }
+    free(up);
+
+    // 3) Pop the winner, advance its input and replay its path to the root
+    size_t outLen = 0;
+    while (ok && !in[winner].done) {
+        MergeInput *m = &in[winner];
+        const BN220_LogRecord *r = &m->buf[m->pos];
+        if (r->fix.utc_ms >= t1)
+            break;          // every head is at or past the end of the range
+
+        if (r->fix.utc_ms >= t0) {
+            out[outLen++] = *r;
+            if (outLen == bufRecords) {
+                ok = sink(user, out, outLen);
+                count += outLen;
+                outLen = 0;
+            }
+        }
+        if (++m->pos == m->len)
+            mergeRefill(m, bufRecords);
+
+        uint32_t w = winner;
+        for (size_t node = (n + w) / 2; node >= 1; node /= 2) {
+            if (mergeLess(in, loser[node], w)) {
+                uint32_t t = loser[node];
+                loser[node] = w;
+                w = t;
+            }
+        }
+        winner = w;
+    }
+
+    // 4) Tail of the output buffer
+    if (ok && outLen) {
+        ok = sink(user, out, outLen);
+        count += outLen;
+    }
+
+    if (merged)
+        *merged = count;
+    free(in);
+    free(loser);
+    free(out);
+    return ok;
+}
+
+
+/* --- Log files ------------------------------------------------------------ */
+
+typedef struct {
+    int      fd;
+    int      ownFd;
+    uint64_t next, count;  // record indices
+} MergeFile;
+
+static size_t mergeFileRead(void *user, BN220_LogRecord *buf, size_t max) {
+    MergeFile *f = user;
+    if (f->next >= f->count)
+        return 0;
+    if (max > f->count - f->next)
+        max = (size_t)(f->count - f->next);
+
+    ssize_t got = pread(f->fd, buf, max * sizeof(BN220_LogRecord), (off_t)f->next * MERGE_REC);
+    if (got <= 0)
+        return 0;
+    size_t recs = (size_t)got / sizeof(BN220_LogRecord);
+    f->next += recs;
+    return recs;
+}
+
+static int64_t mergeFileUtc(int fd, uint64_t i) {
+    int64_t t = INT64_MAX;
+    if (pread(fd, &t, sizeof(t), MERGE_UTC_AT(i)) != (ssize_t)sizeof(t))
+        return INT64_MAX;
+    return t;
+}
+
+// First record with utc_ms >= t0
+static uint64_t mergeFileSeek(int fd, uint64_t count, int64_t t0) {
+    uint64_t lo = 0, hi = count;
+    if (t0 == INT64_MIN)
+        return 0;
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (mergeFileUtc(fd, mid) < t0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+static uint64_t mergeFileCount(int fd) {
+    struct stat st;
+    return fstat(fd, &st) == 0 ? (uint64_t)st.st_size / (uint64_t)MERGE_REC : 0;
+}
+
+static int mergeFileAttach(BN220_LogSource *src, int fd, int ownFd, int64_t t0) {
+    MergeFile *f = malloc(sizeof(*f));
+    if (!f)
+        return 0;
+    f->fd    = fd;
+    f->ownFd = ownFd;
+    f->count = mergeFileCount(fd);
+    f->next  = mergeFileSeek(fd, f->count, t0);
+    src->read = mergeFileRead;
+    src->user = f;
+    return 1;
+}
+
+int mergeFileOpen(BN220_LogSource *src, const char *path, int64_t t0) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return 0;
+    if (!mergeFileAttach(src, fd, 1, t0)) {
+        close(fd);
+        return 0;
+    }
+    return 1;
+}
+
+void mergeFileClose(BN220_LogSource *src) {
+    MergeFile *f = src->user;
+    if (!f)
+        return;
+    if (f->ownFd)
+        close(f->fd);
+    free(f);
+    src->user = NULL;
+}
+
+int mergeFileSink(void *user, const BN220_LogRecord *recs, size_t n) {
+    return fwrite(recs, sizeof(*recs), n, (FILE *)user) == n;
+}
+
+
+/* --- Parallel merge by time range ---------------------------------------- */
+
+typedef struct {
+    const int     *fds;
+    size_t         n;
+    int64_t        t0, t1;
+    size_t         bufRecords;
+    BN220_LogSink  sink;
+    void          *user;
+    uint64_t       merged;
+    int            ok;
+} MergePart;
+
+static void *mergePartMain(void *arg) {
+    MergePart       *p   = arg;
+    BN220_LogSource *src = calloc(p->n, sizeof(BN220_LogSource));
+    size_t opened = 0;
+
+    // Descriptors are shared between parts; pread keeps the cursors private
+    p->ok = src != NULL;
+    for (; p->ok && opened < p->n; opened++)
+        p->ok = mergeFileAttach(&src[opened], p->fds[opened], 0, p->t0);
+    if (p->ok)
+        p->ok = mergeRun(src, p->n, p->t0, p->t1, p->bufRecords, p->sink, p->user, &p->merged);
+
+    for (size_t i = 0; src && i < opened; i++)
+        mergeFileClose(&src[i]);
+    free(src);
+    return NULL;
+}
+
+static int mergeCmpI64(const void *a, const void *b) {
+    int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+int mergeFilesParallel(const char *const *paths, size_t n, unsigned parts, size_t bufRecords,
+                       BN220_LogSink sink, void *const *sinkUser, uint64_t *merged) {
+    if (!parts)
+        parts = 1;
+
+    int       *fds     = malloc(sizeof(int) * (n ? n : 1));
+    int64_t   *samples = malloc(sizeof(int64_t) * MERGE_SAMPLES * (n ? n : 1));
+    MergePart *part    = calloc(parts, sizeof(MergePart));
+    pthread_t *tid     = calloc(parts, sizeof(pthread_t));
+    size_t opened = 0, ns = 0;
+    int ok = fds && samples && part && tid;
+
+    // 1) Open every file once and sample its timestamps
+    for (; ok && opened < n; opened++) {
+        fds[opened] = open(paths[opened], O_RDONLY);
+        if (fds[opened] < 0) {
+            ok = 0;
+            break;
+        }
+        uint64_t count = mergeFileCount(fds[opened]);
+        for (uint64_t s = 0; count && s < MERGE_SAMPLES; s++)
+            samples[ns++] = mergeFileUtc(fds[opened], s * count / MERGE_SAMPLES);
+    }
+
+    // 2) Range boundaries at sample quantiles, then one thread per range
+    if (ok) {
+        qsort(samples, ns, sizeof(int64_t), mergeCmpI64);
+        for (unsigned i = 0; i < parts; i++) {
+            part[i].fds        = fds;
+            part[i].n          = n;
+            part[i].t0         = i == 0 ? INT64_MIN : (ns ? samples[ns * i / parts] : INT64_MAX);
+            part[i].t1         = i + 1 == parts ? INT64_MAX : (ns ? samples[ns * (i + 1) / parts] : INT64_MAX);
+            part[i].bufRecords = bufRecords;
+            part[i].sink       = sink;
+            part[i].user       = sinkUser[i];
+        }
+        unsigned started = 0;
+        for (; started < parts; started++) {
+            if (pthread_create(&tid[started], NULL, mergePartMain, &part[started]) != 0) {
+                ok = 0;
+                break;
+            }
+        }
+        for (unsigned i = 0; i < started; i++)
+            pthread_join(tid[i], NULL);
+    }
+
+    // 3) Totals
+    uint64_t total = 0;
+    for (unsigned i = 0; part && i < parts; i++) {
+        total += part[i].merged;
+        if (ok && !part[i].ok)
+            ok = 0;
+    }
+    if (merged)
+        *merged = total;
+
+    for (size_t i = 0; i < opened; i++)
+        close(fds[i]);
+    free(fds);
+    free(samples);
+    free(part);
+    free(tid);
+    return ok;
+}
@@ -0,0 +1,102 @@
+/*
+ * BN220_merge.h — Time-ordered merge of device logs
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_merge.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Loser-tree k-way merge of utc_ms-sorted BN220_LogRecord streams,
+ *          file sources and time-range parallel merge.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_MERGE_H_
+#define INC_BN220_MERGE_H_
+
+#include "BN220.h"
+
+/*
+ * Time-ordered k-way merge of per-device fix logs (host side).
+ *
+ * Each input is already sorted by fix.utc_ms; the merge keeps one refill
+ * buffer per input and a loser tree over their heads, so memory is
+ * O(inputs x buffer) whatever the log sizes, and each output record costs
+ * log2(inputs) integer comparisons.  Ties keep input order, so the merge is
+ * stable.  Log files are flat arrays of BN220_LogRecord in host byte order.
+ */
+typedef struct {
+    uint32_t  device;
+    uint32_t  reserved;
+    BN220_Fix fix;
+} BN220_LogRecord;
+
+/* Pull up to max records into buf; 0 at the end of the input. */
+typedef struct {
+    size_t (*read)(void *user, BN220_LogRecord *buf, size_t max);
+    void   *user;
+} BN220_LogSource;
+
+/* Consume n merged records; return 0 to abort the merge. */
+typedef int (*BN220_LogSink)(void *user, const BN220_LogRecord *recs, size_t n);
+
+/**
+ * @brief  Merge @p n sources, emitting records with t0 <= utc_ms < t1.
+ *
+ * @param[in]  src         Sources, each sorted by utc_ms.
+ * @param[in]  n           Number of sources.
+ * @param[in]  t0, t1      Time range; INT64_MIN / INT64_MAX for everything.
+ * @param[in]  bufRecords  Records buffered per source and for the output.
+ * @param[in]  sink        Output.
+ * @param[in]  user        Passed to @p sink.
+ * @param[out] merged      Records emitted; optional.
+ *
+ * Returns 0 when out of memory or when the sink aborted.
+ */
+int mergeRun(const BN220_LogSource *src, size_t n, int64_t t0, int64_t t1, size_t bufRecords,
+             BN220_LogSink sink, void *user, uint64_t *merged);
+
+/**
+ * @brief  Source reading a log file from the first record with utc_ms >= t0.
+ *
+ * The start is found by binary search on the file, so a time-range merge
+ * never reads the records before it.  Returns 0 if the file cannot be opened.
+ */
+int  mergeFileOpen(BN220_LogSource *src, const char *path, int64_t t0);
+void mergeFileClose(BN220_LogSource *src);
+
+/* Sink appending to a FILE* given as user. */
+int mergeFileSink(void *user, const BN220_LogRecord *recs, size_t n);
+
+/**
+ * @brief  Merge log files in @p parts time ranges on parallel threads.
+ *
+ * Range boundaries are quantiles of utc_ms sampled from every file, so the
+ * parts get similar record counts.  Part i goes to sink(sinkUser[i], ...);
+ * the outputs of parts 0..parts-1 concatenated are the global order.
+ *
+ * Returns 0 if a file cannot be opened, a thread fails or a sink aborted.
+ */
+int mergeFilesParallel(const char *const *paths, size_t n, unsigned parts, size_t bufRecords,
+                       BN220_LogSink sink, void *const *sinkUser, uint64_t *merged);
+
+#endif /* INC_BN220_MERGE_H_ */
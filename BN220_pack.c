@@ -0,0 +1,229 @@
+/*
+ * BN220_pack.c — Bit-packed radio frames
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_pack.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Bit stream, quantisation and frame pack/unpack without
+ *          data-dependent branches.
+ * ---------------------------------------------------------------------------
+ */
+
+#include "BN220_pack.h"
+
+#define PACK_DT_BITS    16
+#define PACK_DT_UNIT    100   // ms
+#define PACK_LL_BITS    18
+#define PACK_ALT_BITS   12
+#define PACK_HDOP_BITS  3
+#define PACK_SATS_BITS  4
+#define PACK_UTC_BITS   47
+#define PACK_KALT_BITS  16
+
+// Upper edges of the hdop buckets, hdop x 100
+static const uint16_t packHdopEdge[8] = { 100, 150, 200, 300, 500, 800, 1500, 9999 };
+
+
+/* --- Bit stream ----------------------------------------------------------- */
+
+// OR the low @p bits of v into buf at bit position *pos, MSB first.  The
+// loop count depends only on the position, never on the value.
+static void packPut(uint8_t *buf, size_t *pos, uint64_t v, unsigned bits) {
+    while (bits) {
+        unsigned room = 8u - (unsigned)(*pos & 7);
+        unsigned take = bits < room ? bits : room;
+        uint8_t  chunk = (uint8_t)((v >> (bits - take)) & ((1u << take) - 1u));
+        buf[*pos >> 3] |= (uint8_t)(chunk << (room - take));
+        *pos += take;
+        bits -= take;
+    }
+}
+
+static uint64_t packGet(const uint8_t *buf, size_t *pos, unsigned bits) {
+    uint64_t v = 0;
+    while (bits) {
+        unsigned room = 8u - (unsigned)(*pos & 7);
+        unsigned take = bits < room ? bits : room;
+        v = (v << take) | ((buf[*pos >> 3] >> (room - take)) & ((1u << take) - 1u));
+        *pos += take;
+        bits -= take;
+    }
+    return v;
+}
+
+static inline int64_t packSignExtend(uint64_t v, unsigned bits) {
+    return (int64_t)(v << (64 - bits)) >> (64 - bits);
+}
+
+static inline uint64_t packMask(int64_t v, unsigned bits) {
+    return (uint64_t)v & ((1ull << bits) - 1u);
+}
+
+
+/* --- Quantisation --------------------------------------------------------- */
+
+// Round-to-nearest division that is also correct for negative numerators
+static inline int64_t packRoundDiv(int64_t a, int64_t b) {
+    int64_t s = a + b / 2;
+    int64_t r = ((s % b) + b) % b;
+    return (s - r) / b;
+}
+
+static inline int64_t packClamp(int64_t v, int64_t lo, int64_t hi) {
+    v = v < lo ? lo : v;
+    return v > hi ? hi : v;
+}
+
+static inline uint32_t packHdopBucket(uint16_t hdop_c) {
+    uint32_t b = 0;
+    for (unsigned i = 0; i < 7; i++)
+        b += hdop_c > packHdopEdge[i];
+    return b;
+}
+
+static inline uint32_t packSats(uint8_t sats) {
+    return sats > 15 ? 15u : sats;
+}
+
+typedef struct {
+    int64_t dt, dlat, dlon, dalt;
+} PackDelta;
+
+static PackDelta packDelta(const BN220_Fix *ref, const BN220_Fix *fix) {
+    PackDelta d;
+    d.dt   = packRoundDiv(fix->utc_ms - ref->utc_ms, PACK_DT_UNIT);
+    d.dlat = packRoundDiv((int64_t)fix->lat_e7 - ref->lat_e7, BN220_PACK_QUANT_E7);
+    d.dlon = (int64_t)fix->lon_e7 - ref->lon_e7;
+    d.dlon += (d.dlon < -1800000000LL) * 3600000000LL - (d.dlon > 1800000000LL) * 3600000000LL;
+    d.dlon = packRoundDiv(d.dlon, BN220_PACK_QUANT_E7);
+    d.dalt = packRoundDiv(fix->alt_mm, 1000) - packRoundDiv(ref->alt_mm, 1000);
+    return d;
+}
+
+
+int packFits(const BN220_Fix *ref, const BN220_Fix *fix) {
+    PackDelta d = packDelta(ref, fix);
+    const int64_t ll = 1LL << (PACK_LL_BITS - 1), alt = 1LL << (PACK_ALT_BITS - 1);
+    return (d.dt >= 0) & (d.dt < (1LL << PACK_DT_BITS)) &
+           (d.dlat >= -ll) & (d.dlat < ll) & (d.dlon >= -ll) & (d.dlon < ll) &
+           (d.dalt >= -alt) & (d.dalt < alt);
+}
+
+
+size_t packDeltas(const BN220_Fix *ref, uint8_t refId, const BN220_Fix *fixes, size_t n,
+                  uint8_t *out, size_t cap, size_t *packed) {
+    size_t fit = cap > BN220_PACK_HEADER ? BN220_PACK_CAPACITY(cap) : 0;
+    if (fit > n)
+        fit = n;
+    if (fit > 0x7F)
+        fit = 0x7F;
+    if (packed)
+        *packed = fit;
+    if (!fit)
+        return 0;
+
+    size_t bytes = BN220_PACK_HEADER + (fit * BN220_PACK_DELTA_BITS + 7) / 8;
+    memset(out, 0, bytes);
+    out[0] = (uint8_t)fit;
+    out[1] = refId;
+
+    const int64_t ll = 1LL << (PACK_LL_BITS - 1), alt = 1LL << (PACK_ALT_BITS - 1);
+    size_t pos = BN220_PACK_HEADER * 8;
+    for (size_t i = 0; i < fit; i++) {
+        // Out-of-range deltas saturate; packFits() tells callers beforehand
+        PackDelta d = packDelta(ref, &fixes[i]);
+        packPut(out, &pos, (uint64_t)packClamp(d.dt, 0, (1LL << PACK_DT_BITS) - 1), PACK_DT_BITS);
+        packPut(out, &pos, packMask(packClamp(d.dlat, -ll, ll - 1), PACK_LL_BITS), PACK_LL_BITS);
+        packPut(out, &pos, packMask(packClamp(d.dlon, -ll, ll - 1), PACK_LL_BITS), PACK_LL_BITS);
+        packPut(out, &pos, packMask(packClamp(d.dalt, -alt, alt - 1), PACK_ALT_BITS), PACK_ALT_BITS);
+        packPut(out, &pos, packHdopBucket(fixes[i].hdop_c), PACK_HDOP_BITS);
+        packPut(out, &pos, packSats(fixes[i].sats), PACK_SATS_BITS);
+    }
+    return bytes;
+}
+
+
+size_t packKey(const BN220_Fix *fix, uint8_t keyId, uint8_t *out, size_t cap) {
+    size_t bytes = BN220_PACK_HEADER + (BN220_PACK_KEY_BITS + 7) / 8;
+    if (cap < bytes)
+        return 0;
+
+    memset(out, 0, bytes);
+    out[0] = 0x80 | 1;
+    out[1] = keyId;
+
+    size_t pos = BN220_PACK_HEADER * 8;
+    int64_t altM = packClamp(packRoundDiv(fix->alt_mm, 1000), INT16_MIN, INT16_MAX);
+    packPut(out, &pos, packMask(fix->utc_ms, PACK_UTC_BITS), PACK_UTC_BITS);
+    packPut(out, &pos, (uint32_t)fix->lat_e7, 32);
+    packPut(out, &pos, (uint32_t)fix->lon_e7, 32);
+    packPut(out, &pos, packMask(altM, PACK_KALT_BITS), PACK_KALT_BITS);
+    packPut(out, &pos, packHdopBucket(fix->hdop_c), PACK_HDOP_BITS);
+    packPut(out, &pos, packSats(fix->sats), PACK_SATS_BITS);
+    return bytes;
+}
+
+
+size_t packDecode(const BN220_Fix *ref, const uint8_t *in, size_t len, BN220_Fix *out, size_t max,
+                  uint8_t *id) {
+    if (len < BN220_PACK_HEADER)
+        return 0;
+
+    int    key   = packIsKey(in);
+    size_t count = in[0] & 0x7F;
+    size_t bits  = key ? BN220_PACK_KEY_BITS : BN220_PACK_DELTA_BITS;
+    if (len < BN220_PACK_HEADER + (count * bits + 7) / 8 || count > max)
+        return 0;
+    if (id)
+        *id = in[1];
+
+    size_t pos = BN220_PACK_HEADER * 8;
+    for (size_t i = 0; i < count; i++) {
+        BN220_Fix *f = &out[i];
+        memset(f, 0, sizeof(*f));
+        f->fix = 1;
+
+        if (key) {
+            f->utc_ms = (int64_t)packGet(in, &pos, PACK_UTC_BITS);
+            f->lat_e7 = (int32_t)(uint32_t)packGet(in, &pos, 32);
+            f->lon_e7 = (int32_t)(uint32_t)packGet(in, &pos, 32);
+            f->alt_mm = (int32_t)packSignExtend(packGet(in, &pos, PACK_KALT_BITS), PACK_KALT_BITS) * 1000;
+        } else {
+            int64_t dt   = (int64_t)packGet(in, &pos, PACK_DT_BITS);
+            int64_t dlat = packSignExtend(packGet(in, &pos, PACK_LL_BITS), PACK_LL_BITS);
+            int64_t dlon = packSignExtend(packGet(in, &pos, PACK_LL_BITS), PACK_LL_BITS);
+            int64_t dalt = packSignExtend(packGet(in, &pos, PACK_ALT_BITS), PACK_ALT_BITS);
+            int64_t lon  = ref->lon_e7 + dlon * BN220_PACK_QUANT_E7;
+            lon += (lon < -1800000000LL) * 3600000000LL - (lon >= 1800000000LL) * 3600000000LL;
+
+            f->utc_ms = ref->utc_ms + dt * PACK_DT_UNIT;
+            f->lat_e7 = (int32_t)(ref->lat_e7 + dlat * BN220_PACK_QUANT_E7);
+            f->lon_e7 = (int32_t)lon;
+            f->alt_mm = (int32_t)((packRoundDiv(ref->alt_mm, 1000) + dalt) * 1000);
+        }
+        f->hdop_c = packHdopEdge[packGet(in, &pos, PACK_HDOP_BITS)];
+        f->sats   = (uint8_t)packGet(in, &pos, PACK_SATS_BITS);
+    }
+    return count;
+}
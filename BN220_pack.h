@@ -0,0 +1,120 @@
+/*
+ * BN220_pack.h — Bit-packed radio frames
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_pack.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Fixed-width delta and key records for low-bandwidth uplinks (5
+ *          fixes in a 50-byte LoRa payload).
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_PACK_H_
+#define INC_BN220_PACK_H_
+
+#include "BN220.h"
+
+/*
+ * Bit-packed fix frames for narrow radio links (LoRa and similar).
+ *
+ * Fixes are sent relative to the last fix the ground side acknowledged (the
+ * reference), quantised and stored in fixed-width bit fields.  Each field
+ * width is constant, so packing and unpacking run the same instructions for
+ * every fix: no data-dependent branches on either side.
+ *
+ * Frame:   byte 0  type (bit 7: 1 = key frame) | record count (bits 0..6)
+ *          byte 1  reference id (delta frame) or id of this key (key frame)
+ *          records, MSB first, padded to a byte
+ *
+ * Delta record (71 bits): dt 16 (100 ms) | dlat 18 | dlon 18 (1e-5°, about
+ * 1.1 m, ±145 km) | dalt 12 (m) | hdop bucket 3 | sats 4.
+ * Key record (134 bits): utc 47 (ms) | lat 32 | lon 32 (1e-7°) | alt 16 (m)
+ * | hdop bucket 3 | sats 4.
+ *
+ * Altitude deltas are taken between whole metres, so the sender may keep
+ * its own full-precision fix as the reference after a key frame is acked.
+ */
+
+#define BN220_PACK_HEADER      2
+#define BN220_PACK_DELTA_BITS  71
+#define BN220_PACK_KEY_BITS    134
+#define BN220_PACK_QUANT_E7    100   // delta lat/lon step in 1e-7 degrees
+
+/* Delta records that fit a payload of @p bytes (5 in 50 bytes). */
+#define BN220_PACK_CAPACITY(bytes) ((((bytes) - BN220_PACK_HEADER) * 8) / BN220_PACK_DELTA_BITS)
+
+/**
+ * @brief  1 if @p fix can be sent as a delta from @p ref, 0 if a key
+ *         frame is needed (too far, too late or too high).
+ */
+int packFits(const BN220_Fix *ref, const BN220_Fix *fix);
+
+/**
+ * @brief  Pack up to @p n fixes as delta records against @p ref.
+ *
+ * @param[in]  ref     Last acknowledged fix.
+ * @param[in]  refId   Id the receiver knows @p ref under.
+ * @param[in]  fixes   Fixes to send; all must pass packFits().
+ * @param[in]  n       Number of fixes.
+ * @param[out] out     Frame buffer.
+ * @param[in]  cap     Payload size available.
+ * @param[out] packed  Fixes that fitted into @p cap; optional.
+ *
+ * Returns the frame length in bytes (0 if not even one record fits).
+ */
+size_t packDeltas(const BN220_Fix *ref, uint8_t refId, const BN220_Fix *fixes, size_t n,
+                  uint8_t *out, size_t cap, size_t *packed);
+
+/**
+ * @brief  Pack one fix as a key frame (a new reference once acknowledged).
+ *
+ * Returns the frame length in bytes, or 0 if @p cap is too small.
+ */
+size_t packKey(const BN220_Fix *fix, uint8_t keyId, uint8_t *out, size_t cap);
+
+/**
+ * @brief  Decode a frame.
+ *
+ * @param[in]  ref    Reference fix matching the frame's reference id
+ *                    (ignored for key frames).
+ * @param[in]  in     Frame.
+ * @param[in]  len    Frame length.
+ * @param[out] out    Decoded fixes.
+ * @param[in]  max    Capacity of @p out.
+ * @param[out] id     Reference id (delta) or key id (key frame); optional.
+ *
+ * Returns the number of fixes, 0 for a truncated frame.  Decoded hdop is
+ * the upper edge of its bucket and speed is not carried.
+ */
+size_t packDecode(const BN220_Fix *ref, const uint8_t *in, size_t len, BN220_Fix *out, size_t max,
+                  uint8_t *id);
+
+/**
+ * @brief  1 if the frame is a key frame.
+ */
+static inline int packIsKey(const uint8_t *frame) {
+    return (frame[0] & 0x80) != 0;
+}
+
+#endif /* INC_BN220_PACK_H_ */
@@ -0,0 +1,647 @@
+/*
+ * BN220_parquet.c — Parquet writer
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_parquet.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Thrift compact footer, DELTA_BINARY_PACKED and RLE_DICTIONARY
+ *          column chunks.
+ * ---------------------------------------------------------------------------
+ */
+
+#define _FILE_OFFSET_BITS 64   // files past 2 GiB on 32-bit hosts
+
+#include "BN220_parquet.h"
+#include <stdio.h>
+
+#define PQ_PAGE_ROWS  65536   // values per data page
+#define PQ_DICT_MAX   65536   // larger dictionaries fall back to delta
+#define PQ_DELTA_BLOCK 128
+#define PQ_DELTA_MINI  4      // miniblocks per block, 32 values each
+
+// parquet.thrift enums
+enum { PQ_INT32 = 1, PQ_INT64 = 2 };
+enum { PQ_CT_NONE = -1, PQ_CT_TIMESTAMP_MILLIS = 9, PQ_CT_UINT_8 = 11, PQ_CT_UINT_16 = 12,
+       PQ_CT_UINT_32 = 13 };
+enum { PQ_ENC_PLAIN = 0, PQ_ENC_RLE = 3, PQ_ENC_DELTA = 5, PQ_ENC_RLE_DICT = 8 };
+enum { PQ_PAGE_DATA = 0, PQ_PAGE_DICT = 2 };
+
+// Thrift compact protocol types
+enum { TC_TRUE = 1, TC_I32 = 5, TC_I64 = 6, TC_BINARY = 8, TC_LIST = 9, TC_STRUCT = 12 };
+
+typedef struct {
+    const char *name;
+    uint8_t     physical;
+    int8_t      converted;
+    uint8_t     dict;        // try dictionary encoding
+    uint8_t     isUnsigned;  // statistics order
+} PqColumn;
+
+static const PqColumn pqColumns[] = {
+    { "device",    PQ_INT32, PQ_CT_UINT_32,          1, 1 },
+    { "utc_ms",    PQ_INT64, PQ_CT_TIMESTAMP_MILLIS, 0, 0 },
+    { "lat_e7",    PQ_INT32, PQ_CT_NONE,             0, 0 },
+    { "lon_e7",    PQ_INT32, PQ_CT_NONE,             0, 0 },
+    { "alt_mm",    PQ_INT32, PQ_CT_NONE,             0, 0 },
+    { "speed_cms", PQ_INT32, PQ_CT_UINT_16,          0, 1 },
+    { "hdop_c",    PQ_INT32, PQ_CT_UINT_16,          1, 1 },
+    { "sats",      PQ_INT32, PQ_CT_UINT_8,           1, 1 },
+    { "fix",       PQ_INT32, PQ_CT_UINT_8,           1, 1 },
+};
+#define PQ_COLUMNS (sizeof(pqColumns) / sizeof(pqColumns[0]))
+
+// What the footer needs to know about a written column chunk
+typedef struct {
+    int64_t  values;
+    int64_t  size;
+    int64_t  dataOffset;
+    int64_t  dictOffset;   // -1 without a dictionary
+    int64_t  min, max;
+    uint8_t  encoding;     // PQ_ENC_DELTA or PQ_ENC_RLE_DICT
+} PqChunk;
+
+typedef struct {
+    PqChunk  chunk[PQ_COLUMNS];
+    int64_t  rows;
+    int64_t  bytes;
+} PqRowGroup;
+
+// Growable byte buffer; oom sticks until the buffer is freed
+typedef struct {
+    uint8_t *p;
+    size_t   len, cap;
+    int      oom;
+    int16_t  lastId[8];    // thrift field ids, one per struct nesting level
+    int      depth;
+} PqBuf;
+
+struct BN220_Parquet {
+    FILE       *fp;
+    int64_t     offset;
+    int         ok;
+    uint32_t    groupRows;
+    uint32_t    rows;              // buffered rows
+    int64_t    *col[PQ_COLUMNS];   // buffered values, sign-extended
+    PqRowGroup *groups;
+    size_t      ngroups, capGroups;
+    int64_t     totalRows;
+    PqBuf       page, header;
+    uint64_t   *scratch;           // unsigned deltas / dictionary indices
+    int64_t    *dictVals;
+    uint32_t   *dictIdx;
+    uint64_t   *dictKeys;          // hash: value + 1, 0 = empty
+    uint32_t   *dictSlot;
+};
+
+
+/* --- Byte buffer and thrift compact protocol ------------------------------ */
+
+static void pqReserve(PqBuf *b, size_t extra) {
+    if (b->oom || b->len + extra <= b->cap)
+        return;
+    size_t   cap = b->cap ? b->cap : 4096;
+    while (cap < b->len + extra)
+        cap *= 2;
+    uint8_t *p = realloc(b->p, cap);
+    if (!p) {
+        b->oom = 1;
+        return;
+    }
+    b->p   = p;
+    b->cap = cap;
+}
+
+static void pqByte(PqBuf *b, uint8_t v) {
+    pqReserve(b, 1);
+    if (!b->oom)
+        b->p[b->len++] = v;
+}
+
+static void pqBytes(PqBuf *b, const void *src, size_t n) {
+    pqReserve(b, n);
+    if (!b->oom) {
+        memcpy(b->p + b->len, src, n);
+        b->len += n;
+    }
+}
+
+static void pqVarint(PqBuf *b, uint64_t v) {
+    while (v > 0x7F) {
+        pqByte(b, (uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    pqByte(b, (uint8_t)v);
+}
+
+static inline uint64_t pqZigzag(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static void pqLE(PqBuf *b, uint64_t v, unsigned bytes) {
+    for (unsigned i = 0; i < bytes; i++)
+        pqByte(b, (uint8_t)(v >> (8 * i)));
+}
+
+static void tcField(PqBuf *b, int16_t id, uint8_t type) {
+    int16_t delta = (int16_t)(id - b->lastId[b->depth]);
+    if (delta > 0 && delta <= 15) {
+        pqByte(b, (uint8_t)((delta << 4) | type));
+    } else {
+        pqByte(b, type);
+        pqVarint(b, pqZigzag(id));
+    }
+    b->lastId[b->depth] = id;
+}
+
+static void tcI32(PqBuf *b, int16_t id, int32_t v) {
+    tcField(b, id, TC_I32);
+    pqVarint(b, pqZigzag(v));
+}
+
+static void tcI64(PqBuf *b, int16_t id, int64_t v) {
+    tcField(b, id, TC_I64);
+    pqVarint(b, pqZigzag(v));
+}
+
+static void tcBinary(PqBuf *b, int16_t id, const void *p, size_t n) {
+    tcField(b, id, TC_BINARY);
+    pqVarint(b, n);
+    pqBytes(b, p, n);
+}
+
+static void tcString(PqBuf *b, int16_t id, const char *s) {
+    tcBinary(b, id, s, strlen(s));
+}
+
+static void tcListHeader(PqBuf *b, uint8_t elemType, size_t n) {
+    if (n < 15) {
+        pqByte(b, (uint8_t)((n << 4) | elemType));
+    } else {
+        pqByte(b, (uint8_t)(0xF0 | elemType));
+        pqVarint(b, n);
+    }
+}
+
+static void tcList(PqBuf *b, int16_t id, uint8_t elemType, size_t n) {
+    tcField(b, id, TC_LIST);
+    tcListHeader(b, elemType, n);
+}
+
+// Struct value: as a field (id > 0) or as a list element (id 0)
+static void tcBegin(PqBuf *b, int16_t id) {
+    if (id)
+        tcField(b, id, TC_STRUCT);
+    b->lastId[++b->depth] = 0;
+}
+
+static void tcEnd(PqBuf *b) {
+    pqByte(b, 0);   // stop field
+    b->depth--;
+}
+
+
+/* --- Encodings ------------------------------------------------------------ */
+
+// LSB-first bit packing of n values of width w (n * w is a multiple of 8)
+static void pqPackBits(PqBuf *b, const uint64_t *v, size_t n, unsigned w) {
+    uint64_t acc = 0;
+    unsigned bits = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t x = v[i];
+        for (unsigned left = w; left;) {
+            unsigned take = left < 32 ? left : 32;
+            acc  |= (x & ((1ull << take) - 1)) << bits;
+            bits += take;
+            x   >>= take;
+            left -= take;
+            while (bits >= 8) {
+                pqByte(b, (uint8_t)acc);
+                acc >>= 8;
+                bits -= 8;
+            }
+        }
+    }
+    if (bits)
+        pqByte(b, (uint8_t)acc);
+}
+
+static unsigned pqWidth(uint64_t v) {
+    unsigned w = 0;
+    while (v) {
+        w++;
+        v >>= 1;
+    }
+    return w;
+}
+
+// DELTA_BINARY_PACKED; 32-bit columns use 32-bit wrapping deltas
+static void pqDelta(PqBuf *b, uint64_t *tmp, const int64_t *v, size_t n, int wide) {
+    pqVarint(b, PQ_DELTA_BLOCK);
+    pqVarint(b, PQ_DELTA_MINI);
+    pqVarint(b, n);
+    pqVarint(b, pqZigzag(n ? v[0] : 0));
+
+    const size_t mini = PQ_DELTA_BLOCK / PQ_DELTA_MINI;
+    for (size_t base = 1; base < n; base += PQ_DELTA_BLOCK) {
+        size_t  cnt = n - base < PQ_DELTA_BLOCK ? n - base : PQ_DELTA_BLOCK;
+        int64_t d[PQ_DELTA_BLOCK];
+
+        // 1) Deltas and their minimum
+        int64_t minD = INT64_MAX;
+        for (size_t i = 0; i < cnt; i++) {
+            uint64_t raw = (uint64_t)v[base + i] - (uint64_t)v[base + i - 1];
+            d[i] = wide ? (int64_t)raw : (int64_t)(int32_t)(uint32_t)raw;
+            if (d[i] < minD)
+                minD = d[i];
+        }
+        pqVarint(b, pqZigzag(minD));
+
+        // 2) Offsets from the minimum, zero padded to whole miniblocks
+        for (size_t i = 0; i < PQ_DELTA_BLOCK; i++) {
+            uint64_t off = i < cnt ? (uint64_t)d[i] - (uint64_t)minD : 0;
+            tmp[i] = wide ? off : (uint32_t)off;
+        }
+
+        // 3) Miniblock widths, then the needed miniblocks
+        size_t  used = (cnt + mini - 1) / mini;
+        uint8_t width[PQ_DELTA_MINI] = { 0 };
+        for (size_t m = 0; m < used; m++) {
+            uint64_t maxOff = 0;
+            for (size_t i = 0; i < mini; i++)
+                maxOff |= tmp[m * mini + i];
+            width[m] = (uint8_t)pqWidth(maxOff);
+        }
+        pqBytes(b, width, PQ_DELTA_MINI);
+        for (size_t m = 0; m < used; m++)
+            pqPackBits(b, tmp + m * mini, mini, width[m]);
+    }
+}
+
+static size_t pqRun(const uint64_t *v, size_t i, size_t n) {
+    size_t j = i + 1;
+    while (j < n && v[j] == v[i])
+        j++;
+    return j - i;
+}
+
+// RLE / bit-packed hybrid (runs of 8+ as RLE, the rest in 8-value groups)
+static void pqHybrid(PqBuf *b, uint64_t *v, size_t n, unsigned w) {
+    unsigned valueBytes = (w + 7) / 8;
+    size_t   i = 0;
+
+    while (i < n) {
+        size_t run = pqRun(v, i, n);
+        if (run >= 8) {
+            pqVarint(b, (uint64_t)run << 1);
+            pqLE(b, v[i], valueBytes);
+            i += run;
+            continue;
+        }
+
+        size_t start = i, groups = 0;
+        while (i < n && groups < 63 && (groups == 0 || pqRun(v, i, n) < 8)) {
+            i += 8;
+            groups++;
+        }
+        pqVarint(b, (groups << 1) | 1);
+
+        uint64_t pad[8] = { 0 };
+        size_t   full = (i <= n ? i : n) - start;
+        pqPackBits(b, v + start, full & ~(size_t)7, w);
+        if (full & 7) {
+            memcpy(pad, v + start + (full & ~(size_t)7), (full & 7) * sizeof(uint64_t));
+            pqPackBits(b, pad, 8, w);
+        }
+        if (i > n)
+            i = n;
+    }
+}
+
+
+/* --- Column chunks -------------------------------------------------------- */
+
+static int pqEmit(BN220_Parquet *pq, const PqBuf *b) {
+    if (b->oom || fwrite(b->p, 1, b->len, pq->fp) != b->len)
+        return 0;
+    pq->offset += (int64_t)b->len;
+    return 1;
+}
+
+static int pqPage(BN220_Parquet *pq, uint8_t type, int32_t values, uint8_t encoding) {
+    PqBuf *h = &pq->header;
+    h->len = 0;
+    h->depth = 0;
+    h->lastId[0] = 0;
+
+    tcBegin(h, 0);
+    tcI32(h, 1, type);
+    tcI32(h, 2, (int32_t)pq->page.len);
+    tcI32(h, 3, (int32_t)pq->page.len);
+    if (type == PQ_PAGE_DATA) {
+        tcBegin(h, 5);
+        tcI32(h, 1, values);
+        tcI32(h, 2, encoding);
+        tcI32(h, 3, PQ_ENC_RLE);
+        tcI32(h, 4, PQ_ENC_RLE);
+        tcEnd(h);
+    } else {
+        tcBegin(h, 7);
+        tcI32(h, 1, values);
+        tcI32(h, 2, PQ_ENC_PLAIN);
+        tcEnd(h);
+    }
+    tcEnd(h);
+    return pqEmit(pq, h) && pqEmit(pq, &pq->page);
+}
+
+// Dictionary of a column chunk; 0 when it has too many distinct values
+static size_t pqDictionary(BN220_Parquet *pq, const int64_t *v, size_t n) {
+    const uint32_t mask = 2 * PQ_DICT_MAX - 1;
+    memset(pq->dictKeys, 0, sizeof(uint64_t) * 2 * PQ_DICT_MAX);
+    size_t count = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t key = (uint64_t)v[i] + 1, h = key * 0x9E3779B97F4A7C15ull;
+        uint32_t s = (uint32_t)(h >> 40) & mask;
+        while (pq->dictKeys[s] && pq->dictKeys[s] != key)
+            s = (s + 1) & mask;
+        if (!pq->dictKeys[s]) {
+            if (count == PQ_DICT_MAX)
+                return 0;
+            pq->dictKeys[s] = key;
+            pq->dictSlot[s] = (uint32_t)count;
+            pq->dictVals[count++] = v[i];
+        }
+        pq->dictIdx[i] = pq->dictSlot[s];
+    }
+    return count;
+}
+
+static int pqChunk(BN220_Parquet *pq, size_t c, PqChunk *out) {
+    const PqColumn *col = &pqColumns[c];
+    const int64_t  *v = pq->col[c];
+    size_t          n = pq->rows;
+    int             wide = col->physical == PQ_INT64;
+    int64_t         start = pq->offset;
+
+    // 1) Statistics, in the column's sort order
+    out->min = out->max = v[0];
+    for (size_t i = 1; i < n; i++) {
+        int lt = col->isUnsigned ? (uint32_t)v[i] < (uint32_t)out->min : v[i] < out->min;
+        int gt = col->isUnsigned ? (uint32_t)v[i] > (uint32_t)out->max : v[i] > out->max;
+        if (lt) out->min = v[i];
+        if (gt) out->max = v[i];
+    }
+    out->values     = (int64_t)n;
+    out->dictOffset = -1;
+
+    // 2) Dictionary page (PLAIN values) when the column allows one
+    size_t dict = col->dict ? pqDictionary(pq, v, n) : 0;
+    if (dict) {
+        pq->page.len = 0;
+        for (size_t i = 0; i < dict; i++)
+            pqLE(&pq->page, (uint64_t)pq->dictVals[i], wide ? 8 : 4);
+        out->dictOffset = pq->offset;
+        if (!pqPage(pq, PQ_PAGE_DICT, (int32_t)dict, 0))
+            return 0;
+    }
+
+    // 3) Data pages
+    out->dataOffset = pq->offset;
+    out->encoding   = dict ? PQ_ENC_RLE_DICT : PQ_ENC_DELTA;
+    unsigned width  = dict > 1 ? pqWidth(dict - 1) : 1;
+    for (size_t base = 0; base < n; base += PQ_PAGE_ROWS) {
+        size_t cnt = n - base < PQ_PAGE_ROWS ? n - base : PQ_PAGE_ROWS;
+        pq->page.len = 0;
+        if (dict) {
+            for (size_t i = 0; i < cnt; i++)
+                pq->scratch[i] = pq->dictIdx[base + i];
+            pqByte(&pq->page, (uint8_t)width);
+            pqHybrid(&pq->page, pq->scratch, cnt, width);
+        } else {
+            pqDelta(&pq->page, pq->scratch, v + base, cnt, wide);
+        }
+        if (!pqPage(pq, PQ_PAGE_DATA, (int32_t)cnt, out->encoding))
+            return 0;
+    }
+    out->size = pq->offset - start;
+    return 1;
+}
+
+static int pqFlush(BN220_Parquet *pq) {
+    if (!pq->rows)
+        return 1;
+    if (pq->ngroups == pq->capGroups) {
+        size_t      cap = pq->capGroups ? pq->capGroups * 2 : 16;
+        PqRowGroup *g = realloc(pq->groups, cap * sizeof(PqRowGroup));
+        if (!g)
+            return 0;
+        pq->groups    = g;
+        pq->capGroups = cap;
+    }
+
+    PqRowGroup *g = &pq->groups[pq->ngroups];
+    g->rows  = pq->rows;
+    g->bytes = 0;
+    for (size_t c = 0; c < PQ_COLUMNS; c++) {
+        if (!pqChunk(pq, c, &g->chunk[c]))
+            return 0;
+        g->bytes += g->chunk[c].size;
+    }
+    pq->ngroups++;
+    pq->totalRows += pq->rows;
+    pq->rows = 0;
+    return 1;
+}
+
+
+/* --- Public API ----------------------------------------------------------- */
+
+BN220_Parquet *parquetOpen(const char *path, uint32_t rowGroupRows) {
+    BN220_Parquet *pq = calloc(1, sizeof(*pq));
+    if (!pq)
+        return NULL;
+
+    pq->groupRows = rowGroupRows ? rowGroupRows : BN220_PQ_ROW_GROUP;
+    pq->ok        = 1;
+    for (size_t c = 0; c < PQ_COLUMNS; c++)
+        pq->ok &= (pq->col[c] = malloc(sizeof(int64_t) * pq->groupRows)) != NULL;
+    pq->scratch  = malloc(sizeof(uint64_t) * (PQ_PAGE_ROWS > PQ_DELTA_BLOCK ? PQ_PAGE_ROWS : PQ_DELTA_BLOCK));
+    pq->dictVals = malloc(sizeof(int64_t) * PQ_DICT_MAX);
+    pq->dictIdx  = malloc(sizeof(uint32_t) * pq->groupRows);
+    pq->dictKeys = malloc(sizeof(uint64_t) * 2 * PQ_DICT_MAX);
+    pq->dictSlot = malloc(sizeof(uint32_t) * 2 * PQ_DICT_MAX);
+    pq->fp       = fopen(path, "wb");
+    if (!pq->ok || !pq->scratch || !pq->dictVals || !pq->dictIdx || !pq->dictKeys ||
+        !pq->dictSlot || !pq->fp || fwrite("PAR1", 1, 4, pq->fp) != 4) {
+        pq->ok = 0;
+        parquetClose(pq);
+        return NULL;
+    }
+    pq->offset = 4;
+    return pq;
+}
+
+int parquetWrite(BN220_Parquet *pq, const uint32_t *device, const BN220_Fix *fix, size_t n) {
+    for (size_t i = 0; pq->ok && i < n; i++) {
+        uint32_t r = pq->rows++;
+        pq->col[0][r] = (int32_t)(device ? device[i] : 0);
+        pq->col[1][r] = fix[i].utc_ms;
+        pq->col[2][r] = fix[i].lat_e7;
+        pq->col[3][r] = fix[i].lon_e7;
+        pq->col[4][r] = fix[i].alt_mm;
+        pq->col[5][r] = fix[i].speed_cms;
+        pq->col[6][r] = fix[i].hdop_c;
+        pq->col[7][r] = fix[i].sats;
+        pq->col[8][r] = fix[i].fix;
+        if (pq->rows == pq->groupRows)
+            pq->ok = pqFlush(pq);
+    }
+    return pq->ok;
+}
+
+int parquetLogSink(void *user, const BN220_LogRecord *recs, size_t n) {
+    BN220_Parquet *pq = user;
+    for (size_t i = 0; i < n; i++) {
+        if (!parquetWrite(pq, &recs[i].device, &recs[i].fix, 1))
+            return 0;
+    }
+    return 1;
+}
+
+
+static void pqFooter(BN220_Parquet *pq, PqBuf *b) {
+    tcBegin(b, 0);                                    // FileMetaData
+    tcI32(b, 1, 1);
+
+    tcList(b, 2, TC_STRUCT, PQ_COLUMNS + 1);          // schema
+    tcBegin(b, 0);
+    tcString(b, 4, "schema");
+    tcI32(b, 5, (int32_t)PQ_COLUMNS);
+    tcEnd(b);
+    for (size_t c = 0; c < PQ_COLUMNS; c++) {
+        tcBegin(b, 0);
+        tcI32(b, 1, pqColumns[c].physical);
+        tcI32(b, 3, 0);                               // REQUIRED
+        tcString(b, 4, pqColumns[c].name);
+        if (pqColumns[c].converted != PQ_CT_NONE)
+            tcI32(b, 6, pqColumns[c].converted);
+        tcEnd(b);
+    }
+    tcI64(b, 3, pq->totalRows);
+
+    tcList(b, 4, TC_STRUCT, pq->ngroups);             // row groups
+    for (size_t g = 0; g < pq->ngroups; g++) {
+        const PqRowGroup *rg = &pq->groups[g];
+        tcBegin(b, 0);
+        tcList(b, 1, TC_STRUCT, PQ_COLUMNS);
+        for (size_t c = 0; c < PQ_COLUMNS; c++) {
+            const PqChunk *ch = &rg->chunk[c];
+            unsigned       w  = pqColumns[c].physical == PQ_INT64 ? 8 : 4;
+            uint8_t        mn[8], mx[8];
+            for (unsigned i = 0; i < w; i++) {
+                mn[i] = (uint8_t)((uint64_t)ch->min >> (8 * i));
+                mx[i] = (uint8_t)((uint64_t)ch->max >> (8 * i));
+            }
+
+            tcBegin(b, 0);                            // ColumnChunk
+            tcI64(b, 2, ch->dictOffset >= 0 ? ch->dictOffset : ch->dataOffset);
+            tcBegin(b, 3);                            // ColumnMetaData
+            tcI32(b, 1, pqColumns[c].physical);
+            if (ch->encoding == PQ_ENC_RLE_DICT) {
+                tcList(b, 2, TC_I32, 3);
+                pqVarint(b, pqZigzag(PQ_ENC_PLAIN));
+                pqVarint(b, pqZigzag(PQ_ENC_RLE));
+                pqVarint(b, pqZigzag(PQ_ENC_RLE_DICT));
+            } else {
+                tcList(b, 2, TC_I32, 2);
+                pqVarint(b, pqZigzag(PQ_ENC_RLE));
+                pqVarint(b, pqZigzag(PQ_ENC_DELTA));
+            }
+            tcList(b, 3, TC_BINARY, 1);
+            pqVarint(b, strlen(pqColumns[c].name));
+            pqBytes(b, pqColumns[c].name, strlen(pqColumns[c].name));
+            tcI32(b, 4, 0);                           // UNCOMPRESSED
+            tcI64(b, 5, ch->values);
+            tcI64(b, 6, ch->size);
+            tcI64(b, 7, ch->size);
+            tcI64(b, 9, ch->dataOffset);
+            if (ch->dictOffset >= 0)
+                tcI64(b, 11, ch->dictOffset);
+            tcBegin(b, 12);                           // Statistics
+            tcI64(b, 3, 0);
+            tcBinary(b, 5, mx, w);
+            tcBinary(b, 6, mn, w);
+            tcEnd(b);
+            tcEnd(b);
+            tcEnd(b);
+        }
+        tcI64(b, 2, rg->bytes);
+        tcI64(b, 3, rg->rows);
+        tcEnd(b);
+    }
+    tcString(b, 6, "BN220 version 1.0.0");
+
+    tcList(b, 7, TC_STRUCT, PQ_COLUMNS);              // column orders: type defined,
+    for (size_t c = 0; c < PQ_COLUMNS; c++) {         // so unsigned statistics are used
+        tcBegin(b, 0);
+        tcBegin(b, 1);
+        tcEnd(b);
+        tcEnd(b);
+    }
+    tcEnd(b);
+}
+
+int parquetClose(BN220_Parquet *pq) {
+    if (!pq)
+        return 0;
+
+    // 1) Last row group and the footer
+    int ok = pq->ok && pq->fp && pqFlush(pq);
+    if (ok) {
+        PqBuf footer = { 0 };
+        pqFooter(pq, &footer);
+        uint8_t tail[8] = { (uint8_t)footer.len, (uint8_t)(footer.len >> 8),
+                            (uint8_t)(footer.len >> 16), (uint8_t)(footer.len >> 24),
+                            'P', 'A', 'R', '1' };
+        ok = pqEmit(pq, &footer) && fwrite(tail, 1, 8, pq->fp) == 8;
+        free(footer.p);
+    }
+    if (pq->fp && fclose(pq->fp) != 0)
+        ok = 0;
+
+    // 2) Free everything
+    for (size_t c = 0; c < PQ_COLUMNS; c++)
+        free(pq->col[c]);
+    free(pq->groups);
+    free(pq->page.p);
+    free(pq->header.p);
+    free(pq->scratch);
+    free(pq->dictVals);
+    free(pq->dictIdx);
+    free(pq->dictKeys);
+    free(pq->dictSlot);
+    free(pq);
+    return ok;
+}
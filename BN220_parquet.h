@@ -0,0 +1,82 @@
+/*
+ * BN220_parquet.h — Parquet writer
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_parquet.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Parquet sink for decoded fixes: delta/dictionary encoded columns
+ *          with statistics.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_PARQUET_H_
+#define INC_BN220_PARQUET_H_
+
+#include "BN220.h"
+#include "BN220_merge.h"
+
+/*
+ * Parquet sink for decoded fixes (host side).
+ *
+ * One flat, non-nullable schema: device (uint32), utc_ms (timestamp ms,
+ * UTC), lat_e7, lon_e7, alt_mm (int32), speed_cms, hdop_c (uint16), sats,
+ * fix (uint8).  Rows are buffered per row group and written column by
+ * column: timestamps and coordinates as DELTA_BINARY_PACKED, low-cardinality
+ * columns (device, hdop_c, sats, fix) as a dictionary plus RLE/bit-packed
+ * indices, falling back to delta when a dictionary would grow too large.
+ * Every column chunk carries min/max statistics so readers can skip row
+ * groups.  Pages are stored uncompressed.
+ *
+ * The writer is not thread-safe; parallel jobs write one file each, e.g.
+ * one per part of mergeFilesParallel() with parquetLogSink as the sink.
+ */
+typedef struct BN220_Parquet BN220_Parquet;
+
+#define BN220_PQ_ROW_GROUP 524288   // default rows per row group
+
+/**
+ * @brief  Create @p path and start a file.
+ *
+ * @param[in] rowGroupRows  Rows per row group; 0 for BN220_PQ_ROW_GROUP.
+ */
+BN220_Parquet *parquetOpen(const char *path, uint32_t rowGroupRows);
+
+/**
+ * @brief  Append n fixes; @p device may be NULL (device 0).
+ *
+ * Returns 0 on an I/O or memory error; the file is unusable afterwards.
+ */
+int parquetWrite(BN220_Parquet *pq, const uint32_t *device, const BN220_Fix *fix, size_t n);
+
+/* BN220_LogSink adapter, user = BN220_Parquet *. */
+int parquetLogSink(void *user, const BN220_LogRecord *recs, size_t n);
+
+/**
+ * @brief  Flush the last row group, write the footer and free @p pq.
+ *
+ * Returns 0 if anything failed since parquetOpen.
+ */
+int parquetClose(BN220_Parquet *pq);
+
+#endif /* INC_BN220_PARQUET_H_ */
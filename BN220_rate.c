@@ -0,0 +1,106 @@
+/*
+ * BN220_rate.c — Adaptive update-rate controller for the BN-220
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_rate.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Profile selection with hysteresis and dwell, and UBX-CFG-RATE
+ *          generation.
+ * ---------------------------------------------------------------------------
+ */
+
+#include "BN220_rate.h"
+
+#if BN220_ENABLE_UBX
+
+#define CFG_RATE_NAV_RATE  1  // one navigation solution per measurement
+#define CFG_RATE_TIME_REF  1  // align measurements to GPS time
+
+
+void gpsRateInit(BN220_RateCtl *ctl, const BN220_RateProfile *profiles,
+                 uint8_t count, uint8_t initial) {
+    memset(ctl, 0, sizeof(*ctl));
+    ctl->profiles   = profiles;
+    ctl->count      = count;
+    ctl->current    = initial < count ? initial : 0;
+    ctl->dwell      = 10;
+    ctl->hysteresis = 0.5f;
+    ctl->maxHdop    = 5.0f;
+}
+
+
+static int rateSend(uint16_t measRate_ms, BN220_WriteFn write, void *port) {
+    uint8_t pl[6];
+
+    ubxPutU16(&pl[0], measRate_ms);
+    ubxPutU16(&pl[2], CFG_RATE_NAV_RATE);
+    ubxPutU16(&pl[4], CFG_RATE_TIME_REF);
+
+    return ubxSend(write, port, UBX_CLASS_CFG, UBX_CFG_RATE, pl, sizeof(pl));
+}
+
+
+int gpsRateUpdate(BN220_RateCtl *ctl, const BN220_GPS *gps_data,
+                  BN220_WriteFn write, void *port) {
+    if (!ctl || !ctl->profiles || !ctl->count || !gps_data)
+        return 0;
+
+    // 1) Only trust speed from a fix with usable geometry
+    if (!gps_data->fix || gps_data->hdop <= 0.0f || gps_data->hdop > ctl->maxHdop) {
+        ctl->votes = 0;
+        return 0;
+    }
+
+    // 2) Walk up past every threshold we exceed, then down past every one
+    //    we have clearly fallen below
+    const BN220_RateProfile *pr = ctl->profiles;
+    float   v = gps_data->speed;
+    uint8_t t = ctl->current;
+
+    while (t + 1 < ctl->count && v >= pr[t + 1].upSpeed)
+        t++;
+    while (t > 0 && t == ctl->current && v < pr[t].upSpeed - ctl->hysteresis)
+        t--;
+    while (t > 0 && t < ctl->current && v < pr[t].upSpeed)
+        t--;
+
+    if (t == ctl->current) {
+        ctl->votes = 0;
+        return 0;
+    }
+
+    // 3) Stepping down waits for the dwell count
+    if (t < ctl->current && ++ctl->votes < ctl->dwell)
+        return 0;
+
+    // 4) Reconfigure; on a port error keep the old profile and retry next epoch
+    if (!rateSend(pr[t].measRate_ms, write, port))
+        return 0;
+
+    ctl->current = t;
+    ctl->votes   = 0;
+    return 1;
+}
+
+#endif /* BN220_ENABLE_UBX */
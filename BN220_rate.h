@@ -0,0 +1,84 @@
+/*
+ * BN220_rate.h — Adaptive update-rate controller for the BN-220
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_rate.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Switches the receiver between measurement-rate profiles from the
+ *          parsed speed and hdop, with hysteresis, using generated
+ *          UBX-CFG-RATE commands.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_RATE_H_
+#define INC_BN220_RATE_H_
+
+#include "BN220.h"
+#include "BN220_ubx.h"
+
+typedef struct {
+    uint16_t measRate_ms; // receiver measurement period for this profile
+    float    upSpeed;     // m/s; the profile is selected once speed reaches it
+} BN220_RateProfile;
+
+typedef struct {
+    const BN220_RateProfile *profiles; // ordered by ascending upSpeed, profiles[0].upSpeed = 0
+    uint8_t  count;
+    uint8_t  current;    // profile the receiver is running now
+    uint8_t  dwell;      // epochs the slower profile must win before stepping down
+    uint8_t  votes;      // consecutive epochs voting for a step down
+    float    hysteresis; // m/s below a profile's upSpeed before leaving it
+    float    maxHdop;    // speed is not trusted above this hdop
+} BN220_RateCtl;
+
+/**
+ * @brief  Initialise the controller.
+ *
+ * @param[out] ctl       Controller state.
+ * @param[in]  profiles  Rate profiles, slowest first; must outlive @p ctl.
+ * @param[in]  count     Number of profiles.
+ * @param[in]  initial   Index of the profile the receiver currently runs.
+ *
+ * Defaults: 0.5 m/s hysteresis, 10 epoch dwell, hdop limit 5.0.  The fields
+ * can be changed directly after this call.
+ */
+void gpsRateInit(BN220_RateCtl *ctl, const BN220_RateProfile *profiles,
+                 uint8_t count, uint8_t initial);
+
+/**
+ * @brief  Evaluate one epoch and reconfigure the receiver when needed.
+ *
+ * @param[in,out] ctl       Controller state.
+ * @param[in]     gps_data  Latest parsed state (speed, hdop, fix).
+ * @param[in]     write     Port hook used to send UBX-CFG-RATE.
+ * @param[in]     port      Opaque pointer passed to @p write.
+ *
+ * Speeding up is applied on the first epoch that asks for it; slowing down
+ * needs ctl->dwell consecutive epochs.  Epochs without a fix or with poor
+ * hdop keep the current profile.  Returns 1 when a CFG-RATE was sent.
+ */
+int gpsRateUpdate(BN220_RateCtl *ctl, const BN220_GPS *gps_data,
+                  BN220_WriteFn write, void *port);
+
+#endif /* INC_BN220_RATE_H_ */
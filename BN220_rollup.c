@@ -0,0 +1,126 @@
+/*
+ * BN220_rollup.c — Time-bucketed rollups
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_rollup.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Constant-time bucket update, emission on bucket change and bucket
+ *          combining.
+ * ---------------------------------------------------------------------------
+ */
+
+#include "BN220_rollup.h"
+
+// Empty bucket starting at @p start_ms; mins start high so the first fix sets them
+static void rollupOpen(BN220_RollupBucket *b, int64_t start_ms) {
+    uint32_t width = b->width_ms;
+    memset(b, 0, sizeof(*b));
+    b->start_ms     = start_ms;
+    b->width_ms     = width;
+    b->speedMin_cms = UINT16_MAX;
+    b->hdopMin_c    = UINT16_MAX;
+    b->altMin_mm    = INT32_MAX;
+    b->altMax_mm    = INT32_MIN;
+    b->satsMin      = UINT8_MAX;
+}
+
+void rollupInit(BN220_Rollup *r, uint32_t width_ms, BN220_RollupFn onBucket, void *user) {
+    memset(r, 0, sizeof(*r));
+    r->cur.width_ms = width_ms ? width_ms : BN220_ROLLUP_MINUTE;
+    r->onBucket     = onBucket;
+    r->user         = user;
+}
+
+void rollupFlush(BN220_Rollup *r) {
+    BN220_RollupBucket *b = &r->cur;
+    if (!b->epochs)
+        return;
+
+    // Buckets without a valid fix report zeros rather than the sentinels
+    if (!b->valid) {
+        b->speedMin_cms = b->hdopMin_c = 0;
+        b->altMin_mm    = b->altMax_mm = 0;
+        b->satsMin      = 0;
+    }
+    if (r->onBucket)
+        r->onBucket(r->user, b);
+    b->epochs = 0;
+}
+
+void rollupUpdate(BN220_Rollup *r, const BN220_Fix *fix) {
+    BN220_RollupBucket *b = &r->cur;
+
+    // 1) Bucket of this fix (floor division, also for ms-of-day wraps)
+    int64_t w     = b->width_ms;
+    int64_t start = fix->utc_ms - ((fix->utc_ms % w) + w) % w;
+    if (!b->epochs || start != b->start_ms) {
+        rollupFlush(r);
+        rollupOpen(b, start);
+    }
+
+    // 2) Aggregates
+    b->epochs++;
+    if (!fix->fix)
+        return;
+    b->valid++;
+    if (fix->speed_cms < b->speedMin_cms) b->speedMin_cms = fix->speed_cms;
+    if (fix->speed_cms > b->speedMax_cms) b->speedMax_cms = fix->speed_cms;
+    if (fix->hdop_c < b->hdopMin_c)       b->hdopMin_c    = fix->hdop_c;
+    if (fix->hdop_c > b->hdopMax_c)       b->hdopMax_c    = fix->hdop_c;
+    if (fix->alt_mm < b->altMin_mm)       b->altMin_mm    = fix->alt_mm;
+    if (fix->alt_mm > b->altMax_mm)       b->altMax_mm    = fix->alt_mm;
+    if (fix->sats < b->satsMin)           b->satsMin      = fix->sats;
+    if (fix->sats > b->satsMax)           b->satsMax      = fix->sats;
+    b->speedSum_cms += fix->speed_cms;
+    b->hdopSum_c    += fix->hdop_c;
+    b->altSum_mm    += fix->alt_mm;
+    b->satsSum      += fix->sats;
+}
+
+void rollupEpochSink(void *user, const BN220_Fix *fix) {
+    rollupUpdate((BN220_Rollup *)user, fix);
+}
+
+void rollupCombine(BN220_RollupBucket *dst, const BN220_RollupBucket *src) {
+    // 1) Extremes only where the side has valid fixes (empty sides hold zeros)
+    if (src->valid) {
+        int first = !dst->valid;
+        if (first || src->speedMin_cms < dst->speedMin_cms) dst->speedMin_cms = src->speedMin_cms;
+        if (first || src->speedMax_cms > dst->speedMax_cms) dst->speedMax_cms = src->speedMax_cms;
+        if (first || src->hdopMin_c < dst->hdopMin_c)       dst->hdopMin_c    = src->hdopMin_c;
+        if (first || src->hdopMax_c > dst->hdopMax_c)       dst->hdopMax_c    = src->hdopMax_c;
+        if (first || src->altMin_mm < dst->altMin_mm)       dst->altMin_mm    = src->altMin_mm;
+        if (first || src->altMax_mm > dst->altMax_mm)       dst->altMax_mm    = src->altMax_mm;
+        if (first || src->satsMin < dst->satsMin)           dst->satsMin      = src->satsMin;
+        if (first || src->satsMax > dst->satsMax)           dst->satsMax      = src->satsMax;
+    }
+
+    // 2) Counts and sums
+    dst->epochs       += src->epochs;
+    dst->valid        += src->valid;
+    dst->speedSum_cms += src->speedSum_cms;
+    dst->hdopSum_c    += src->hdopSum_c;
+    dst->altSum_mm    += src->altSum_mm;
+    dst->satsSum      += src->satsSum;
+}
@@ -0,0 +1,108 @@
+/*
+ * BN220_rollup.h — Time-bucketed rollups
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_rollup.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Per-minute (or any width) min/max/sum aggregates of speed,
+ *          altitude, satellites and hdop, updated per fix.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_ROLLUP_H_
+#define INC_BN220_ROLLUP_H_
+
+#include "BN220.h"
+
+/*
+ * Time-bucketed rollups (per-minute by default), one BN220_Rollup per
+ * device, fed from the parser's epoch output.
+ *
+ * Each fix updates the open bucket in constant time: count, min, max and
+ * sum of speed, altitude, satellites and hdop.  When a fix falls into a
+ * different bucket the open one is final and handed to the callback, so
+ * dashboards read one record per bucket instead of the raw fixes.  Empty
+ * buckets are not emitted.  Fixed-size state, integers only: runs on the
+ * MCU as well as in the backend.
+ */
+
+typedef struct {
+    int64_t  start_ms;       // bucket start, a multiple of the width (UTC ms)
+    uint32_t width_ms;
+    uint32_t epochs;         // fixes received in the bucket
+    uint32_t valid;          // of those with fix != 0; the fields below cover these
+    uint16_t speedMin_cms, speedMax_cms;
+    uint16_t hdopMin_c, hdopMax_c;
+    int32_t  altMin_mm, altMax_mm;
+    uint8_t  satsMin, satsMax;
+    uint64_t speedSum_cms;   // averages: sum / valid
+    uint64_t hdopSum_c;
+    int64_t  altSum_mm;
+    uint32_t satsSum;
+} BN220_RollupBucket;
+
+typedef void (*BN220_RollupFn)(void *user, const BN220_RollupBucket *bucket);
+
+typedef struct {
+    BN220_RollupBucket cur;  // open bucket; cur.epochs == 0 when none
+    BN220_RollupFn     onBucket;
+    void              *user;
+} BN220_Rollup;
+
+#define BN220_ROLLUP_MINUTE 60000u
+
+/**
+ * @brief  Initialise a rollup.
+ *
+ * @param[out] r         Rollup state.
+ * @param[in]  width_ms  Bucket width; 0 for BN220_ROLLUP_MINUTE.
+ * @param[in]  onBucket  Called with every finished bucket.
+ * @param[in]  user      Passed to @p onBucket.
+ */
+void rollupInit(BN220_Rollup *r, uint32_t width_ms, BN220_RollupFn onBucket, void *user);
+
+/**
+ * @brief  Add one fix.  A fix outside the open bucket (later, or earlier
+ *         after a clock step) finishes it first.
+ */
+void rollupUpdate(BN220_Rollup *r, const BN220_Fix *fix);
+
+/**
+ * @brief  Emit the open bucket now (end of stream, shutdown).
+ */
+void rollupFlush(BN220_Rollup *r);
+
+/**
+ * @brief  Adapter for BN220_Context.onEpoch with user = BN220_Rollup *.
+ */
+void rollupEpochSink(void *user, const BN220_Fix *fix);
+
+/**
+ * @brief  Fold bucket @p src into @p dst, e.g. minutes into an hour.
+ *
+ * dst keeps its start and width; the caller picks matching buckets.
+ */
+void rollupCombine(BN220_RollupBucket *dst, const BN220_RollupBucket *src);
+
+#endif /* INC_BN220_ROLLUP_H_ */
@@ -0,0 +1,208 @@
+/*
+ * BN220_segment.c — Stop/trip segmentation
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_segment.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Stop candidate, dwell centroid and departure logic; constant work
+ *          per fix, no allocation.
+ * ---------------------------------------------------------------------------
+ */
+
+#include "BN220_segment.h"
+#include <math.h>
+
+#define SEG_M_PER_E7    0.0111319491f  // metres per 1e-7° of latitude
+#define SEG_RESCALE_E7  1000000        // refresh the longitude scale every 0.1°
+#define SEG_NO_TRIP     INT64_MIN
+#define SEG_HALF_TURN   1800000000LL   // 180° in 1e-7°
+
+enum {
+    SEG_IDLE = 0,  // no fix yet
+    SEG_MOVING,
+    SEG_STOPPING,  // slow, waiting for minStop_ms
+    SEG_STOPPED,
+    SEG_LEAVING    // outside the stop, waiting for minMove_ms
+};
+
+
+void segInit(BN220_Segmenter *seg, BN220_SegEventFn onEvent, void *user) {
+    memset(seg, 0, sizeof(*seg));
+    seg->stopSpeed_cms = 50;
+    seg->moveSpeed_cms = 200;
+    seg->radius_m      = 30;
+    seg->minStop_ms    = 120000;
+    seg->minMove_ms    = 30000;
+    seg->tripStart_ms  = SEG_NO_TRIP;
+    seg->onEvent       = onEvent;
+    seg->user          = user;
+}
+
+
+// Longitude into [-180°, 180°); the input may be a sum or difference of two
+static int32_t segWrapLon(int64_t lon) {
+    if (lon >= SEG_HALF_TURN)
+        lon -= 2 * SEG_HALF_TURN;
+    else if (lon < -SEG_HALF_TURN)
+        lon += 2 * SEG_HALF_TURN;
+    return (int32_t)lon;
+}
+
+// Shortest longitude step from @p from to @p to, across the antimeridian too
+static int32_t segDLon(int32_t from, int32_t to) {
+    return segWrapLon((int64_t)to - from);
+}
+
+static float segDist2(const BN220_Segmenter *seg, int32_t lat1, int32_t lon1, int32_t lat2, int32_t lon2) {
+    float dy = (float)(lat2 - lat1) * SEG_M_PER_E7;
+    float dx = (float)segDLon(lon1, lon2) * seg->mPerE7Lon;
+    return dx * dx + dy * dy;
+}
+
+static void segCentroid(const BN220_Segmenter *seg, int32_t *lat, int32_t *lon) {
+    uint32_t n = seg->samples ? seg->samples : 1;
+    *lat = seg->anchorLat + (int32_t)(seg->sumLat / (int64_t)n);
+    *lon = segWrapLon((int64_t)seg->anchorLon + seg->sumLon / (int64_t)n);
+}
+
+static void segAnchor(BN220_Segmenter *seg, const BN220_Fix *fix) {
+    seg->anchorLat    = fix->lat_e7;
+    seg->anchorLon    = fix->lon_e7;
+    seg->sumLat       = 0;
+    seg->sumLon       = 0;
+    seg->samples      = 1;
+    seg->since_ms     = fix->utc_ms;
+    seg->anchorDist_m = seg->tripDist_m;
+}
+
+static void segEmit(BN220_Segmenter *seg, uint8_t type, int64_t time_ms, int32_t lat, int32_t lon,
+                    int64_t duration_ms, float distance_m) {
+    BN220_SegEvent ev = { type, time_ms, lat, lon,
+                          duration_ms > 0 ? (uint32_t)duration_ms : 0,
+                          distance_m > 0.0f ? (uint32_t)distance_m : 0 };
+    if (seg->onEvent)
+        seg->onEvent(seg->user, &ev);
+}
+
+static void segTripStart(BN220_Segmenter *seg, int64_t time_ms, int32_t lat, int32_t lon) {
+    seg->tripStart_ms = time_ms;
+    seg->tripDist_m   = 0.0f;
+    segEmit(seg, BN220_SEG_TRIP_START, time_ms, lat, lon, 0, 0.0f);
+}
+
+
+void segUpdate(BN220_Segmenter *seg, const BN220_Fix *fix) {
+    if (!fix->fix || (seg->state != SEG_IDLE && fix->utc_ms < seg->last_ms))
+        return;     // no position, or out of order
+
+    int64_t t       = fix->utc_ms;
+    float   radius2 = (float)seg->radius_m * (float)seg->radius_m;
+    int     slow    = fix->speed_cms <= seg->stopSpeed_cms;
+    int     fast    = fix->speed_cms >  seg->moveSpeed_cms;
+    int32_t cLat, cLon;
+
+    // 1) Longitude scale, refreshed only after a noticeable latitude change
+    if (seg->state == SEG_IDLE || abs(fix->lat_e7 - seg->scaleLat) > SEG_RESCALE_E7) {
+        seg->scaleLat  = fix->lat_e7;
+        seg->mPerE7Lon = SEG_M_PER_E7 * cosf((float)fix->lat_e7 * 1e-7f * 0.0174532925f);
+    }
+
+    // 2) Trip distance: every step outside a confirmed stop
+    if (seg->state == SEG_MOVING || seg->state == SEG_STOPPING)
+        seg->tripDist_m += sqrtf(segDist2(seg, seg->lastLat, seg->lastLon, fix->lat_e7, fix->lon_e7));
+
+    switch (seg->state) {
+    case SEG_IDLE:
+        if (slow) {
+            segAnchor(seg, fix);
+            seg->state = SEG_STOPPING;
+        } else {
+            segTripStart(seg, t, fix->lat_e7, fix->lon_e7);
+            seg->state = SEG_MOVING;
+        }
+        break;
+
+    case SEG_MOVING:
+        if (slow) {
+            segAnchor(seg, fix);
+            seg->state = SEG_STOPPING;
+        }
+        break;
+
+    case SEG_STOPPING:
+        // 3) Left the radius before minStop_ms: not a stop.  Speed alone does
+        //    not cancel, so a single noisy speed spike cannot reset the wait.
+        if (segDist2(seg, seg->anchorLat, seg->anchorLon, fix->lat_e7, fix->lon_e7) > radius2) {
+            if (seg->tripStart_ms == SEG_NO_TRIP)
+                segTripStart(seg, t, fix->lat_e7, fix->lon_e7);
+            seg->state = SEG_MOVING;
+            break;
+        }
+        seg->sumLat += fix->lat_e7 - seg->anchorLat;
+        seg->sumLon += segDLon(seg->anchorLon, fix->lon_e7);
+        seg->samples++;
+        if (t - seg->since_ms >= (int64_t)seg->minStop_ms) {
+            segCentroid(seg, &cLat, &cLon);
+            if (seg->tripStart_ms == SEG_NO_TRIP)
+                segEmit(seg, BN220_SEG_STOP_START, seg->since_ms, cLat, cLon, 0, 0.0f);
+            else
+                segEmit(seg, BN220_SEG_STOP_START, seg->since_ms, cLat, cLon,
+                        seg->since_ms - seg->tripStart_ms, seg->anchorDist_m);
+            seg->stopStart_ms = seg->since_ms;
+            seg->tripStart_ms = SEG_NO_TRIP;
+            seg->state = SEG_STOPPED;
+        }
+        break;
+
+    case SEG_STOPPED:
+    case SEG_LEAVING:
+        // 4) Outside the dwell area for minMove_ms ends the stop
+        segCentroid(seg, &cLat, &cLon);
+        if (!fast && segDist2(seg, cLat, cLon, fix->lat_e7, fix->lon_e7) <= radius2) {
+            seg->sumLat += fix->lat_e7 - seg->anchorLat;
+            seg->sumLon += segDLon(seg->anchorLon, fix->lon_e7);
+            seg->samples++;
+            seg->state = SEG_STOPPED;
+        } else if (seg->state == SEG_STOPPED) {
+            seg->since_ms = t;
+            seg->state = SEG_LEAVING;
+        } else if (t - seg->since_ms >= (int64_t)seg->minMove_ms) {
+            segEmit(seg, BN220_SEG_STOP_END, seg->since_ms, cLat, cLon,
+                    seg->since_ms - seg->stopStart_ms, 0.0f);
+            segTripStart(seg, seg->since_ms, cLat, cLon);
+            seg->tripDist_m = sqrtf(segDist2(seg, cLat, cLon, fix->lat_e7, fix->lon_e7));
+            seg->state = SEG_MOVING;
+        }
+        break;
+    }
+
+    seg->last_ms = t;
+    seg->lastLat = fix->lat_e7;
+    seg->lastLon = fix->lon_e7;
+}
+
+
+void segEpochSink(void *user, const BN220_Fix *fix) {
+    segUpdate((BN220_Segmenter *)user, fix);
+}
@@ -0,0 +1,114 @@
+/*
+ * BN220_segment.h — Stop/trip segmentation
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_segment.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Per-device streaming state machine turning fixes into trip-start,
+ *          stop-start and stop-end events.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_SEGMENT_H_
+#define INC_BN220_SEGMENT_H_
+
+#include "BN220.h"
+
+/*
+ * Streaming stop/trip segmentation, one BN220_Segmenter per device.
+ *
+ * A stop is declared once the vehicle has stayed slow and inside a radius
+ * for minStop_ms; it ends once the vehicle has been outside the radius (or
+ * fast) for minMove_ms.  Everything else is a trip.  State is a fixed-size
+ * struct without allocation, and each fix costs a handful of integer and
+ * float operations, so the same code runs on the MCU and in the backend.
+ */
+
+typedef enum {
+    BN220_SEG_TRIP_START = 1,  // left a stop (or first moving fix)
+    BN220_SEG_STOP_START,      // stop confirmed; closes the running trip
+    BN220_SEG_STOP_END         // stop left; dwell location and duration final
+} BN220_SegEventType;
+
+typedef struct {
+    uint8_t  type;         // BN220_SegEventType
+    int64_t  time_ms;      // trip start, stop arrival or stop departure (UTC ms)
+    int32_t  lat_e7;       // trip start position, or dwell centroid for stops
+    int32_t  lon_e7;
+    uint32_t duration_ms;  // STOP_START: trip duration, STOP_END: dwell time
+    uint32_t distance_m;   // STOP_START: trip distance
+} BN220_SegEvent;
+
+typedef void (*BN220_SegEventFn)(void *user, const BN220_SegEvent *ev);
+
+typedef struct {
+    // Tuning; set by segInit, may be changed afterwards
+    uint16_t stopSpeed_cms;  // at or below this the vehicle may be stopping
+    uint16_t moveSpeed_cms;  // above this it is moving even inside the radius
+    uint16_t radius_m;       // position noise tolerated during a stop
+    uint32_t minStop_ms;     // slow time needed to declare a stop
+    uint32_t minMove_ms;     // time outside the stop needed to end it
+
+    // Running state
+    uint8_t  state;
+    int64_t  since_ms;       // candidate stop / departure start
+    int64_t  tripStart_ms;
+    int64_t  stopStart_ms;
+    int64_t  last_ms;
+    int32_t  lastLat, lastLon;
+    int32_t  anchorLat, anchorLon;  // first position of the stop
+    int64_t  sumLat, sumLon;        // offsets from the anchor, for the centroid
+    uint32_t samples;
+    int32_t  scaleLat;              // latitude mPerE7Lon was computed at
+    float    mPerE7Lon;             // metres per 1e-7° of longitude there
+    float    tripDist_m;
+    float    anchorDist_m;          // trip distance when the stop candidate began
+
+    BN220_SegEventFn onEvent;
+    void            *user;
+} BN220_Segmenter;
+
+/**
+ * @brief  Initialise a segmenter.
+ *
+ * @param[out] seg      Segmenter state.
+ * @param[in]  onEvent  Event callback.
+ * @param[in]  user     Passed to @p onEvent.
+ *
+ * Defaults: stop below 0.5 m/s, move above 2 m/s, 30 m radius, 2 min to
+ * declare a stop and 30 s to leave it.
+ */
+void segInit(BN220_Segmenter *seg, BN220_SegEventFn onEvent, void *user);
+
+/**
+ * @brief  Process one fix; fixes without a position fix are ignored.
+ */
+void segUpdate(BN220_Segmenter *seg, const BN220_Fix *fix);
+
+/**
+ * @brief  Adapter for BN220_Context.onEpoch with user = BN220_Segmenter *.
+ */
+void segEpochSink(void *user, const BN220_Fix *fix);
+
+#endif /* INC_BN220_SEGMENT_H_ */
@@ -0,0 +1,237 @@
+/*
+ * BN220_serialize.c — JSON/CSV serializer
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_serialize.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Literal key fragments and integer formatting for fix and
+ *          statistics records.
+ * ---------------------------------------------------------------------------
+ */
+
+#include "BN220_serialize.h"
+#include "BN220_fmt.h"
+
+static const char serFixHeader[] = "device,utc_ms,lat,lon,alt,speed,hdop,sats,fix\n";
+
+// Record body after the opening brace / device id
+static inline char *serJsonFix(char *p, const BN220_Fix *f) {
+    FMT_LIT(p, "\"utc_ms\":");
+    p = fmtI64(p, f->utc_ms);
+    FMT_LIT(p, ",\"lat\":");
+    p = fmtFixed(p, f->lat_e7, 7);
+    FMT_LIT(p, ",\"lon\":");
+    p = fmtFixed(p, f->lon_e7, 7);
+    FMT_LIT(p, ",\"alt\":");
+    p = fmtFixed(p, f->alt_mm, 3);
+    FMT_LIT(p, ",\"speed\":");
+    p = fmtFixed(p, f->speed_cms, 2);
+    FMT_LIT(p, ",\"hdop\":");
+    p = fmtFixed(p, f->hdop_c, 2);
+    FMT_LIT(p, ",\"sats\":");
+    p = fmtU64(p, f->sats);
+    FMT_LIT(p, ",\"fix\":");
+    p = fmtU64(p, f->fix);
+    FMT_LIT(p, "}\n");
+    return p;
+}
+
+static inline char *serCsvFix(char *p, const BN220_Fix *f) {
+    p    = fmtI64(p, f->utc_ms);
+    *p++ = ',';
+    p    = fmtFixed(p, f->lat_e7, 7);
+    *p++ = ',';
+    p    = fmtFixed(p, f->lon_e7, 7);
+    *p++ = ',';
+    p    = fmtFixed(p, f->alt_mm, 3);
+    *p++ = ',';
+    p    = fmtFixed(p, f->speed_cms, 2);
+    *p++ = ',';
+    p    = fmtFixed(p, f->hdop_c, 2);
+    *p++ = ',';
+    p    = fmtU64(p, f->sats);
+    *p++ = ',';
+    p    = fmtU64(p, f->fix);
+    *p++ = '\n';
+    return p;
+}
+
+size_t serFixes(char *out, size_t cap, BN220_SerFormat format, const uint32_t *device,
+                const BN220_Fix *fix, size_t n, size_t *done) {
+    char       *p   = out;
+    const char *end = out + (cap >= BN220_SER_FIX_MAX ? cap - BN220_SER_FIX_MAX : 0);
+    size_t      i   = 0;
+    if (cap < BN220_SER_FIX_MAX)
+        n = 0;
+
+    // One loop per format/device combination keeps the record path branch-free
+    if (format == BN220_SER_JSON) {
+        if (device) {
+            for (; i < n && p <= end; i++) {
+                FMT_LIT(p, "{\"device\":");
+                p    = fmtU64(p, device[i]);
+                *p++ = ',';
+                p    = serJsonFix(p, &fix[i]);
+            }
+        } else {
+            for (; i < n && p <= end; i++) {
+                *p++ = '{';
+                p    = serJsonFix(p, &fix[i]);
+            }
+        }
+    } else {
+        if (device) {
+            for (; i < n && p <= end; i++) {
+                p    = fmtU64(p, device[i]);
+                *p++ = ',';
+                p    = serCsvFix(p, &fix[i]);
+            }
+        } else {
+            for (; i < n && p <= end; i++)
+                p = serCsvFix(p, &fix[i]);
+        }
+    }
+
+    if (done)
+        *done = i;
+    return (size_t)(p - out);
+}
+
+size_t serCsvFixHeader(char *out, size_t cap, int withDevice) {
+    const char *h   = withDevice ? serFixHeader : serFixHeader + sizeof("device,") - 1;
+    size_t      len = strlen(h);
+    if (cap < len)
+        return 0;
+    memcpy(out, h, len);
+    return len;
+}
+
+static inline char serTalker(char t) {
+    return t >= 'A' && t <= 'Z' ? t : '?';
+}
+
+size_t serSats(char *out, size_t cap, BN220_SerFormat format, int64_t utc_ms,
+               const BN220_Sat *sats, size_t n) {
+    char *p = out;
+    if (cap < BN220_SER_SATS_MAX(n))
+        return 0;
+
+    if (format == BN220_SER_JSON) {
+        FMT_LIT(p, "{\"utc_ms\":");
+        p = fmtI64(p, utc_ms);
+        FMT_LIT(p, ",\"sats\":[");
+        for (size_t i = 0; i < n; i++) {
+            const BN220_Sat *s = &sats[i];
+            if (i)
+                *p++ = ',';
+            FMT_LIT(p, "{\"prn\":");
+            p = fmtU64(p, s->prn);
+            FMT_LIT(p, ",\"talker\":\"");
+            *p++ = serTalker(s->talker);
+            if (s->azim == BN220_SAT_NO_POS) {
+                FMT_LIT(p, "\",\"elev\":null,\"azim\":null");
+            } else {
+                FMT_LIT(p, "\",\"elev\":");
+                p = fmtI64(p, s->elev);
+                FMT_LIT(p, ",\"azim\":");
+                p = fmtU64(p, s->azim);
+            }
+            FMT_LIT(p, ",\"snr\":");
+            p = fmtU64(p, s->snr);
+            FMT_LIT(p, ",\"used\":");
+            p = fmtU64(p, s->used);
+            *p++ = '}';
+        }
+        FMT_LIT(p, "]}\n");
+    } else {
+        for (size_t i = 0; i < n; i++) {
+            const BN220_Sat *s = &sats[i];
+            p    = fmtI64(p, utc_ms);
+            *p++ = ',';
+            p    = fmtU64(p, s->prn);
+            *p++ = ',';
+            *p++ = serTalker(s->talker);
+            *p++ = ',';
+            if (s->azim != BN220_SAT_NO_POS) {
+                p    = fmtI64(p, s->elev);
+                *p++ = ',';
+                p    = fmtU64(p, s->azim);
+            } else {
+                *p++ = ',';
+            }
+            *p++ = ',';
+            p    = fmtU64(p, s->snr);
+            *p++ = ',';
+            p    = fmtU64(p, s->used);
+            *p++ = '\n';
+        }
+    }
+    return (size_t)(p - out);
+}
+
+size_t serCsvSatHeader(char *out, size_t cap) {
+    static const char h[] = "utc_ms,prn,talker,elev,azim,snr,used\n";
+    if (cap < sizeof(h) - 1)
+        return 0;
+    memcpy(out, h, sizeof(h) - 1);
+    return sizeof(h) - 1;
+}
+
+#if BN220_ENABLE_STATS
+size_t serStats(char *out, size_t cap, BN220_SerFormat format, const BN220_Stats *stats) {
+    char *p = out;
+    if (cap < BN220_SER_STATS_MAX)
+        return 0;
+
+    if (format == BN220_SER_JSON) {
+        FMT_LIT(p, "{\"sentences\":");
+        p = fmtU64(p, stats->sentences);
+        FMT_LIT(p, ",\"decoded\":");
+        p = fmtU64(p, stats->decoded);
+        FMT_LIT(p, ",\"checksum_errors\":");
+        p = fmtU64(p, stats->checksumErrors);
+        FMT_LIT(p, ",\"overflows\":");
+        p = fmtU64(p, stats->overflows);
+        FMT_LIT(p, "}\n");
+    } else {
+        p    = fmtU64(p, stats->sentences);
+        *p++ = ',';
+        p    = fmtU64(p, stats->decoded);
+        *p++ = ',';
+        p    = fmtU64(p, stats->checksumErrors);
+        *p++ = ',';
+        p    = fmtU64(p, stats->overflows);
+        *p++ = '\n';
+    }
+    return (size_t)(p - out);
+}
+
+size_t serCsvStatsHeader(char *out, size_t cap) {
+    static const char h[] = "sentences,decoded,checksum_errors,overflows\n";
+    if (cap < sizeof(h) - 1)
+        return 0;
+    memcpy(out, h, sizeof(h) - 1);
+    return sizeof(h) - 1;
+}
+#endif
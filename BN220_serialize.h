@@ -0,0 +1,126 @@
+/*
+ * BN220_serialize.h — JSON/CSV serializer
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_serialize.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Allocation-free JSON Lines / CSV rendering of fixes and parser
+ *          statistics.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_SERIALIZE_H_
+#define INC_BN220_SERIALIZE_H_
+
+#include "BN220.h"
+
+/*
+ * JSON Lines / CSV rendering of fixes and parser statistics.
+ *
+ * Records are written into a caller buffer, one per line, with no
+ * allocation and no printf: keys and separators are literal fragments of
+ * known length, numbers come from the integer formatters of BN220_fmt.h.
+ * Fixed-point fields are printed exactly in natural units:
+ *
+ *   {"device":7,"utc_ms":1760000000000,"lat":41.2345678,"lon":29.0123456,
+ *    "alt":123.456,"speed":1.25,"hdop":0.95,"sats":9,"fix":1}
+ *
+ *   device,utc_ms,lat,lon,alt,speed,hdop,sats,fix
+ *   7,1760000000000,41.2345678,29.0123456,123.456,1.25,0.95,9,1
+ *
+ * lat/lon in degrees, alt in metres, speed in m/s.  The device key/column
+ * is present only when device ids are passed.
+ *
+ * A satellite table (gps.sats[]) is one JSON record per epoch, or one CSV
+ * row per satellite keyed by the epoch time:
+ *
+ *   {"utc_ms":1760000000000,"sats":[{"prn":5,"talker":"P","elev":41,
+ *    "azim":123,"snr":38,"used":1},...]}
+ *
+ *   utc_ms,prn,talker,elev,azim,snr,used
+ *   1760000000000,5,P,41,123,38,1
+ *
+ * elev/azim are null (JSON) or empty (CSV) when the GSV gave no position.
+ */
+typedef enum {
+    BN220_SER_JSON = 0, // one JSON object per line
+    BN220_SER_CSV       // one row per line; headers from serCsv*Header()
+} BN220_SerFormat;
+
+#define BN220_SER_FIX_MAX   192 // free bytes needed to start one fix record
+#define BN220_SER_STATS_MAX 128 // same for one statistics record
+#define BN220_SER_SAT_MAX   80  // per satellite of one serSats record...
+#define BN220_SER_SATS_MAX(n) (48 + (size_t)(n) * BN220_SER_SAT_MAX) // ...in total
+
+/**
+ * @brief  Render fixes until the buffer cannot take another record.
+ *
+ * @param[out] out     Output buffer (not NUL-terminated).
+ * @param[in]  cap     Size of @p out.
+ * @param[in]  format  JSON or CSV.
+ * @param[in]  device  Device id per fix, or NULL to leave the field out.
+ * @param[in]  fix     Fixes.
+ * @param[in]  n       Number of fixes.
+ * @param[out] done    Fixes rendered; optional.
+ *
+ * Returns the number of bytes written.
+ */
+size_t serFixes(char *out, size_t cap, BN220_SerFormat format, const uint32_t *device,
+                const BN220_Fix *fix, size_t n, size_t *done);
+
+/* CSV header line for serFixes(); 0 if @p cap is too small. */
+size_t serCsvFixHeader(char *out, size_t cap, int withDevice);
+
+/**
+ * @brief  Render one epoch's satellite table.
+ *
+ * @param[out] out     Output buffer (not NUL-terminated).
+ * @param[in]  cap     Size of @p out; nothing is written below
+ *                     BN220_SER_SATS_MAX(n).
+ * @param[in]  format  JSON (one record) or CSV (one row per satellite).
+ * @param[in]  utc_ms  Epoch time, e.g. BN220_Fix.utc_ms.
+ * @param[in]  sats    Satellites, e.g. gps.sats.
+ * @param[in]  n       Number of satellites, e.g. gps.satCount.
+ *
+ * Returns the number of bytes written.  A talker outside 'A'-'Z' is
+ * written as '?'.
+ */
+size_t serSats(char *out, size_t cap, BN220_SerFormat format, int64_t utc_ms,
+               const BN220_Sat *sats, size_t n);
+
+/* CSV header line for serSats(); 0 if @p cap is too small. */
+size_t serCsvSatHeader(char *out, size_t cap);
+
+#if BN220_ENABLE_STATS
+/**
+ * @brief  Render parser counters as one record; 0 if @p cap is below
+ *         BN220_SER_STATS_MAX.
+ */
+size_t serStats(char *out, size_t cap, BN220_SerFormat format, const BN220_Stats *stats);
+
+/* CSV header line for serStats(); 0 if @p cap is too small. */
+size_t serCsvStatsHeader(char *out, size_t cap);
+#endif
+
+#endif /* INC_BN220_SERIALIZE_H_ */
@@ -0,0 +1,218 @@
+/*
+ * BN220_sigmon.c — Signal-quality monitor
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_sigmon.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Running C/N0 statistics and interference/spoofing events
+ * ---------------------------------------------------------------------------
+ */
+
+#include "BN220_sigmon.h"
+#include <math.h>
+
+#define SIG_BIT(type) (1u << ((type) - 1))
+
+static void sigmonEmit(BN220_SigMon *m, uint8_t type, uint8_t active, const BN220_SigSlot *s,
+                       float value, uint32_t now_ms) {
+    if (!m->onEvent)
+        return;
+    BN220_SigEvent ev = { type, active, s ? s->prn : 0, s ? s->talker : 0, value, now_ms };
+    m->onEvent(m->user, &ev);
+}
+
+// Raise or clear an event kept in *flags, on the edges only
+static void sigmonEdge(BN220_SigMon *m, uint8_t *flags, uint8_t type, int raise, int clear,
+                       const BN220_SigSlot *s, float value, uint32_t now_ms) {
+    uint8_t bit = (uint8_t)SIG_BIT(type);
+    if (!(*flags & bit) && raise) {
+        *flags |= bit;
+        sigmonEmit(m, type, 1, s, value, now_ms);
+    } else if ((*flags & bit) && clear) {
+        *flags &= (uint8_t)~bit;
+        sigmonEmit(m, type, 0, s, value, now_ms);
+    }
+}
+
+static BN220_SigSlot *sigmonSlot(BN220_SigMon *m, const BN220_Sat *sat) {
+    BN220_SigSlot *empty = NULL;
+    for (int i = 0; i < BN220_SIGMON_SLOTS; i++) {
+        BN220_SigSlot *s = &m->slot[i];
+        if (s->prn == sat->prn && s->talker == sat->talker)
+            return s;
+        if (!s->prn && !empty)
+            empty = s;
+    }
+    if (empty) {
+        empty->prn    = sat->prn;
+        empty->talker = sat->talker;
+    }
+    return empty;
+}
+
+static void sigmonLearn(float alpha, float *mean, float *var, float x, int first) {
+    if (first) {
+        *mean = x;
+        *var  = 0.0f;
+        return;
+    }
+    float d = x - *mean;
+    *mean += alpha * d;
+    *var   = (1.0f - alpha) * (*var + alpha * d * d);
+}
+
+
+void sigmonInit(BN220_SigMon *m, BN220_SigEventFn onEvent, void *user) {
+    memset(m, 0, sizeof(*m));
+    m->alpha       = 0.05f;
+    m->dropDb      = 6.0f;
+    m->flatDb      = 1.5f;
+    m->jumpDb      = 8.0f;
+    m->jumpSigma   = 4.0f;
+    m->maxCn0      = 55;
+    m->minSats     = 4;
+    m->warmup      = 10;
+    m->staleEpochs = 30;
+    m->maxHold     = 120;
+    m->onEvent     = onEvent;
+    m->user        = user;
+}
+
+void sigmonUpdate(BN220_SigMon *m, const BN220_Sat *sats, size_t n, uint32_t now_ms) {
+    uint8_t prevTracked = m->tracked;
+    float   sum = 0.0f, sum2 = 0.0f;
+    int     tracked = 0;
+
+    // 1) This epoch's C/N0, per slot and across satellites
+    for (int i = 0; i < BN220_SIGMON_SLOTS; i++)
+        m->slot[i].snr = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (!sats[i].snr || !sats[i].prn)
+            continue;
+        BN220_SigSlot *s = sigmonSlot(m, &sats[i]);
+        if (s && s->snr)
+            continue;   // listed twice
+        if (s)
+            s->snr = sats[i].snr;
+        tracked++;
+        sum  += sats[i].snr;
+        sum2 += (float)sats[i].snr * sats[i].snr;
+    }
+    m->tracked = (uint8_t)(tracked > 255 ? 255 : tracked);
+
+    // 2) Change against the baselines; a satellite lost this epoch counts as down
+    int   nBase = 0, nDown = 0, nTracked = 0, lost = 0;
+    float sumDelta = 0.0f;
+    for (int i = 0; i < BN220_SIGMON_SLOTS; i++) {
+        const BN220_SigSlot *s = &m->slot[i];
+        if (!s->prn || s->samples < m->warmup)
+            continue;
+        if (s->snr) {
+            float d = s->snr - s->mean;
+            sumDelta += d;
+            nTracked++;
+            nDown += d <= -0.5f * m->dropDb;
+        } else if (s->misses == 0) {
+            lost++;
+            nDown++;
+        } else {
+            continue;
+        }
+        nBase++;
+    }
+    m->meanDelta = nTracked ? sumDelta / (float)nTracked : 0.0f;
+    float mean   = tracked ? sum / (float)tracked : 0.0f;
+    float var    = tracked ? sum2 / (float)tracked - mean * mean : 0.0f;
+    m->spread    = var > 0.0f ? sqrtf(var) : 0.0f;
+
+    // 3) Aggregate events
+    int drop = nBase >= m->minSats && nDown * 4 >= nBase * 3 &&
+               (!nTracked || m->meanDelta <= -m->dropDb);
+    int recovered = nTracked >= m->minSats && m->meanDelta > -0.5f * m->dropDb;
+    sigmonEdge(m, &m->active, BN220_SIG_UNIFORM_DROP, drop, recovered, NULL, m->meanDelta, now_ms);
+
+    int massLoss = lost >= 3 && lost * 2 >= prevTracked;
+    if (massLoss && !(m->active & SIG_BIT(BN220_SIG_MASS_LOSS)))
+        m->lossRef = prevTracked;
+    sigmonEdge(m, &m->active, BN220_SIG_MASS_LOSS, massLoss, tracked * 4 >= m->lossRef * 3, NULL,
+               massLoss ? (float)lost : (float)tracked, now_ms);
+
+    int judgeSpread = tracked >= 2 * m->minSats;
+    sigmonEdge(m, &m->active, BN220_SIG_FLAT_CN0, judgeSpread && m->spread < m->flatDb,
+               !judgeSpread || m->spread > 1.5f * m->flatDb, NULL, m->spread, now_ms);
+
+    // 4) Baselines stay held while a drop is active, up to maxHold epochs
+    int dropping = (m->active & SIG_BIT(BN220_SIG_UNIFORM_DROP)) != 0;
+    int held     = dropping && m->hold < m->maxHold;
+    m->hold      = dropping ? (uint16_t)(m->hold + held) : 0;
+    if (tracked && !held)
+        sigmonLearn(m->alpha, &m->aggMean, &m->aggVar, mean, m->aggMean == 0.0f);
+
+    // 5) Per-satellite events and baselines
+    for (int i = 0; i < BN220_SIGMON_SLOTS; i++) {
+        BN220_SigSlot *s = &m->slot[i];
+        if (!s->prn)
+            continue;
+        if (!s->snr) {
+            // Gone long enough: clear its events and free the slot
+            if (s->misses < UINT8_MAX)
+                s->misses++;
+            if (s->misses >= m->staleEpochs) {
+                sigmonEdge(m, &s->flags, BN220_SIG_HIGH_CN0, 0, 1, s, 0.0f, now_ms);
+                sigmonEdge(m, &s->flags, BN220_SIG_PRN_JUMP, 0, 1, s, 0.0f, now_ms);
+                memset(s, 0, sizeof(*s));
+            }
+            continue;
+        }
+        s->misses = 0;
+
+        sigmonEdge(m, &s->flags, BN220_SIG_HIGH_CN0, s->snr >= m->maxCn0, s->snr + 3 < m->maxCn0, s,
+                   (float)s->snr, now_ms);
+        if (s->samples >= m->warmup && !held) {
+            // Measured against the common shift, so a sky-wide change is not
+            // reported once per satellite
+            float d = s->snr - s->mean - m->meanDelta, ad = fabsf(d);
+            sigmonEdge(m, &s->flags, BN220_SIG_PRN_JUMP,
+                       ad >= m->jumpDb && ad * ad >= m->jumpSigma * m->jumpSigma * s->var,
+                       ad < 0.5f * m->jumpDb, s, d, now_ms);
+        }
+        if (!held) {
+            sigmonLearn(m->alpha, &s->mean, &s->var, (float)s->snr, s->samples == 0);
+            if (s->samples < UINT16_MAX)
+                s->samples++;
+        }
+    }
+    m->epochs++;
+}
+
+#if BN220_ENABLE_GSV
+int sigmonUpdateGps(BN220_SigMon *m, const BN220_GPS *gps_data, uint32_t now_ms) {
+    if (m->haveSeq && m->seq == gps_data->satSeq)
+        return 0;
+    m->seq     = gps_data->satSeq;
+    m->haveSeq = 1;
+    sigmonUpdate(m, gps_data->sats, gps_data->satCount, now_ms);
+    return 1;
+}
+#endif
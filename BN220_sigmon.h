@@ -0,0 +1,163 @@
+/*
+ * BN220_sigmon.h — Signal-quality monitor
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_sigmon.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Running C/N0 statistics and interference/spoofing events
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_SIGMON_H_
+#define INC_BN220_SIGMON_H_
+
+#include "BN220.h"
+
+/*
+ * Running C/N0 monitor for RF interference and spoofing indicators, fed
+ * once per epoch with the GSV satellite table.
+ *
+ * Every tracked satellite (PRN and talker) keeps an exponentially weighted
+ * mean and variance of its own C/N0, so each epoch is compared with that
+ * satellite's recent history.  The baseline is not binned by elevation:
+ * with the default alpha it spans about 20 epochs, short next to the time
+ * a satellite takes to rise or set, so it follows the slow elevation trend
+ * on its own.  A satellite missing for staleEpochs loses its slot and
+ * starts a fresh baseline when it returns.  On top of that:
+ *   - UNIFORM_DROP: most satellites lose C/N0 together (wideband jamming;
+ *     a blockage only shades part of the sky),
+ *   - MASS_LOSS: a large part of the tracked satellites disappears at once,
+ *   - FLAT_CN0: C/N0 is nearly equal across satellites, which a single
+ *     spoofing transmitter produces and the real sky does not,
+ *   - HIGH_CN0: one satellite above any plausible open-sky level,
+ *   - PRN_JUMP: one satellite far outside its own history, beyond the
+ *     shift common to all satellites.
+ * Events are raised and cleared on edges, with hysteresis.  While a drop
+ * is active the per-satellite baselines are held, up to maxHold epochs,
+ * so the attack is not learned as the new normal.
+ *
+ * Memory is a fixed table of BN220_SIGMON_SLOTS satellites; a satellite
+ * that has left the sky frees its slot.
+ */
+
+#ifndef BN220_SIGMON_SLOTS
+#define BN220_SIGMON_SLOTS 32  // satellites with a baseline, 16 bytes each
+#endif
+
+typedef enum {
+    BN220_SIG_UNIFORM_DROP = 1,  // value: mean C/N0 change in dB (negative)
+    BN220_SIG_MASS_LOSS,         // value: satellites lost this epoch
+    BN220_SIG_FLAT_CN0,          // value: C/N0 spread across satellites in dB
+    BN220_SIG_HIGH_CN0,          // value: C/N0 of the satellite in dB-Hz
+    BN220_SIG_PRN_JUMP           // value: change against its mean, less the common shift, in dB
+} BN220_SigEventType;
+
+typedef struct {
+    uint8_t  type;     // BN220_SigEventType
+    uint8_t  active;   // 1 raised, 0 cleared
+    uint8_t  prn;      // HIGH_CN0 / PRN_JUMP: the satellite, else 0
+    char     talker;   // constellation of prn, as in BN220_Sat
+    float    value;
+    uint32_t time_ms;  // now_ms of the epoch
+} BN220_SigEvent;
+
+typedef void (*BN220_SigEventFn)(void *user, const BN220_SigEvent *ev);
+
+typedef struct {
+    uint8_t  prn;      // 0 = free
+    char     talker;
+    uint8_t  flags;    // raised per-satellite events
+    uint8_t  misses;   // epochs since last tracked
+    uint8_t  snr;      // C/N0 this epoch, 0 = not tracked
+    uint8_t  reserved;
+    uint16_t samples;  // epochs folded into mean/var (saturates)
+    float    mean;     // EWMA of C/N0, dB-Hz
+    float    var;      // EW variance, dB²
+} BN220_SigSlot;
+
+typedef struct {
+    // Tuning; set by sigmonInit, may be changed afterwards
+    float    alpha;        // EWMA weight of a new epoch
+    float    dropDb;       // mean fall that counts as a uniform drop
+    float    flatDb;       // cross-satellite spread below which C/N0 is "flat"
+    float    jumpDb;       // minimum single-satellite deviation
+    float    jumpSigma;    // ...and in standard deviations of its history
+    uint8_t  maxCn0;       // plausible open-sky ceiling, dB-Hz
+    uint8_t  minSats;      // satellites with a baseline needed to judge
+    uint8_t  warmup;       // epochs before a satellite has a baseline
+    uint8_t  staleEpochs;  // epochs unseen before a slot is reused
+    uint16_t maxHold;      // epochs the baselines stay held during a drop
+
+    // Running state
+    BN220_SigSlot slot[BN220_SIGMON_SLOTS];
+    uint8_t  active;       // raised aggregate events, bit (type - 1)
+    uint8_t  tracked;      // satellites with C/N0 this epoch
+    uint8_t  lossRef;      // tracked count before a MASS_LOSS
+    uint8_t  seq;          // satSeq of the last table (sigmonUpdateGps)
+    uint8_t  haveSeq;
+    uint16_t hold;         // epochs the baselines have been held
+    uint32_t epochs;
+    float    aggMean;      // EWMA of the epoch mean C/N0, dB-Hz
+    float    aggVar;
+    float    meanDelta;    // last epoch: mean change against the baselines
+    float    spread;       // last epoch: C/N0 standard deviation across satellites
+
+    BN220_SigEventFn onEvent;
+    void            *user;
+} BN220_SigMon;
+
+/**
+ * @brief  Initialise a monitor.
+ *
+ * @param[out] m        Monitor state.
+ * @param[in]  onEvent  Event callback; may be NULL.
+ * @param[in]  user     Passed to @p onEvent.
+ *
+ * Defaults: alpha 0.05, 6 dB drop, 1.5 dB flat spread, 8 dB / 4 sigma
+ * jump, 55 dB-Hz ceiling, 4 satellites, 10 epoch warm-up, 30 epochs
+ * stale, 120 epochs hold.
+ */
+void sigmonInit(BN220_SigMon *m, BN220_SigEventFn onEvent, void *user);
+
+/**
+ * @brief  Process one epoch's satellite table.
+ *
+ * @param[in]  sats    Satellites in view; snr 0 counts as not tracked.
+ * @param[in]  n       Entries in @p sats.
+ * @param[in]  now_ms  Timestamp copied into the events, e.g. HAL_GetTick().
+ */
+void sigmonUpdate(BN220_SigMon *m, const BN220_Sat *sats, size_t n, uint32_t now_ms);
+
+#if BN220_ENABLE_GSV
+/**
+ * @brief  sigmonUpdate() on ctx->gps when its table is new (satSeq).
+ *
+ * Call from ctx->onSats, which fires once per complete table even while
+ * the receiver has no fix; onEpoch does not fire then, and a jammed
+ * receiver typically loses its fix.  Returns 1 when a table was processed.
+ */
+int sigmonUpdateGps(BN220_SigMon *m, const BN220_GPS *gps_data, uint32_t now_ms);
+#endif
+
+#endif /* INC_BN220_SIGMON_H_ */
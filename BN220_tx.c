@@ -0,0 +1,232 @@
+/*
+ * BN220_tx.c — DMA transmit queue
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_tx.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Contiguous-frame byte rings, interrupt-safe transfer chaining and
+ *          the host UART simulation.
+ * ---------------------------------------------------------------------------
+ */
+
+#include "BN220_tx.h"
+
+#define TX_WRAP 0xFFFFu   // length marker: the next frame starts at offset 0
+
+/*
+ * Interrupt masking around the start decision, and a barrier so a frame's
+ * bytes are in memory before its ring head is published.
+ */
+#if BN220_PLATFORM_HAL
+#define TX_LOCK()     uint32_t txPrimask = __get_PRIMASK(); __disable_irq()
+#define TX_UNLOCK()   __set_PRIMASK(txPrimask)
+#define TX_BARRIER()  __DMB()
+#else
+#define TX_LOCK()     do { } while (0)
+#define TX_UNLOCK()   do { } while (0)
+#define TX_BARRIER()  __asm__ __volatile__("" ::: "memory")
+#endif
+
+static void txPut16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static uint16_t txGet16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+
+/* --- Rings (one producer, one consumer) ----------------------------------- */
+
+// Reserve room for a 2-byte length plus @p len contiguous bytes; NULL if full
+static uint8_t *txRingReserve(BN220_TxRing *r, uint16_t len, uint16_t *at) {
+    uint32_t need = 2u + len;
+    uint16_t h = r->head, t = r->tail;
+
+    if (h >= t) {
+        // Free space is [h, size) then [0, t); one byte always stays unused
+        if (h + need < r->size || (h + need == r->size && t != 0)) {
+            *at = h;
+            return r->buf + h;
+        }
+        if (need >= t)
+            return NULL;
+        if (r->size - h >= 2)
+            txPut16(r->buf + h, TX_WRAP);
+        *at = 0;
+        return r->buf;
+    }
+    if (h + need >= t)
+        return NULL;
+    *at = h;
+    return r->buf + h;
+}
+
+// Oldest frame, skipping a wrap; NULL when empty
+static const uint8_t *txRingPeek(BN220_TxRing *r, uint16_t *len) {
+    uint16_t t = r->tail;
+    if (t == r->head)
+        return NULL;
+    if (r->size - t < 2 || txGet16(r->buf + t) == TX_WRAP) {
+        t = 0;
+        r->tail = 0;
+        if (t == r->head)
+            return NULL;
+    }
+    *len = txGet16(r->buf + t);
+    return r->buf + t + 2;
+}
+
+static void txRingRelease(BN220_TxRing *r) {
+    uint16_t len;
+    if (!txRingPeek(r, &len))
+        return;
+    uint32_t t = r->tail + 2u + len;
+    r->tail = (uint16_t)(t == r->size ? 0 : t);
+}
+
+
+/* --- Queue ---------------------------------------------------------------- */
+
+// Start the next frame if the line is idle; interrupts masked or in the ISR
+static void txKick(BN220_TxQueue *q) {
+    if (q->busy)
+        return;
+    for (uint8_t prio = BN220_TX_CONFIG; prio <= BN220_TX_BULK; prio++) {
+        uint16_t       len;
+        const uint8_t *data = txRingPeek(&q->ring[prio], &len);
+        if (!data)
+            continue;
+        q->busy    = 1;
+        q->curPrio = prio;
+        if (!q->start(q->port, data, len))
+            q->busy = 0;
+        return;
+    }
+}
+
+void txInit(BN220_TxQueue *q, BN220_TxStartFn start, void *port) {
+    memset(q, 0, sizeof(*q));
+    q->ring[BN220_TX_CONFIG].buf  = q->configBuf;
+    q->ring[BN220_TX_CONFIG].size = BN220_TX_CONFIG_BYTES;
+    q->ring[BN220_TX_BULK].buf    = q->bulkBuf;
+    q->ring[BN220_TX_BULK].size   = BN220_TX_BULK_BYTES;
+    q->start = start;
+    q->port  = port;
+}
+
+int txQueue(BN220_TxQueue *q, BN220_TxPriority prio, const uint8_t *data, uint16_t len) {
+    BN220_TxRing *r = &q->ring[prio];
+    uint16_t      at;
+
+    // 1) An empty ring restarts at offset 0 so a large frame finds contiguous room
+    if (r->head == r->tail) {
+        TX_LOCK();
+        r->head = r->tail = 0;
+        TX_UNLOCK();
+    }
+
+    // 2) Copy the frame behind its length, then publish it
+    uint8_t *slot = len && len != TX_WRAP ? txRingReserve(r, len, &at) : NULL;
+    if (!slot) {
+        q->dropped[prio]++;
+        return 0;
+    }
+    txPut16(slot, len);
+    memcpy(slot + 2, data, len);
+    TX_BARRIER();
+    uint32_t h = at + 2u + len;
+    r->head = (uint16_t)(h == r->size ? 0 : h);
+
+    // 3) Start it if the line is idle
+    txPoll(q);
+    return 1;
+}
+
+void txComplete(BN220_TxQueue *q) {
+    if (!q->busy)
+        return;
+    txRingRelease(&q->ring[q->curPrio]);
+    q->sent[q->curPrio]++;
+    q->busy = 0;
+    txKick(q);
+}
+
+void txPoll(BN220_TxQueue *q) {
+    TX_LOCK();
+    txKick(q);
+    TX_UNLOCK();
+}
+
+int txIdle(const BN220_TxQueue *q) {
+    return !q->busy && q->ring[0].head == q->ring[0].tail && q->ring[1].head == q->ring[1].tail;
+}
+
+int txWriteConfig(void *user, const uint8_t *data, uint16_t len) {
+    return txQueue((BN220_TxQueue *)user, BN220_TX_CONFIG, data, len);
+}
+
+int txWriteBulk(void *user, const uint8_t *data, uint16_t len) {
+    return txQueue((BN220_TxQueue *)user, BN220_TX_BULK, data, len);
+}
+
+
+#if !BN220_PLATFORM_HAL
+/* --- Host simulation ------------------------------------------------------ */
+
+void txSimInit(BN220_TxSim *sim, BN220_TxQueue *q, uint32_t baud, BN220_WriteFn sink,
+               void *sinkUser) {
+    memset(sim, 0, sizeof(*sim));
+    sim->q        = q;
+    sim->baud     = baud ? baud : 9600;
+    sim->sink     = sink;
+    sim->sinkUser = sinkUser;
+}
+
+int txSimStart(void *port, const uint8_t *data, uint16_t len) {
+    BN220_TxSim *sim = port;
+    if (sim->active)
+        return 0;
+    sim->active    = 1;
+    sim->data      = data;
+    sim->len       = len;
+    sim->doneAt_us = sim->now_us + ((uint64_t)len * 10 * 1000000 + sim->baud - 1) / sim->baud;
+    return 1;
+}
+
+void txSimAdvance(BN220_TxSim *sim, uint64_t now_us) {
+    // Complete every transfer that ends by now_us; each completion may chain the next
+    while (sim->active && sim->doneAt_us <= now_us) {
+        sim->now_us = sim->doneAt_us;
+        sim->active = 0;
+        if (sim->sink)
+            sim->sink(sim->sinkUser, sim->data, sim->len);
+        sim->bytes += sim->len;
+        txComplete(sim->q);
+    }
+    if (now_us > sim->now_us)
+        sim->now_us = now_us;
+}
+#endif
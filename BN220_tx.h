@@ -0,0 +1,165 @@
+/*
+ * BN220_tx.h — DMA transmit queue
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_tx.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Two-priority, DMA-chained transmit queue for UBX commands and RTCM
+ *          corrections, with a host UART simulation.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_TX_H_
+#define INC_BN220_TX_H_
+
+#include "BN220.h"
+#include "BN220_ubx.h"
+
+/*
+ * Non-blocking transmit queue towards the receiver (UBX configuration,
+ * RTCM corrections).
+ *
+ * Frames are copied into one of two byte rings and sent one at a time by
+ * a DMA transfer started through a port hook; the transfer-complete
+ * interrupt calls txComplete(), which releases the frame and chains the
+ * next one.  The config ring is always served first, so an ACK-sensitive
+ * CFG message waits for at most the bulk frame already on the wire, never
+ * behind a backlog of RTCM.  A frame is stored contiguously, so DMA reads
+ * it straight from the ring without a copy.
+ *
+ * Producers run in thread context, txComplete in the DMA/UART interrupt;
+ * only the decision to start a transfer is made with interrupts masked.
+ */
+
+#ifndef BN220_TX_CONFIG_BYTES
+#define BN220_TX_CONFIG_BYTES 512  // config ring, incl. 2 bytes per frame
+#endif
+
+#ifndef BN220_TX_BULK_BYTES
+#define BN220_TX_BULK_BYTES 2048   // bulk ring, fits an RTCM3 frame (<= 1029 bytes)
+#endif
+
+typedef enum {
+    BN220_TX_CONFIG = 0,  // CFG/MGA commands: served first
+    BN220_TX_BULK         // RTCM corrections and other streaming data
+} BN220_TxPriority;
+
+/**
+ * @brief  Start sending @p len bytes, e.g. HAL_UART_Transmit_DMA.
+ *
+ * Returns 1 when the transfer was started; completion must then be
+ * reported with txComplete().  On 0 the frame stays queued and is retried
+ * by the next txQueue/txPoll.
+ */
+typedef int (*BN220_TxStartFn)(void *port, const uint8_t *data, uint16_t len);
+
+typedef struct {
+    uint8_t          *buf;
+    uint16_t          size;
+    volatile uint16_t head;  // written by the producer
+    volatile uint16_t tail;  // advanced on completion
+} BN220_TxRing;
+
+typedef struct {
+    BN220_TxRing     ring[2];           // indexed by BN220_TxPriority
+    BN220_TxStartFn  start;
+    void            *port;
+    volatile uint8_t busy;              // a transfer is in flight
+    uint8_t          curPrio;           // ring of the frame in flight
+    uint32_t         sent[2];           // frames completed per priority
+    uint32_t         dropped[2];        // frames refused for lack of room
+    uint8_t          configBuf[BN220_TX_CONFIG_BYTES];
+    uint8_t          bulkBuf[BN220_TX_BULK_BYTES];
+} BN220_TxQueue;
+
+/**
+ * @brief  Initialise an empty queue.
+ *
+ * @param[out] q      Queue.
+ * @param[in]  start  Transfer hook.
+ * @param[in]  port   Passed to @p start (e.g. &huart1).
+ */
+void txInit(BN220_TxQueue *q, BN220_TxStartFn start, void *port);
+
+/**
+ * @brief  Copy one frame into the queue and start sending if idle.
+ *
+ * Returns 0 (and counts a drop) when the ring has no room; a config frame
+ * is never dropped to make room for bulk data or vice versa.
+ */
+int txQueue(BN220_TxQueue *q, BN220_TxPriority prio, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief  Transfer finished: release the frame and start the next one.
+ *
+ * Call from the transfer-complete interrupt (HAL_UART_TxCpltCallback).
+ */
+void txComplete(BN220_TxQueue *q);
+
+/**
+ * @brief  Retry a start that the port refused; harmless when busy.
+ */
+void txPoll(BN220_TxQueue *q);
+
+/**
+ * @brief  1 when nothing is queued or in flight.
+ */
+int txIdle(const BN220_TxQueue *q);
+
+/*
+ * BN220_WriteFn adapters, user = BN220_TxQueue *, so gpsAidingInject,
+ * gpsRateUpdate and ubxSend queue instead of blocking.
+ */
+int txWriteConfig(void *user, const uint8_t *data, uint16_t len);
+int txWriteBulk(void *user, const uint8_t *data, uint16_t len);
+
+#if !BN220_PLATFORM_HAL
+/*
+ * Host simulation of a UART with DMA: a started frame takes 10 bit times
+ * per byte at @p baud, then is delivered to @p sink and completed.
+ */
+typedef struct {
+    BN220_TxQueue *q;
+    uint32_t       baud;
+    uint64_t       now_us;
+    uint64_t       doneAt_us;   // end of the transfer in flight
+    const uint8_t *data;
+    uint16_t       len;
+    uint8_t        active;
+    BN220_WriteFn  sink;        // receives each frame as it completes; may be NULL
+    void          *sinkUser;
+    uint64_t       bytes;       // delivered so far
+} BN220_TxSim;
+
+void txSimInit(BN220_TxSim *sim, BN220_TxQueue *q, uint32_t baud, BN220_WriteFn sink,
+               void *sinkUser);
+
+/* BN220_TxStartFn of the simulator, port = BN220_TxSim *. */
+int txSimStart(void *port, const uint8_t *data, uint16_t len);
+
+/* Let time pass up to @p now_us, completing (and chaining) transfers. */
+void txSimAdvance(BN220_TxSim *sim, uint64_t now_us);
+#endif
+
+#endif /* INC_BN220_TX_H_ */
@@ -0,0 +1,82 @@
+/*
+ * BN220_ubx.c — UBX frame helpers for the BN-220 GPS receiver
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_ubx.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   UBX framing (sync, header, Fletcher-8 checksum) for commands sent
+ *          to the BN-220.
+ * ---------------------------------------------------------------------------
+ */
+
+#include "BN220_ubx.h"
+
+#if BN220_ENABLE_UBX
+
+// Largest payload we ever build on the stack (MGA-INI-TIME_UTC is 24 bytes)
+#define UBX_MAX_PAYLOAD  64
+
+
+uint16_t ubxBuild(uint8_t *out, uint16_t out_len, uint8_t cls, uint8_t id,
+                  const uint8_t *payload, uint16_t len) {
+    if (!out || (uint32_t)len + UBX_FRAME_OVERHEAD > out_len)
+        return 0;
+
+    // 1) Header
+    out[0] = UBX_SYNC_1;
+    out[1] = UBX_SYNC_2;
+    out[2] = cls;
+    out[3] = id;
+    ubxPutU16(&out[4], len);
+    if (len)
+        memcpy(&out[6], payload, len);
+
+    // 2) 8-bit Fletcher over class, id, length and payload
+    uint8_t ck_a = 0, ck_b = 0;
+    for (uint16_t i = 2; i < 6 + len; i++) {
+        ck_a += out[i];
+        ck_b += ck_a;
+    }
+    out[6 + len] = ck_a;
+    out[7 + len] = ck_b;
+
+    return (uint16_t)(len + UBX_FRAME_OVERHEAD);
+}
+
+
+int ubxSend(BN220_WriteFn write, void *user, uint8_t cls, uint8_t id,
+            const uint8_t *payload, uint16_t len) {
+    uint8_t frame[UBX_MAX_PAYLOAD + UBX_FRAME_OVERHEAD];
+
+    if (!write)
+        return 0;
+
+    uint16_t n = ubxBuild(frame, sizeof(frame), cls, id, payload, len);
+    if (!n)
+        return 0;
+
+    return write(user, frame, n);
+}
+
+#endif /* BN220_ENABLE_UBX */
@@ -0,0 +1,99 @@
+/*
+ * BN220_ubx.h — UBX frame helpers for the BN-220 GPS receiver
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    BN220_ubx.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Builders for the UBX binary frames sent to the u-blox chipset
+ *          inside the BN-220 (aiding, configuration).  Frames are written
+ *          through a caller-provided port hook so the driver never touches
+ *          the UART directly.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef INC_BN220_UBX_H_
+#define INC_BN220_UBX_H_
+
+#include "BN220.h"
+
+#define UBX_SYNC_1          0xB5
+#define UBX_SYNC_2          0x62
+#define UBX_FRAME_OVERHEAD  8    // sync(2) + class/id(2) + length(2) + checksum(2)
+
+#define UBX_CLASS_CFG       0x06
+#define UBX_CLASS_MGA       0x13
+
+#define UBX_CFG_RATE        0x08
+#define UBX_MGA_INI         0x40
+
+/**
+ * @brief  Port hook used to send bytes to the receiver.
+ *
+ * @param[in] user  Opaque pointer given together with the hook.
+ * @param[in] data  Bytes to send.
+ * @param[in] len   Number of bytes.
+ *
+ * Returns 1 when the bytes were accepted, 0 otherwise.
+ */
+typedef int (*BN220_WriteFn)(void *user, const uint8_t *data, uint16_t len);
+
+/**
+ * @brief  Store little-endian values into a UBX payload.
+ */
+static inline void ubxPutU16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void ubxPutU32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief  Wrap @p payload into a complete UBX frame.
+ *
+ * @param[out] out      Destination, at least @p len + UBX_FRAME_OVERHEAD bytes.
+ * @param[in]  out_len  Size of @p out.
+ * @param[in]  cls      Message class.
+ * @param[in]  id       Message id.
+ * @param[in]  payload  Payload bytes (may be NULL when @p len is 0).
+ * @param[in]  len      Payload length.
+ *
+ * Returns the frame length, or 0 when @p out is too small.
+ */
+uint16_t ubxBuild(uint8_t *out, uint16_t out_len, uint8_t cls, uint8_t id,
+                  const uint8_t *payload, uint16_t len);
+
+/**
+ * @brief  Build a frame and send it through @p write in one go.
+ *
+ * Returns 1 when the frame was accepted by the port hook.
+ */
+int ubxSend(BN220_WriteFn write, void *user, uint8_t cls, uint8_t id,
+            const uint8_t *payload, uint16_t len);
+
+#endif /* INC_BN220_UBX_H_ */
@@ -0,0 +1,278 @@
+/*
+ * bn220module.c — CPython bulk decoder
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    bn220module.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   bn220.decode(): runs gpsFeed over a buffer with the GIL released
+ *          and returns columns or records (numpy when available).
+ * ---------------------------------------------------------------------------
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "BN220.h"
+
+/*
+ * Column layout of the decoded fixes: name, offset in BN220_Fix, width,
+ * memoryview format, numpy dtype.
+ */
+typedef struct {
+    const char *name;
+    size_t      offset;
+    size_t      size;
+    const char *format;
+    const char *dtype;
+} FixColumn;
+
+static const FixColumn fixColumns[] = {
+    { "utc_ms",    offsetof(BN220_Fix, utc_ms),    8, "q", "i8" },
+    { "lat_e7",    offsetof(BN220_Fix, lat_e7),    4, "i", "i4" },
+    { "lon_e7",    offsetof(BN220_Fix, lon_e7),    4, "i", "i4" },
+    { "alt_mm",    offsetof(BN220_Fix, alt_mm),    4, "i", "i4" },
+    { "speed_cms", offsetof(BN220_Fix, speed_cms), 2, "H", "u2" },
+    { "hdop_c",    offsetof(BN220_Fix, hdop_c),    2, "H", "u2" },
+    { "sats",      offsetof(BN220_Fix, sats),      1, "B", "u1" },
+    { "fix",       offsetof(BN220_Fix, fix),       1, "B", "u1" },
+};
+#define FIX_COLUMNS (sizeof(fixColumns) / sizeof(fixColumns[0]))
+
+// Growable array filled from ctx.onEpoch while the GIL is released
+typedef struct {
+    BN220_Fix *fix;
+    size_t     n, cap;
+    int        oom;
+} FixSink;
+
+static void fixSinkEpoch(void *user, const BN220_Fix *fix) {
+    FixSink *s = user;
+    if (s->n == s->cap) {
+        size_t     cap = s->cap ? s->cap * 2 : 4096;
+        BN220_Fix *p   = realloc(s->fix, cap * sizeof(BN220_Fix));
+        if (!p) {
+            s->oom = 1;
+            return;
+        }
+        s->fix = p;
+        s->cap = cap;
+    }
+    s->fix[s->n++] = *fix;
+}
+
+
+// numpy.frombuffer(obj, dtype) when numpy is importable, else memoryview.cast
+static PyObject *wrapArray(PyObject *numpy, PyObject *raw, const char *format, const char *dtype) {
+    if (numpy)
+        return PyObject_CallMethod(numpy, "frombuffer", "Os", raw, dtype);
+
+    PyObject *view = PyMemoryView_FromObject(raw);
+    if (!view)
+        return NULL;
+    PyObject *cast = PyObject_CallMethod(view, "cast", "s", format);
+    Py_DECREF(view);
+    return cast;
+}
+
+static PyObject *recordDtype(PyObject *numpy) {
+    PyObject *names = PyList_New(0), *formats = PyList_New(0), *offsets = PyList_New(0);
+    PyObject *spec = NULL, *dtype = NULL;
+    if (!names || !formats || !offsets)
+        goto done;
+    for (size_t i = 0; i < FIX_COLUMNS; i++) {
+        PyObject *n = PyUnicode_FromString(fixColumns[i].name);
+        PyObject *f = PyUnicode_FromString(fixColumns[i].dtype);
+        PyObject *o = PyLong_FromSize_t(fixColumns[i].offset);
+        int bad = !n || !f || !o || PyList_Append(names, n) || PyList_Append(formats, f) ||
+                  PyList_Append(offsets, o);
+        Py_XDECREF(n);
+        Py_XDECREF(f);
+        Py_XDECREF(o);
+        if (bad)
+            goto done;
+    }
+    spec = Py_BuildValue("{sOsOsOsn}", "names", names, "formats", formats, "offsets", offsets,
+                         "itemsize", (Py_ssize_t)sizeof(BN220_Fix));
+    if (spec)
+        dtype = PyObject_CallMethod(numpy, "dtype", "O", spec);
+done:
+    Py_XDECREF(names);
+    Py_XDECREF(formats);
+    Py_XDECREF(offsets);
+    Py_XDECREF(spec);
+    return dtype;
+}
+
+
+PyDoc_STRVAR(decodeDoc,
+"decode(data, checksum='verify', layout='columns', stats=False)\n"
+"\n"
+"Run the streaming parser over a whole NMEA log and return one entry per\n"
+"GGA epoch.  data is any buffer: bytes, bytearray, memoryview or mmap.\n"
+"The GIL is released while parsing, so threads decoding different logs\n"
+"run in parallel.\n"
+"\n"
+"checksum: 'verify', 'skip' or 'report'.\n"
+"layout:   'columns' -> dict of arrays (utc_ms, lat_e7, lon_e7, alt_mm,\n"
+"          speed_cms, hdop_c, sats, fix); 'records' -> one structured\n"
+"          array of BN220_Fix.  Arrays are numpy arrays when numpy can be\n"
+"          imported, typed memoryviews otherwise.\n"
+"stats:    also return parser counters as (result, dict).");
+
+static PyObject *bn220Decode(PyObject *self, PyObject *args, PyObject *kwargs) {
+    static char *kwlist[] = { "data", "checksum", "layout", "stats", NULL };
+    Py_buffer   buf;
+    const char *checksum = "verify", *layout = "columns";
+    int         wantStats = 0;
+    (void)self;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "y*|ssp", kwlist, &buf, &checksum, &layout,
+                                     &wantStats))
+        return NULL;
+
+    // 1) Options
+    uint8_t policy;
+    if (!strcmp(checksum, "verify"))
+        policy = BN220_CS_VERIFY;
+    else if (!strcmp(checksum, "skip"))
+        policy = BN220_CS_SKIP;
+    else if (!strcmp(checksum, "report"))
+        policy = BN220_CS_REPORT;
+    else {
+        PyBuffer_Release(&buf);
+        return PyErr_Format(PyExc_ValueError, "unknown checksum policy '%s'", checksum);
+    }
+    int columns = !strcmp(layout, "columns");
+    if (!columns && strcmp(layout, "records")) {
+        PyBuffer_Release(&buf);
+        return PyErr_Format(PyExc_ValueError, "unknown layout '%s'", layout);
+    }
+
+    // 2) Parse without the GIL; the buffer export stays locked meanwhile
+    BN220_Context ctx;
+    FixSink       sink = { 0 };
+    Py_BEGIN_ALLOW_THREADS
+    gpsInit(&ctx);
+    ctx.csPolicy = policy;
+    ctx.onEpoch  = fixSinkEpoch;
+    ctx.user     = &sink;
+    gpsFeed(&ctx, (const uint8_t *)buf.buf, (size_t)buf.len);
+    Py_END_ALLOW_THREADS
+    PyBuffer_Release(&buf);
+
+    if (sink.oom) {
+        free(sink.fix);
+        return PyErr_NoMemory();
+    }
+
+    // 3) Output buffers, filled (transposed for columns) without the GIL
+    PyObject *numpy = PyImport_ImportModule("numpy");
+    if (!numpy)
+        PyErr_Clear();
+
+    PyObject *result = NULL;
+    if (!columns) {
+        PyObject *raw = PyBytes_FromStringAndSize((const char *)sink.fix,
+                                                  (Py_ssize_t)(sink.n * sizeof(BN220_Fix)));
+        if (raw && numpy) {
+            PyObject *dtype = recordDtype(numpy);
+            result = dtype ? PyObject_CallMethod(numpy, "frombuffer", "OO", raw, dtype) : NULL;
+            Py_XDECREF(dtype);
+        } else if (raw) {
+            result = PyMemoryView_FromObject(raw);
+        }
+        Py_XDECREF(raw);
+    } else {
+        PyObject *raw[FIX_COLUMNS] = { 0 };
+        char     *dst[FIX_COLUMNS];
+        int       ok = 1;
+        for (size_t c = 0; ok && c < FIX_COLUMNS; c++) {
+            raw[c] = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)(sink.n * fixColumns[c].size));
+            ok = raw[c] != NULL;
+            if (ok)
+                dst[c] = PyBytes_AS_STRING(raw[c]);
+        }
+        if (ok) {
+            Py_BEGIN_ALLOW_THREADS
+            for (size_t c = 0; c < FIX_COLUMNS; c++) {
+                const char *src  = (const char *)sink.fix + fixColumns[c].offset;
+                size_t      size = fixColumns[c].size;
+                for (size_t i = 0; i < sink.n; i++)
+                    memcpy(dst[c] + i * size, src + i * sizeof(BN220_Fix), size);
+            }
+            Py_END_ALLOW_THREADS
+            result = PyDict_New();
+        }
+        for (size_t c = 0; result && c < FIX_COLUMNS; c++) {
+            PyObject *arr = wrapArray(numpy, raw[c], fixColumns[c].format, fixColumns[c].dtype);
+            if (!arr || PyDict_SetItemString(result, fixColumns[c].name, arr)) {
+                Py_CLEAR(result);
+            }
+            Py_XDECREF(arr);
+        }
+        for (size_t c = 0; c < FIX_COLUMNS; c++)
+            Py_XDECREF(raw[c]);
+    }
+    Py_XDECREF(numpy);
+    free(sink.fix);
+
+    // 4) Optional parser counters
+    if (!result || !wantStats)
+        return result;
+#if BN220_ENABLE_STATS
+    PyObject *stats = Py_BuildValue("{sksksksksn}",
+                                    "sentences", (unsigned long)ctx.stats.sentences,
+                                    "decoded", (unsigned long)ctx.stats.decoded,
+                                    "checksum_errors", (unsigned long)ctx.stats.checksumErrors,
+                                    "overflows", (unsigned long)ctx.stats.overflows,
+                                    "epochs", (Py_ssize_t)sink.n);
+#else
+    PyObject *stats = Py_BuildValue("{sn}", "epochs", (Py_ssize_t)sink.n);
+#endif
+    if (!stats) {
+        Py_DECREF(result);
+        return NULL;
+    }
+    return Py_BuildValue("(NN)", result, stats);
+}
+
+
+static PyMethodDef bn220Methods[] = {
+    { "decode", (PyCFunction)(void (*)(void))bn220Decode, METH_VARARGS | METH_KEYWORDS, decodeDoc },
+    { NULL, NULL, 0, NULL }
+};
+
+static struct PyModuleDef bn220Module = {
+    PyModuleDef_HEAD_INIT, "bn220", "Bulk NMEA decoding with the BN220 C parser.", -1, bn220Methods,
+    NULL, NULL, NULL, NULL
+};
+
+PyMODINIT_FUNC PyInit_bn220(void) {
+    PyObject *m = PyModule_Create(&bn220Module);
+    if (m && PyModule_AddIntConstant(m, "FIX_SIZE", (long)sizeof(BN220_Fix))) {
+        Py_DECREF(m);
+        return NULL;
+    }
+    return m;
+}
@@ -0,0 +1,32 @@
+# setup.py — builds the bn220 CPython extension over the C parser
+#
+# Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+# MIT License, see the header of BN220.h.
+#
+#   cd python && python setup.py build_ext --inplace
+#
+# numpy is optional: when it is importable, bn220.decode returns numpy arrays.
+
+import os
+from setuptools import setup, Extension
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+bn220 = Extension(
+    "bn220",
+    sources=["bn220module.c", os.path.join(ROOT, "BN220.c")],
+    include_dirs=[ROOT],
+    define_macros=[
+        ("BN220_PLATFORM_HAL", "0"),
+        ("BN220_ENABLE_STATS", "1"),
+        ("BN220_ENABLE_LEGACY_PARSE", "0"),
+    ],
+    extra_compile_args=["-O2"],
+)
+
+setup(
+    name="bn220",
+    version="1.0",
+    description="Bulk NMEA decoding with the BN220 C parser",
+    ext_modules=[bn220],
+)
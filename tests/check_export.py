@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+#
+# check_export.py — parse back a document written by tests/test_export.c
+#
+# Reads the GPX, KML or GeoJSON document with the standard library (gzip,
+# xml.etree, json) and compares the document name, the segment structure
+# and every point against the raw points written next to it.  Numbers are
+# read as decimals, so a single wrong digit counts.
+#
+# Usage:  check_export.py gpx|kml|geojson out.doc out.raw [gzip]
+# Exit status is 0 when the document matches.
+
+import datetime
+import gzip
+import json
+import struct
+import sys
+import xml.etree.ElementTree as ET
+from decimal import Decimal
+
+NAME = 'Trip <1> & "2" \\ 3\t4'   # EXPORT_NAME in tests/test_export.c
+POINT = struct.Struct("<IqiiiBH")
+EPOCH = datetime.datetime(1970, 1, 1, tzinfo=datetime.timezone.utc)
+GPX = "{http://www.topografix.com/GPX/1/1}"
+KML = "{http://www.opengis.net/kml/2.2}"
+
+
+def fixed(text, decimals):
+    v = Decimal(text).scaleb(decimals)
+    if v != v.to_integral_value():
+        raise ValueError("%r has more than %d decimals" % (text, decimals))
+    return int(v)
+
+
+def utc_ms(text):
+    t = datetime.datetime.strptime(text, "%Y-%m-%dT%H:%M:%S.%fZ").replace(tzinfo=datetime.timezone.utc)
+    return (t - EPOCH) // datetime.timedelta(milliseconds=1)
+
+
+# Each parser returns (name, [segment, ...]); a segment is a list of points
+# with the fields that format carries, plus the segment properties if any
+def parse_gpx(doc):
+    trk = ET.fromstring(doc).find(GPX + "trk")
+    segs = []
+    for seg in trk.findall(GPX + "trkseg"):
+        segs.append(([(utc_ms(p.findtext(GPX + "time")), fixed(p.get("lat"), 7), fixed(p.get("lon"), 7),
+                       fixed(p.findtext(GPX + "ele"), 3), int(p.findtext(GPX + "sat")),
+                       fixed(p.findtext(GPX + "hdop"), 2)) for p in seg.findall(GPX + "trkpt")], None))
+    return trk.findtext(GPX + "name"), segs
+
+
+def parse_kml(doc):
+    d = ET.fromstring(doc).find(KML + "Document")
+    segs = []
+    for pm in d.findall(KML + "Placemark"):
+        ls = pm.find(KML + "LineString")
+        if ls.findtext(KML + "altitudeMode") != "absolute":
+            raise ValueError("altitudeMode is not absolute")
+        pts = []
+        for line in ls.findtext(KML + "coordinates").split():
+            lon, lat, alt = line.split(",")
+            pts.append((fixed(lat, 7), fixed(lon, 7), fixed(alt, 3)))
+        segs.append((pts, None))
+    return d.findtext(KML + "name"), segs
+
+
+def parse_geojson(doc):
+    fc = json.loads(doc, parse_float=Decimal, parse_int=Decimal)
+    if fc["type"] != "FeatureCollection":
+        raise ValueError("not a FeatureCollection")
+    segs = []
+    for f in fc["features"]:
+        if f["type"] != "Feature" or f["geometry"]["type"] != "LineString":
+            raise ValueError("not a LineString feature")
+        pts = [(fixed(lat, 7), fixed(lon, 7), fixed(alt, 3)) for lon, lat, alt in f["geometry"]["coordinates"]]
+        p = f["properties"]
+        segs.append((pts, (utc_ms(p["start"]), utc_ms(p["end"]), int(p["points"]))))
+    return fc["name"], segs
+
+
+def expected(fmt, raw):
+    segs = []
+    for seg, t, lat, lon, alt, sats, hdop in raw:
+        if seg == len(segs):
+            segs.append([])
+        if fmt == "gpx":
+            segs[seg].append((t, lat, lon, alt, sats, hdop))
+        else:
+            segs[seg].append((lat, lon, alt))
+    times = {}
+    for seg, t, *_ in raw:
+        times.setdefault(seg, []).append(t)
+    return segs, [(ts[0], ts[-1], len(ts)) for _, ts in sorted(times.items())]
+
+
+def main(fmt, doc_path, raw_path, gz):
+    with open(doc_path, "rb") as f:
+        doc = f.read()
+    with open(raw_path, "rb") as f:
+        raw = list(POINT.iter_unpack(f.read()))
+
+    # 1) Container
+    if gz != (doc[:2] == b"\x1f\x8b"):
+        print("FAIL: gzip header %s" % ("missing" if gz else "unexpected"))
+        return 1
+    text = gzip.decompress(doc) if gz else doc
+
+    # 2) Document
+    name, segs = {"gpx": parse_gpx, "kml": parse_kml, "geojson": parse_geojson}[fmt](text)
+    want, props = expected(fmt, raw)
+    failures = 0
+    if name != NAME:
+        print("FAIL: name %r" % name)
+        failures += 1
+    if len(segs) != len(want):
+        print("FAIL: %d segments, expected %d" % (len(segs), len(want)))
+        return 1
+    for i, ((pts, prop), exp) in enumerate(zip(segs, want)):
+        if pts != exp:
+            bad = next((j for j, (a, b) in enumerate(zip(pts, exp)) if a != b), min(len(pts), len(exp)))
+            print("FAIL: segment %d differs at point %d: %r != %r"
+                  % (i, bad, pts[bad:bad + 1], exp[bad:bad + 1]))
+            failures += 1
+        if prop is not None and prop != props[i]:
+            print("FAIL: segment %d properties %r, expected %r" % (i, prop, props[i]))
+            failures += 1
+        if failures > 10:
+            break
+
+    print("%s%s: %d points in %d segments parsed back, %d bytes"
+          % (fmt, " (gzip)" if gz else "", len(raw), len(segs), len(doc)))
+    print("FAILED" if failures else "OK")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    if len(sys.argv) not in (4, 5) or sys.argv[1] not in ("gpx", "kml", "geojson"):
+        print("usage: check_export.py gpx|kml|geojson out.doc out.raw [gzip]")
+        sys.exit(2)
+    sys.exit(main(sys.argv[1], sys.argv[2], sys.argv[3], len(sys.argv) == 5 and sys.argv[4] == "gzip"))
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+#
+# check_geom.py — geomDop against a numpy double-precision reference
+#
+# Generates random satellite tables and masks, runs them through
+# `test_geom -r` and checks:
+# - the selected count against the mask rules;
+# - the DOPs against diag(inv(G^T G)) in double precision when the geometry
+#   is well conditioned;
+# - that geomDop rejects geometry that is singular in double precision.
+#
+# Usage:  check_geom.py path/to/test_geom [tables]
+# Exit status is 0 when every table matches; 77 when numpy is not installed.
+
+import random
+import subprocess
+import sys
+
+try:
+    import numpy as np
+except ImportError:
+    print("skipped: numpy not installed")
+    sys.exit(77)
+
+NO_POS = 0xFFFF
+REL_TOL = 2e-3       # float32 Cholesky on a condition number below COND_OK
+COND_OK = 1e3
+COND_SINGULAR = 1e9
+
+
+def random_table(rng):
+    n = rng.randint(0, 24)
+    sats = []
+    for _ in range(n):
+        elev = rng.randint(0, 90)
+        azim = NO_POS if rng.random() < 0.05 else rng.randint(0, 359)
+        sats.append((elev, azim, rng.randint(0, 50), rng.randint(0, 1)))
+    kind = rng.random()
+    if kind < 0.05 and n >= 4:
+        # one elevation for all: the up and clock columns coincide
+        e = rng.randint(5, 85)
+        sats = [(e, a, s, u) for _, a, s, u in sats]
+    elif kind < 0.10 and n >= 4:
+        # clustered in one patch of sky
+        e0, a0 = rng.randint(10, 80), rng.randint(0, 359)
+        sats = [(min(90, e0 + rng.randint(0, 3)), (a0 + rng.randint(0, 3)) % 360, s, u)
+                for _, _, s, u in sats]
+    mask = (rng.choice((0, 0, 5, 10, 15)), rng.choice((0, 0, 20, 30)), rng.randint(0, 1))
+    return mask, sats
+
+
+def selected(mask, sats):
+    min_elev, min_snr, used_only = mask
+    return [(e, a) for e, a, s, u in sats
+            if a != NO_POS and e >= min_elev and s >= min_snr and (not used_only or u)]
+
+
+def main(binary, tables):
+    rng = random.Random(99)
+    cases = [random_table(rng) for _ in range(tables)]
+    text = "".join("%d %d %d %d %s\n" % (m[0], m[1], m[2], len(s),
+                                         " ".join("%d %d %d %d" % t for t in s)) for m, s in cases)
+    out = subprocess.run([binary, "-r"], input=text, capture_output=True, text=True, check=True)
+    rows = out.stdout.split("\n")
+
+    failures = compared = rejected = 0
+    worst = 0.0
+    for i, (mask, sats) in enumerate(cases):
+        f = rows[i].split()
+        ret, count, dops = int(f[0]), int(f[1]), [float(x) for x in f[2:]]
+        sel = selected(mask, sats)
+
+        if count != len(sel):
+            print("FAIL: table %d selects %d satellites, expected %d" % (i, count, len(sel)))
+            failures += 1
+            continue
+        if len(sel) < 4:
+            if ret:
+                print("FAIL: table %d solved with %d satellites" % (i, len(sel)))
+                failures += 1
+            continue
+
+        el = np.radians([e for e, _ in sel])
+        az = np.radians([a for _, a in sel])
+        g = np.column_stack((np.cos(el) * np.sin(az), np.cos(el) * np.cos(az), np.sin(el), np.ones(len(sel))))
+        h = g.T @ g
+        cond = np.linalg.cond(h)
+
+        if cond > COND_SINGULAR:
+            rejected += 1
+            if ret:
+                print("FAIL: table %d singular (cond %.1e) but solved" % (i, cond))
+                failures += 1
+        elif cond < COND_OK:
+            q = np.diag(np.linalg.inv(h))
+            want = [np.sqrt(q.sum()), np.sqrt(q[:3].sum()), np.sqrt(q[:2].sum()), np.sqrt(q[2]), np.sqrt(q[3])]
+            if not ret:
+                print("FAIL: table %d well conditioned (cond %.1e) but rejected" % (i, cond))
+                failures += 1
+                continue
+            err = max(abs(a - b) / b for a, b in zip(dops, want))
+            worst = max(worst, err)
+            compared += 1
+            if err > REL_TOL:
+                print("FAIL: table %d: %s, numpy %s" % (i, dops, ["%.6g" % x for x in want]))
+                failures += 1
+
+    print("%d tables, %d compared with numpy (worst relative error %.1e), %d singular rejected"
+          % (tables, compared, worst, rejected))
+    print("FAILED" if failures else "OK")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print("usage: check_geom.py path/to/test_geom [tables]")
+        sys.exit(2)
+    sys.exit(main(sys.argv[1], int(sys.argv[2]) if len(sys.argv) > 2 else 20000))
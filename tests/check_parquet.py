@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+#
+# check_parquet.py — read back a file written by tests/test_parquet.c
+#
+# Compares every column of the Parquet file (read with pyarrow) against the
+# raw rows written next to it, and checks each row group's min/max
+# statistics against the values actually stored in that group.
+#
+# Usage:  check_parquet.py out.parquet out.raw
+# Exit status is 0 when the file matches; 77 when pyarrow is not installed.
+
+import struct
+import sys
+
+try:
+    import pyarrow.parquet as pq
+except ImportError:
+    print("skipped: pyarrow not installed")
+    sys.exit(77)
+
+COLUMNS = ("device", "utc_ms", "lat_e7", "lon_e7", "alt_mm", "speed_cms", "hdop_c", "sats", "fix")
+ROW = struct.Struct("<IqiiiHHBB")
+
+
+def as_int(v):
+    # timestamp(ms) columns come back as datetime objects
+    if hasattr(v, "timestamp"):
+        return round(v.timestamp() * 1000)
+    return v
+
+
+def main(pq_path, raw_path):
+    with open(raw_path, "rb") as f:
+        raw = list(zip(*ROW.iter_unpack(f.read())))
+    pf = pq.ParquetFile(pq_path)
+    table = pf.read()
+    md = pf.metadata
+    failures = 0
+
+    # 1) Schema and row count
+    if table.column_names != list(COLUMNS):
+        print("FAIL: columns", table.column_names)
+        return 1
+    if table.num_rows != len(raw[0]):
+        print("FAIL: rows %d, expected %d" % (table.num_rows, len(raw[0])))
+        return 1
+
+    # 2) Every value
+    for c, name in enumerate(COLUMNS):
+        got = [as_int(v) for v in table.column(c).to_pylist()]
+        if got != list(raw[c]):
+            bad = next(i for i, (a, b) in enumerate(zip(got, raw[c])) if a != b)
+            print("FAIL: %s differs at row %d: %r != %r" % (name, bad, got[bad], raw[c][bad]))
+            failures += 1
+
+    # 3) Row-group statistics
+    start = 0
+    for g in range(md.num_row_groups):
+        rg = md.row_group(g)
+        for c, name in enumerate(COLUMNS):
+            st = rg.column(c).statistics
+            vals = raw[c][start:start + rg.num_rows]
+            if st is None or not st.has_min_max:
+                print("FAIL: %s has no statistics in row group %d" % (name, g))
+                failures += 1
+            elif (as_int(st.min), as_int(st.max)) != (min(vals), max(vals)):
+                print("FAIL: %s row group %d min/max %r/%r, expected %r/%r"
+                      % (name, g, st.min, st.max, min(vals), max(vals)))
+                failures += 1
+        start += rg.num_rows
+
+    encodings = {name: md.row_group(0).column(c).encodings for c, name in enumerate(COLUMNS)}
+    print("rows %d, row groups %d, device %s, hdop_c %s" % (
+        table.num_rows, md.num_row_groups, "/".join(encodings["device"]), "/".join(encodings["hdop_c"])))
+    print("FAILED" if failures else "OK")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        print("usage: check_parquet.py out.parquet out.raw")
+        sys.exit(2)
+    sys.exit(main(sys.argv[1], sys.argv[2]))
@@ -0,0 +1,151 @@
+#!/bin/sh
+#
+# run_host_tests.sh — host-side tests of the BN-220 driver
+#
+# Builds every test under tests/ with the host compiler (BN220_PLATFORM_HAL=0,
+# AddressSanitizer and UBSan where available) and runs it.  Tests that are
+# sensitive to a build option are built once per setting and their digests
+# compared.
+#
+# Reference checks written in Python need numpy/pyarrow, and gzip export
+# needs zlib; they report "skipped" when those are not installed.
+#
+# Usage:  tests/run_host_tests.sh
+#         CC=clang SANITIZE= PYTHON=python3.12 tests/run_host_tests.sh
+#
+# Exit status is 0 when every test that ran passed.
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+CC=${CC:-cc}
+PYTHON=${PYTHON:-python3}
+SANITIZE=${SANITIZE--fsanitize=address,undefined}
+CFLAGS_HOST="-std=gnu99 -O1 -g -Wall -Wextra -Wno-pointer-sign -DBN220_PLATFORM_HAL=0 -I$ROOT $SANITIZE"
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+failed=0
+
+# run <name> <command> [args...]: prints the summary line, records failures.
+# Exit status 77 means the test could not run here (missing Python module).
+run() {
+    name=$1; shift
+    printf '%-24s ' "$name"
+    status=0
+    "$@" > "$WORK/$name.out" 2>&1 || status=$?
+    if [ $status -eq 0 ]; then
+        tail -n 2 "$WORK/$name.out" | head -n 1
+    elif [ $status -eq 77 ]; then
+        tail -n 1 "$WORK/$name.out"
+    else
+        echo "FAILED"
+        cat "$WORK/$name.out"
+        failed=$((failed + 1))
+    fi
+}
+
+cd "$ROOT"
+
+# 1) Streaming parser: byte loop and SWAR scanner must give identical results
+for swar in 0 1; do
+    $CC $CFLAGS_HOST -DBN220_ENABLE_STATS=1 -DBN220_USE_SWAR=$swar \
+        tests/test_feed.c BN220.c -o "$WORK/test_feed_$swar"
+    run "feed (SWAR $swar)" "$WORK/test_feed_$swar"
+done
+d0=$(grep digest "$WORK/feed (SWAR 0).out" | sed 's/.*digest \([0-9a-f]*\).*/\1/')
+d1=$(grep digest "$WORK/feed (SWAR 1).out" | sed 's/.*digest \([0-9a-f]*\).*/\1/')
+if [ -n "$d0" ] && [ "$d0" = "$d1" ]; then
+    printf '%-24s %s\n' "feed SWAR vs byte loop" "same digest $d0"
+else
+    printf '%-24s %s\n' "feed SWAR vs byte loop" "FAILED: $d0 != $d1"
+    failed=$((failed + 1))
+fi
+
+# 2) Parquet writer: read back with pyarrow, dictionary and delta-fallback columns
+$CC $CFLAGS_HOST tests/test_parquet.c BN220_parquet.c -o "$WORK/test_parquet"
+parquet() {
+    "$WORK/test_parquet" "$@" "$WORK/t.parquet" "$WORK/t.raw" 300000 150000 &&
+        $PYTHON tests/check_parquet.py "$WORK/t.parquet" "$WORK/t.raw"
+}
+run "parquet" parquet
+run "parquet (wide)" parquet -w
+
+# 3) JSON Lines / CSV: one million fixes must parse back bit-exact
+$CC $CFLAGS_HOST tests/test_serialize.c BN220_serialize.c -o "$WORK/test_serialize"
+run "serialize" "$WORK/test_serialize"
+
+# 4) ENU: float32 closed form against a long double reference
+$CC $CFLAGS_HOST tests/test_enu.c BN220_enu.c -lm -o "$WORK/test_enu"
+run "enu" "$WORK/test_enu"
+
+# 5) DOP: selection rules here, values against numpy
+$CC $CFLAGS_HOST tests/test_geom.c BN220_geom.c -lm -o "$WORK/test_geom"
+run "geom" "$WORK/test_geom"
+run "geom vs numpy" $PYTHON tests/check_geom.py "$WORK/test_geom"
+
+# 6) Batch GGA decoder
+$CC $CFLAGS_HOST tests/test_batch.c BN220_batch.c -o "$WORK/test_batch"
+run "batch" "$WORK/test_batch"
+
+# 7) Context cache: eviction/restore round trips, bounded spill file
+$CC $CFLAGS_HOST tests/test_ctxcache.c BN220_ctxcache.c BN220.c -o "$WORK/test_ctxcache"
+run "ctxcache" "$WORK/test_ctxcache"
+
+# 8) Signal monitor: tables keep arriving through onSats after loss of fix
+$CC $CFLAGS_HOST tests/test_sigmon.c BN220_sigmon.c BN220.c -lm -o "$WORK/test_sigmon"
+run "sigmon" "$WORK/test_sigmon"
+
+# 9) Journal: clean, torn-write and wrapped-ring recovery
+$CC $CFLAGS_HOST tests/test_journal.c BN220_journal.c -o "$WORK/test_journal"
+run "journal" "$WORK/test_journal"
+
+# 10) Fleet store: reclamation under concurrent readers (C11 module)
+$CC $CFLAGS_HOST -std=gnu11 -pthread tests/test_fleet.c BN220_fleet.c -o "$WORK/test_fleet"
+run "fleet" "$WORK/test_fleet"
+
+# 11) Segmentation: stops and trips across the antimeridian
+$CC $CFLAGS_HOST tests/test_segment.c BN220_segment.c -lm -o "$WORK/test_segment"
+run "segment" "$WORK/test_segment"
+
+# 12) k-NN grid: queries against a brute-force scan, at the poles too
+$CC $CFLAGS_HOST tests/test_knn.c BN220_knn.c -lm -o "$WORK/test_knn"
+run "knn" "$WORK/test_knn"
+
+# 13) Exporter: every format parsed back, plain and gzip (needs zlib)
+$CC $CFLAGS_HOST tests/test_export.c BN220_export.c -o "$WORK/test_export"
+gzip_ok=0
+$CC $CFLAGS_HOST -DBN220_EXPORT_GZIP=1 tests/test_export.c BN220_export.c -lz \
+    -o "$WORK/test_export_gz" 2>/dev/null && gzip_ok=1
+export_check() {
+    if [ "$2" = gzip ] && [ $gzip_ok -eq 0 ]; then
+        echo "skipped: zlib not available"
+        return 77
+    fi
+    if [ "$2" = gzip ]; then
+        "$WORK/test_export_gz" -z 6 "$1" "$WORK/t.$1.gz" "$WORK/t.$1.raw" 20000 &&
+            $PYTHON tests/check_export.py "$1" "$WORK/t.$1.gz" "$WORK/t.$1.raw" gzip
+    else
+        "$WORK/test_export" "$1" "$WORK/t.$1" "$WORK/t.$1.raw" 20000 &&
+            $PYTHON tests/check_export.py "$1" "$WORK/t.$1" "$WORK/t.$1.raw"
+    fi
+}
+for fmt in gpx kml geojson; do
+    run "export $fmt" export_check $fmt
+    run "export $fmt (gzip)" export_check $fmt gzip
+done
+
+# 14) Rollups: buckets against their fixes, minutes folded into hours
+$CC $CFLAGS_HOST tests/test_rollup.c BN220_rollup.c -o "$WORK/test_rollup"
+run "rollup" "$WORK/test_rollup"
+
+# 15) Transmit queue: order, priority and ring wrap on the UART simulator
+$CC $CFLAGS_HOST tests/test_tx.c BN220_tx.c -o "$WORK/test_tx"
+run "tx" "$WORK/test_tx"
+
+echo
+if [ $failed -ne 0 ]; then
+    echo "$failed test(s) FAILED"
+    exit 1
+fi
+echo "all tests passed"
@@ -0,0 +1,184 @@
+/*
+ * test_batch.c — Batch GGA decoder test
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    test_batch.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Exact decoding of random GGA sentences, empty fields and per-lane
+ *          failures.
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * Batch GGA decoder test.
+ *
+ * Random GGA sentences are built from known integer fields, so every
+ * decoded value has an exact expected result; odd counts exercise the
+ * partial last batch.  Empty fields, as sent before the first fix, must
+ * decode as 0, a lowercase checksum must be accepted, and a bad checksum,
+ * a malformed hemisphere or a foreign sentence must fail only its own
+ * lane.
+ *
+ * Usage:  test_batch [-n sentences]
+ * Exit status is 0 when every check passes.
+ */
+
+#include "BN220_batch.h"
+#include "test_util.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#define BATCH_LINE 176   // worst case of the formats below, not of real NMEA
+
+typedef struct {
+    int64_t  tod_ms;
+    int32_t  lat_e7, lon_e7, alt_mm;
+    uint16_t hdop_c;
+    uint8_t  sats, quality;
+} Expect;
+
+// "$<body>*CS\r\n"
+static void seal(char *out, const char *body) {
+    uint8_t cs = 0;
+    for (const char *p = body; *p; p++)
+        cs ^= (uint8_t)*p;
+    snprintf(out, BATCH_LINE, "$%s*%02X\r\n", body, cs);
+}
+
+// ddmm.mmmmm with minutes in 1e-5 -> 1e-7 degrees, rounded to nearest
+static int32_t toE7(uint32_t deg, uint32_t min_e5) {
+    return (int32_t)(deg * 10000000u + (min_e5 * 10u + 3u) / 6u);
+}
+
+static void genGGA(char *out, Expect *e) {
+    char     body[BATCH_LINE - 8];   // room for "$", "*CS" and CR/LF
+    uint32_t hh = rnd(24), mm = rnd(60), ss = rnd(60), ms = rnd(100) * 10;
+    uint32_t latD = rnd(90), latM = rnd(6000000), lonD = rnd(180), lonM = rnd(6000000);
+    int      south = (int)rnd(2), west = (int)rnd(2), altNeg = rnd(8) == 0;
+    uint32_t altDm = rnd(50000), hdop = 50 + rnd(950);
+
+    e->tod_ms  = ((hh * 60 + mm) * 60 + ss) * 1000 + ms;
+    e->lat_e7  = south ? -toE7(latD, latM) : toE7(latD, latM);
+    e->lon_e7  = west ? -toE7(lonD, lonM) : toE7(lonD, lonM);
+    e->alt_mm  = (int32_t)(altDm * 100) * (altNeg ? -1 : 1);
+    e->hdop_c  = (uint16_t)hdop;
+    e->sats    = (uint8_t)(3 + rnd(10));
+    e->quality = (uint8_t)(1 + rnd(2));
+
+    snprintf(body, sizeof(body), "GPGGA,%02u%02u%02u.%02u,%02u%02u.%05u,%c,%03u%02u.%05u,%c,%u,%02u,%u.%02u,%s%u.%u,M,46.9,M,,",
+             hh, mm, ss, ms / 10, latD, latM / 100000, latM % 100000, south ? 'S' : 'N',
+             lonD, lonM / 100000, lonM % 100000, west ? 'W' : 'E', e->quality, e->sats,
+             hdop / 100, hdop % 100, altNeg ? "-" : "", altDm / 10, altDm % 10);
+    seal(out, body);
+}
+
+static int sameFix(const BN220_Fix *f, const Expect *e, int64_t day) {
+    return f->utc_ms == e->tod_ms + day && f->lat_e7 == e->lat_e7 && f->lon_e7 == e->lon_e7 &&
+           f->alt_mm == e->alt_mm && f->hdop_c == e->hdop_c && f->sats == e->sats &&
+           f->fix == (e->quality > 0) && f->speed_cms == 0;
+}
+
+
+int main(int argc, char **argv) {
+    size_t n = 100003;
+    int    opt;
+
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        if (opt == 'n')
+            n = (size_t)atol(optarg);
+        else
+            return 2;
+    }
+
+    char        (*line)[BATCH_LINE] = calloc(n, BATCH_LINE);
+    const char **ptr = calloc(n, sizeof(*ptr));
+    Expect      *exp = calloc(n, sizeof(*exp));
+    int64_t     *day = calloc(n, sizeof(*day));
+    BN220_Fix   *out = calloc(n, sizeof(*out));
+    uint8_t     *ok  = calloc(n, 1);
+    if (!line || !ptr || !exp || !day || !out || !ok)
+        return 1;
+
+    // 1) Random complete sentences: every field must come back exactly
+    for (size_t i = 0; i < n; i++) {
+        genGGA(line[i], &exp[i]);
+        ptr[i] = i % 2 ? line[i] : line[i] + 1;   // with and without '$'
+        day[i] = (int64_t)rnd(20000) * 86400000;
+    }
+    size_t decoded = gpsBatchGGA(ptr, day, n, out, ok);
+    size_t wrong = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (!ok[i] || !sameFix(&out[i], &exp[i], day[i])) {
+            if (wrong++ < 5)
+                printf("FAIL: %s  -> ok %u lat %d lon %d alt %d hdop %u\n", line[i], ok[i],
+                       out[i].lat_e7, out[i].lon_e7, out[i].alt_mm, out[i].hdop_c);
+        }
+    }
+    CHECK(decoded == n && !wrong, "random sentences decode exactly");
+
+    // 2) Edge cases in one batch: each lane stands alone
+    static const char *const body[] = {
+        "GPGGA,,,,,,0,00,99.99,,,,,,",                                   // 0: before the first fix
+        "GPGGA,092750.000,5321.6802,N,00630.3372,W,1,8,1.03,,M,55.2,M,,", // 1: empty altitude
+        "GPGGA,092750.000,5321.6802,N,00630.3372,W,1,,,61.7,M,55.2,M,,",  // 2: empty sats/hdop
+        "GPGGA,092750.000,,N,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,",      // 3: hemisphere without latitude
+        "GPGGA,092750.000,5321.6802,X,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,", // 4: bad hemisphere
+        "GPRMC,092750.000,A,5321.6802,N,00630.3372,W,0.02,31.66,280511,,,A", // 5: not GGA
+        "GPGGA,092758.000,5321.6802,N,00630.3372,W,1,8,1.03,61.7,M,55.2,M,,", // 6: lowercase checksum (7e)
+    };
+    const size_t cases = sizeof(body) / sizeof(body[0]);
+    char         edge[8][BATCH_LINE];
+    const char  *edgePtr[8];
+    BN220_Fix    edgeOut[8];
+    uint8_t      edgeOk[8];
+    for (size_t i = 0; i < cases; i++) {
+        seal(edge[i], body[i]);
+        edgePtr[i] = edge[i];
+    }
+    for (char *p = strrchr(edge[6], '*') + 1; *p != '\r'; p++)
+        *p = (char)tolower((unsigned char)*p);
+    strcpy(edge[cases], edge[1]);
+    edge[cases][strlen(edge[cases]) - 3] ^= 1;                            // 7: checksum off by one bit
+    edgePtr[cases] = edge[cases];
+
+    size_t got = gpsBatchGGA(edgePtr, NULL, cases + 1, edgeOut, edgeOk);
+    const BN220_Fix *f = edgeOut;
+    CHECK(got == 4, "four edge-case sentences decode");
+    CHECK(edgeOk[0] && f[0].utc_ms == 0 && f[0].lat_e7 == 0 && f[0].lon_e7 == 0 && f[0].alt_mm == 0 &&
+          f[0].sats == 0 && f[0].hdop_c == 9999 && f[0].fix == 0, "empty fields decode as 0");
+    CHECK(edgeOk[1] && f[1].alt_mm == 0 && f[1].hdop_c == 103 && f[1].sats == 8 &&
+          f[1].lat_e7 == 533613367 && f[1].lon_e7 == -65056200 && f[1].utc_ms == (9 * 3600 + 27 * 60 + 50) * 1000,
+          "empty altitude reads 0, other fields intact");
+    CHECK(edgeOk[2] && f[2].sats == 0 && f[2].hdop_c == 0 && f[2].alt_mm == 61700,
+          "empty sats/hdop read 0");
+    CHECK(edgeOk[6] && f[6].utc_ms == (9 * 3600 + 27 * 60 + 58) * 1000, "lowercase checksum accepted");
+    CHECK(!edgeOk[3] && !edgeOk[4] && !edgeOk[5] && !edgeOk[7], "malformed lanes fail");
+    CHECK(f[3].lat_e7 == 0 && f[7].utc_ms == 0, "failed lanes are zeroed");
+
+    printf("%zu sentences decoded exactly, %zu edge cases\n", decoded, cases + 1);
+    printf("%s\n", failures ? "FAILED" : "OK");
+    free(line); free(ptr); free(exp); free(day); free(out); free(ok);
+    return failures ? 1 : 0;
+}
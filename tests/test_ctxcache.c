@@ -0,0 +1,184 @@
+/*
+ * test_ctxcache.c — Context cache test
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    test_ctxcache.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Evicted, spilled and restored contexts must match never-evicted
+ *          references; the spill file must stay bounded.
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * Context cache test.
+ *
+ * Many devices share a small resident set.  Each packet carries a random
+ * slice of its device's NMEA stream, so contexts are often evicted
+ * mid-sentence.  A reference context per device, never evicted, is fed the
+ * same bytes; after a flush, every device's cached state must checkpoint
+ * to the same blob as its reference.  Run against the in-memory and the
+ * file spill store; the file must stay at one extent per device however
+ * many evictions happen.
+ *
+ * Usage:  test_ctxcache [-d devices] [-p packets]
+ * Exit status is 0 when every check passes.
+ */
+
+#include "BN220_ctxcache.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define CACHE_RESIDENT  64
+#define CACHE_EXTENT    512   // two 256-byte spill units per device
+
+// Next sentence of a device's stream into buf; returns its length
+static size_t nextSentence(char *buf, size_t cap, uint64_t device, uint32_t seq) {
+    char    body[96];
+    uint8_t cs = 0;
+
+    if (seq % 2)
+        snprintf(body, sizeof(body), "GPRMC,%06u.00,A,41%02u.%05u,N,029%02u.%05u,E,%u.%03u,%u.0,181026,,,A",
+                 seq % 240000, (unsigned)(device % 60), rnd(100000), seq % 60, rnd(100000), rnd(50), rnd(1000), rnd(360));
+    else
+        snprintf(body, sizeof(body), "GPGGA,%06u.00,41%02u.%05u,N,029%02u.%05u,E,1,%02u,%u.%02u,%u.%u,M,37.0,M,,",
+                 seq % 240000, (unsigned)(device % 60), rnd(100000), seq % 60, rnd(100000), 4 + rnd(9), rnd(3), rnd(100),
+                 rnd(500), rnd(10));
+    for (const char *p = body; *p; p++)
+        cs ^= (uint8_t)*p;
+    return (size_t)snprintf(buf, cap, "$%s*%02X\r\n", body, cs);
+}
+
+typedef struct {
+    BN220_Context ref;
+    char          pending[256];  // rest of the current sentence
+    size_t        len, pos;
+    uint32_t      seq;
+} Device;
+
+static void run(const char *name, BN220_SpillStore *store, uint32_t devices, uint32_t packets,
+                const char *path) {
+    Device *dev = calloc(devices, sizeof(*dev));
+    BN220_CtxCache *cache = ctxCacheCreate(CACHE_RESIDENT, store, NULL, NULL);
+    if (!dev || !cache) {
+        printf("FAIL: %s: out of memory\n", name);
+        failures++;
+        free(dev);
+        ctxCacheDestroy(cache);
+        return;
+    }
+    for (uint32_t d = 0; d < devices; d++)
+        gpsInit(&dev[d].ref);
+
+    // 1) Packets of 1..40 bytes for random devices, hot devices more often
+    for (uint32_t p = 0; p < packets; p++) {
+        uint32_t d = rnd(4) ? rnd(devices / 8 + 1) : rnd(devices);
+        Device  *v = &dev[d];
+        if (v->pos == v->len) {
+            v->len = nextSentence(v->pending, sizeof(v->pending), d, v->seq++);
+            v->pos = 0;
+        }
+        size_t n = 1 + rnd(40);
+        if (n > v->len - v->pos)
+            n = v->len - v->pos;
+
+        BN220_Context *ctx = ctxCacheAcquire(cache, d);
+        if (!ctx) {
+            printf("FAIL: %s: acquire failed at packet %u\n", name, p);
+            failures++;
+            break;
+        }
+        gpsFeed(ctx, (const uint8_t *)v->pending + v->pos, n);
+        gpsFeed(&v->ref, (const uint8_t *)v->pending + v->pos, n);
+        v->pos += n;
+    }
+
+    // 2) Every device's state survives eviction, spill and restore
+    CHECK(ctxCacheFlush(cache) == 0, "flush writes every resident context");
+    uint32_t differ = 0;
+    for (uint32_t d = 0; d < devices; d++) {
+        uint8_t a[BN220_CHECKPOINT_MAX], b[BN220_CHECKPOINT_MAX];
+        BN220_Context *ctx = ctxCacheAcquire(cache, d);
+        size_t la = ctx ? gpsCheckpoint(ctx, a, sizeof(a)) : 0;
+        size_t lb = gpsCheckpoint(&dev[d].ref, b, sizeof(b));
+        if (!la || la != lb || memcmp(a, b, la))
+            differ++;
+    }
+    CHECK(differ == 0, "cached state matches the reference for every device");
+
+    uint64_t hits, restores, evictions;
+    ctxCacheStats(cache, &hits, &restores, &evictions);
+    CHECK(evictions > (uint64_t)devices * 4, "test evicts each device several times");
+
+    // 3) The spill file does not grow with evictions
+    long long size = -1;
+    if (path) {
+        struct stat st;
+        ctxCacheFlush(cache);
+        size = stat(path, &st) == 0 ? (long long)st.st_size : -1;
+        CHECK(size >= 0 && size <= (long long)devices * CACHE_EXTENT, "spill file holds one extent per device");
+    }
+
+    printf("%s: %u devices, %llu hits, %llu restores, %llu evictions%s", name, devices,
+           (unsigned long long)hits, (unsigned long long)restores, (unsigned long long)evictions,
+           path ? "" : "\n");
+    if (path)
+        printf(", file %lld bytes\n", size);
+    ctxCacheDestroy(cache);
+    free(dev);
+}
+
+
+int main(int argc, char **argv) {
+    uint32_t devices = 2000, packets = 400000;
+    int      opt;
+
+    while ((opt = getopt(argc, argv, "d:p:")) != -1) {
+        if (opt == 'd')
+            devices = (uint32_t)atol(optarg);
+        else if (opt == 'p')
+            packets = (uint32_t)atol(optarg);
+        else
+            return 2;
+    }
+
+    BN220_SpillStore mem, file;
+    char path[] = "/tmp/bn220_spill_XXXXXX";
+    int  fd = mkstemp(path);
+    if (fd < 0 || !spillMemOpen(&mem) || !spillFileOpen(&file, path)) {
+        printf("FAIL: cannot open spill stores\n");
+        return 1;
+    }
+    close(fd);
+
+    run("memory store", &mem, devices, packets, NULL);
+    run("file store", &file, devices, packets, path);
+
+    spillMemClose(&mem);
+    spillFileClose(&file);
+    unlink(path);
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
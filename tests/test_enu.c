@@ -0,0 +1,185 @@
+/*
+ * test_enu.c — ENU accuracy test
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    test_enu.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   enuFromLla/enuLlaToEcef against a long double ECEF reference over
+ *          the whole globe.
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * ENU accuracy test against a long double reference.
+ *
+ * Random origins over the whole globe (poles, the antimeridian and
+ * altitudes from -100 m to 3000 m included) and random points up to 300 km
+ * away.  The reference goes through ECEF in long double with libm trig;
+ * enuFromLla and enuLlaToEcef must stay within the documented fraction of
+ * the distance to the origin plus 1 mm of rounding.  enuBatch and enuBatchFix
+ * must agree exactly with enuFromLla.
+ *
+ * Usage:  test_enu [-n points]
+ * Exit status is 0 when every point is within bounds.
+ */
+
+#include "BN220_enu.h"
+#include "test_util.h"
+#include <math.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#define ENU_REL_ERR        4.5e-7  // documented bounds, relative to the distance,
+#define ENU_REL_ERR_POLAR  8e-7    // the latter once |dlon| exceeds 0.2 rad
+#define ENU_ABS_MM         1.0     // output rounding to whole millimetres
+#define ENU_BATCH    256
+
+// WGS-84 geodetic to ECEF, metres
+static void refEcef(int32_t lat_e7, int32_t lon_e7, int32_t alt_mm, long double x[3]) {
+    const long double k = 3.14159265358979323846264338327950288L / 1.8e9L;
+    const long double a = 6378137.0L, f = 1.0L / 298.257223563L, e2 = f * (2.0L - f);
+    long double lat = lat_e7 * k, lon = lon_e7 * k, h = alt_mm / 1000.0L;
+    long double s = sinl(lat), c = cosl(lat), n = a / sqrtl(1.0L - e2 * s * s);
+
+    x[0] = (n + h) * c * cosl(lon);
+    x[1] = (n + h) * c * sinl(lon);
+    x[2] = (n * (1.0L - e2) + h) * s;
+}
+
+static void refEnu(int32_t lat0, int32_t lon0, const long double x0[3], const long double x1[3],
+                   long double enu[3]) {
+    const long double k = 3.14159265358979323846264338327950288L / 1.8e9L;
+    long double sl = sinl(lat0 * k), cl = cosl(lat0 * k), so = sinl(lon0 * k), co = cosl(lon0 * k);
+    long double d[3] = { x1[0] - x0[0], x1[1] - x0[1], x1[2] - x0[2] };
+
+    enu[0] = -so * d[0] + co * d[1];
+    enu[1] = -sl * co * d[0] - sl * so * d[1] + cl * d[2];
+    enu[2] = cl * co * d[0] + cl * so * d[1] + sl * d[2];
+}
+
+
+int main(int argc, char **argv) {
+    static const double range_m[] = { 1e2, 1e3, 1e4, 1e5, 3e5 };
+    double worstRel[5] = { 0 }, worstMm[5] = { 0 };
+    long   n = 400000, failures = 0;
+    int    opt;
+
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        if (opt == 'n')
+            n = atol(optarg);
+        else
+            return 2;
+    }
+
+    int32_t   lat[ENU_BATCH], lon[ENU_BATCH], alt[ENU_BATCH];
+    int32_t   e[ENU_BATCH], nn[ENU_BATCH], u[ENU_BATCH], enuFix[ENU_BATCH][3];
+    BN220_Fix fix[ENU_BATCH];
+    memset(fix, 0, sizeof(fix));
+
+    for (long it = 0; it < n; it += ENU_BATCH) {
+        // 1) One origin per batch; every 16th sits on the antimeridian or a pole cap
+        int32_t lat0 = (int32_t)uniform(-8.9e8, 8.9e8);
+        int32_t lon0 = (int32_t)uniform(-1.8e9, 1.8e9);
+        int32_t alt0 = (int32_t)uniform(-1e5, 3e6);
+        if ((it / ENU_BATCH) % 16 == 1)
+            lon0 = 1799999000;
+        else if ((it / ENU_BATCH) % 16 == 2)
+            lat0 = lat0 < 0 ? -880000000 : 880000000;
+        int r = (int)((it / ENU_BATCH) % 5);
+
+        BN220_EnuOrigin o;
+        enuSetOrigin(&o, lat0, lon0, alt0);
+        long double x0[3];
+        refEcef(lat0, lon0, alt0, x0);
+
+        // 2) Points in a square of +-range around the origin
+        int m = 0;
+        for (int i = 0; i < ENU_BATCH; i++) {
+            double  dn = uniform(-1, 1) * range_m[r], de = uniform(-1, 1) * range_m[r];
+            double  cosLat = cos(lat0 * 1.7453292519943295e-9);
+            int64_t la = lat0 + (int64_t)(dn / 0.011131949);
+            int64_t lo = lon0 + (int64_t)(de / (0.011131949 * (cosLat > 0.01 ? cosLat : 0.01)));
+            if (la > 900000000 || la < -900000000)
+                continue;
+            if (lo > 1800000000)
+                lo -= 3600000000LL;
+            else if (lo < -1800000000)
+                lo += 3600000000LL;
+            lat[m] = (int32_t)la;
+            lon[m] = (int32_t)lo;
+            alt[m] = alt0 + (int32_t)uniform(-1e5, 1e5);
+            fix[m].lat_e7 = lat[m];
+            fix[m].lon_e7 = lon[m];
+            fix[m].alt_mm = alt[m];
+            m++;
+        }
+
+        enuBatch(&o, lat, lon, alt, (size_t)m, e, nn, u);
+        enuBatchFix(&o, fix, (size_t)m, enuFix);
+
+        // 3) Each point against the reference, and the batch paths against the single one
+        for (int i = 0; i < m; i++) {
+            long double x1[3], ref[3];
+            refEcef(lat[i], lon[i], alt[i], x1);
+            refEnu(lat0, lon0, x0, x1, ref);
+            double dist_mm = 1000.0 * (double)sqrtl(ref[0] * ref[0] + ref[1] * ref[1] + ref[2] * ref[2]);
+            int64_t dLon = (int64_t)lon[i] - lon0;
+            if (dLon > 1800000000)
+                dLon -= 3600000000LL;
+            else if (dLon < -1800000000)
+                dLon += 3600000000LL;
+            double rel   = llabs(dLon) > 114591559 ? ENU_REL_ERR_POLAR : ENU_REL_ERR;  // 0.2 rad
+            double bound = rel * dist_mm + ENU_ABS_MM;
+
+            int32_t got[3];
+            int64_t ecef[3];
+            enuFromLla(&o, lat[i], lon[i], alt[i], got);
+            enuLlaToEcef(&o, lat[i], lon[i], alt[i], ecef);
+
+            double err = 0, errEcef = 0;
+            for (int k = 0; k < 3; k++) {
+                err     = fmax(err, fabs((double)(got[k] - ref[k] * 1000.0L)));
+                errEcef = fmax(errEcef, fabs((double)(ecef[k] - x1[k] * 1000.0L)));
+            }
+            if (err > bound || errEcef > bound + ENU_ABS_MM) {
+                if (failures++ < 10)
+                    printf("FAIL: origin %d,%d point %d,%d: error %.1f mm (ECEF %.1f), bound %.1f mm\n",
+                           lat0, lon0, lat[i], lon[i], err, errEcef, bound);
+            }
+            if (got[0] != e[i] || got[1] != nn[i] || got[2] != u[i] ||
+                memcmp(got, enuFix[i], sizeof(got))) {
+                if (failures++ < 10)
+                    printf("FAIL: batch result differs from enuFromLla at %d,%d\n", lat[i], lon[i]);
+            }
+            if (dist_mm > 0)
+                worstRel[r] = fmax(worstRel[r], (err - ENU_ABS_MM > 0 ? err - ENU_ABS_MM : 0) / dist_mm);
+            worstMm[r] = fmax(worstMm[r], err);
+        }
+    }
+
+    for (int r = 0; r < 5; r++)
+        printf("within %6.0f m: worst %8.2f mm (%.1e of the distance)\n", range_m[r], worstMm[r], worstRel[r]);
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,180 @@
+/*
+ * test_export.c — test_export.c
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    test_export.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   GPX, KML and GeoJSON exports must parse back to the fixes written.
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * Track exporter read-back, C side.
+ *
+ * Streams a synthetic track (random chunk sizes, segment breaks, no-fix
+ * rows, coordinate and altitude extremes) through the exporter into a
+ * GPX, KML or GeoJSON document, optionally gzip-compressed, and writes
+ * every point that should appear to a raw little-endian file.
+ * tests/check_export.py then parses the document with the Python standard
+ * library and compares segments and points against the raw file.
+ *
+ * It also checks that a failing write is reported by exportFixes and
+ * exportClose, and that gzip output is refused when built without it.
+ *
+ * Usage:  test_export [-z level] gpx|kml|geojson out.doc out.raw rows
+ *
+ * Raw point layout (27 bytes): segment u32, utc_ms i64, lat_e7 i32,
+ * lon_e7 i32, alt_mm i32, sats u8, hdop_c u16.
+ * Exit status is 0 when every check passes.
+ */
+
+#include "BN220_export.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <unistd.h>
+
+// Same name in tests/check_export.py; exercises XML and JSON escaping
+#define EXPORT_NAME "Trip <1> & \"2\" \\ 3\t4"
+
+static void putLE(FILE *f, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; i++)
+        fputc((int)(v >> (8 * i)) & 0xFF, f);
+}
+
+static int failAfter;
+
+static int writeFailing(void *user, const void *data, size_t len) {
+    (void)user; (void)data; (void)len;
+    return failAfter-- > 0;
+}
+
+static BN220_Fix genFix(int64_t *t) {
+    BN220_Fix f;
+    memset(&f, 0, sizeof(f));
+    *t += 1 + (int64_t)rnd(rnd(50) ? 2000 : 86400000);
+    f.utc_ms = *t;
+    f.lat_e7 = (int32_t)((int64_t)rnd(1800000001u) - 900000000);
+    f.lon_e7 = (int32_t)((int64_t)rnd(3600000001u) - 1800000000);
+    switch (rnd(20)) {
+    case 0:  f.lat_e7 = rnd(2) ? 900000000 : -900000000; break;
+    case 1:  f.lon_e7 = rnd(2) ? 1800000000 : -1800000000; break;
+    case 2:  f.lat_e7 = (int32_t)rnd(21) - 10; f.lon_e7 = (int32_t)rnd(21) - 10; break;
+    default: break;
+    }
+    f.alt_mm = rnd(30) ? (int32_t)rnd(9000000) - 500000 : (int32_t)(uint32_t)rnd64();
+    f.hdop_c = (uint16_t)rnd(rnd(10) ? 500 : 65536);
+    f.sats   = (uint8_t)rnd(rnd(10) ? 25 : 256);
+    f.fix    = rnd(12) != 0;
+    return f;
+}
+
+
+int main(int argc, char **argv) {
+    int level = 0, opt;
+    while ((opt = getopt(argc, argv, "z:")) != -1) {
+        if (opt == 'z')
+            level = atoi(optarg);
+        else
+            return 2;
+    }
+    if (argc - optind != 4)
+        return 2;
+
+    const char *fmt = argv[optind];
+    BN220_ExportFormat format = !strcmp(fmt, "gpx") ? BN220_EXPORT_GPX :
+                                !strcmp(fmt, "kml") ? BN220_EXPORT_KML : BN220_EXPORT_GEOJSON;
+    size_t rows = (size_t)atol(argv[optind + 3]);
+
+    // 1) Gzip needs BN220_EXPORT_GZIP; a failed write sticks
+#if !BN220_EXPORT_GZIP
+    CHECK(!exportOpen(format, NULL, 6, exportFileWrite, NULL), "gzip refused when not built in");
+#endif
+    static BN220_Fix many[512];
+    int64_t t = 0;
+    failAfter = 1;  // the first buffer goes out, the second write fails
+    BN220_Exporter *ex = exportOpen(format, NULL, level, writeFailing, NULL);
+    CHECK(ex != NULL, "open with a failing writer");
+    if (ex) {
+        int ok = 1;
+        for (int i = 0; i < 100; i++) {
+            for (size_t j = 0; j < 512; j++) {
+                many[j]     = genFix(&t);
+                many[j].fix = 1;
+            }
+            ok &= exportFixes(ex, many, 512);
+        }
+        CHECK(!ok, "exportFixes reports the failed write");
+        CHECK(!exportClose(ex), "exportClose reports the failed write");
+    }
+
+    // 2) The track itself
+    FILE *doc = fopen(argv[optind + 1], "wb"), *raw = fopen(argv[optind + 2], "wb");
+    ex = doc && raw ? exportOpen(format, EXPORT_NAME, level, exportFileWrite, doc) : NULL;
+    if (!ex) {
+        printf("FAIL: cannot create the output\n");
+        return 1;
+    }
+
+    BN220_Fix chunk[300];
+    t = 315532800000LL + (int64_t)rnd(86400000) * 365;  // 1980 onwards
+    uint32_t seg = 0, points = 0;
+    int      open = 0, ok = 1;
+    for (size_t done = 0; done < rows;) {
+        size_t n = 1 + rnd(300);
+        if (n > rows - done)
+            n = rows - done;
+        for (size_t i = 0; i < n; i++) {
+            chunk[i] = genFix(&t);
+            if (!chunk[i].fix)
+                continue;
+            if (!open) {
+                seg++;
+                open = 1;
+            }
+            const BN220_Fix *f = &chunk[i];
+            putLE(raw, seg - 1, 4);
+            putLE(raw, (uint64_t)f->utc_ms, 8);
+            putLE(raw, (uint32_t)f->lat_e7, 4);
+            putLE(raw, (uint32_t)f->lon_e7, 4);
+            putLE(raw, (uint32_t)f->alt_mm, 4);
+            putLE(raw, f->sats, 1);
+            putLE(raw, f->hdop_c, 2);
+            points++;
+        }
+        ok &= exportFixes(ex, chunk, n);
+        done += n;
+        if (rnd(4) == 0) {
+            ok &= exportBreak(ex);
+            open = 0;
+        }
+    }
+    CHECK(ok, "exportFixes");
+    CHECK(exportClose(ex), "exportClose");
+    fclose(doc);
+    fclose(raw);
+
+    printf("%s%s: %u points in %u segments\n", fmt, level ? " (gzip)" : "", points, seg);
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,328 @@
+/*
+ * test_feed.c — Streaming parser equivalence test
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    test_feed.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Random streams fed whole, byte-wise and in restored chunks must
+ *          agree; run with and without BN220_USE_SWAR.
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * Streaming-parser equivalence test.
+ *
+ * Random receiver streams (valid, corrupted, truncated and over-long
+ * sentences mixed with line noise) are fed three ways: in one gpsFeed call,
+ * one byte at a time, and in random chunks with a gpsCheckpoint/gpsRestore
+ * round trip into a fresh context between chunks.  All three must end in
+ * the same checkpoint blob and report the same epochs.
+ *
+ * The program prints a digest of every stream's result.  The runner builds
+ * it with and without BN220_USE_SWAR and compares the two digests, which
+ * checks the word-at-a-time scanner against the byte loop.
+ *
+ * A few fixed sentences then pin down the checksum field itself: two hex
+ * digits in either case, followed by nothing but the line ending.
+ *
+ * Usage:  test_feed [-n streams] [-s seed]
+ * Exit status is 0 when every check passes.
+ */
+
+#include "BN220.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <unistd.h>
+
+#define FEED_STREAM_MAX  8192
+
+typedef struct {
+    uint64_t hash;     // FNV-1a over every reported fix
+    unsigned epochs;
+} EpochLog;
+
+static uint64_t fnv(uint64_t h, const void *p, size_t n) {
+    const uint8_t *b = p;
+    for (size_t i = 0; i < n; i++)
+        h = (h ^ b[i]) * 0x100000001B3ull;
+    return h;
+}
+
+static void onEpoch(void *user, const BN220_Fix *fix) {
+    EpochLog *log = user;
+    log->hash = fnv(log->hash, &fix->utc_ms, sizeof(fix->utc_ms));
+    log->hash = fnv(log->hash, &fix->lat_e7, sizeof(fix->lat_e7));
+    log->hash = fnv(log->hash, &fix->lon_e7, sizeof(fix->lon_e7));
+    log->hash = fnv(log->hash, &fix->alt_mm, sizeof(fix->alt_mm));
+    log->hash = fnv(log->hash, &fix->hdop_c, sizeof(fix->hdop_c));
+    log->hash = fnv(log->hash, &fix->sats, 1);
+    log->hash = fnv(log->hash, &fix->fix, 1);
+    log->epochs++;
+}
+
+
+/* --- Stream generator ------------------------------------------------------ */
+
+static size_t genBody(char *b, size_t cap) {
+    static const char *const talker[] = { "GP", "GN", "GL" };
+    const char *t = talker[rnd(3)];
+    unsigned h = rnd(24), m = rnd(60), s = rnd(60);
+
+    switch (rnd(7)) {
+    case 0:
+        return (size_t)snprintf(b, cap, "%sGGA,%02u%02u%02u.%02u,%02u%02u.%05u,%c,%03u%02u.%05u,%c,%u,%02u,%u.%u,%u.%u,M,%u.%u,M,,",
+                                t, h, m, s, rnd(100), rnd(90), rnd(60), rnd(100000), rnd(2) ? 'N' : 'S',
+                                rnd(180), rnd(60), rnd(100000), rnd(2) ? 'E' : 'W', rnd(3), rnd(13),
+                                rnd(10), rnd(10), rnd(2000), rnd(10), rnd(60), rnd(10));
+    case 1:
+        return (size_t)snprintf(b, cap, "%sRMC,%02u%02u%02u.00,%c,%02u%02u.%05u,N,%03u%02u.%05u,E,%u.%03u,%u.%u,%02u%02u%02u,,,A",
+                                t, h, m, s, rnd(2) ? 'A' : 'V', rnd(90), rnd(60), rnd(100000),
+                                rnd(180), rnd(60), rnd(100000), rnd(100), rnd(1000), rnd(360), rnd(10),
+                                1 + rnd(28), 1 + rnd(12), rnd(100));
+    case 2:
+        return (size_t)snprintf(b, cap, "%sGSA,A,%u,%02u,%02u,%02u,%02u,,,,,,,,,%u.%u,%u.%u,%u.%u",
+                                t, 1 + rnd(3), 1 + rnd(32), 1 + rnd(32), 1 + rnd(32), 1 + rnd(32),
+                                rnd(10), rnd(10), rnd(10), rnd(10), rnd(10), rnd(10));
+    case 3: {
+        unsigned total = 1 + rnd(3);
+        size_t n = (size_t)snprintf(b, cap, "%sGSV,%u,%u,%02u", t, total, 1 + rnd(total), rnd(16));
+        for (unsigned i = 0, k = rnd(5); i < k; i++)
+            n += (size_t)snprintf(b + n, cap - n, ",%02u,%02u,%03u,%02u", 1 + rnd(32), rnd(91), rnd(360), rnd(55));
+        return n;
+    }
+    case 4:
+        return (size_t)snprintf(b, cap, "%sGLL,%02u%02u.%05u,N,%03u%02u.%05u,W,%02u%02u%02u.00,A,A",
+                                t, rnd(90), rnd(60), rnd(100000), rnd(180), rnd(60), rnd(100000), h, m, s);
+    case 5:
+        return (size_t)snprintf(b, cap, "%sVTG,%u.%u,T,,M,%u.%03u,N,%u.%03u,K,A",
+                                t, rnd(360), rnd(10), rnd(100), rnd(1000), rnd(200), rnd(1000));
+    default:
+        return (size_t)snprintf(b, cap, "%sTXT,01,01,02,ANTENNA OK", t);
+    }
+}
+
+// One sentence, possibly damaged, appended to out; returns the new length
+static size_t genSentence(uint8_t *out, size_t len, size_t cap) {
+    char body[160];
+    size_t n = genBody(body, sizeof(body));
+    if (n >= sizeof(body))
+        n = sizeof(body) - 1;
+
+    uint8_t cs = 0;
+    for (size_t i = 0; i < n; i++)
+        cs ^= (uint8_t)body[i];
+
+    char line[200];
+    const char *hex = rnd(4) ? "%02X" : "%02x";
+    char tail[8];
+    snprintf(tail, sizeof(tail), hex, (unsigned)(uint8_t)(rnd(10) ? cs : cs ^ (1 + rnd(255))));
+    size_t k = (size_t)snprintf(line, sizeof(line), "$%.*s*%s\r\n", (int)n, body, tail);
+
+    switch (rnd(12)) {
+    case 0:  // truncated anywhere, sometimes ended by a stray CR or LF
+        k = rnd((uint32_t)k);
+        if (rnd(2))
+            line[k++] = rnd(2) ? '\r' : '\n';
+        break;
+    case 1:  // a flipped byte
+        line[rnd((uint32_t)k)] ^= (char)(1 + rnd(127));
+        break;
+    case 2:  // bare LF or CR ending
+        line[k - 2] = rnd(2) ? '\n' : '\r';
+        k--;
+        break;
+    case 3:  // checksum missing
+        k = (size_t)snprintf(line, sizeof(line), "$%.*s\r\n", (int)n, body);
+        break;
+    default:
+        break;
+    }
+
+    if (len + k > cap)
+        return len;
+    memcpy(out + len, line, k);
+    return len + k;
+}
+
+static size_t genStream(uint8_t *out, size_t cap) {
+    static const char framing[] = "$*\r\n,";
+    size_t len = 0, target = 64 + rnd((uint32_t)cap - 64);
+
+    while (len + 200 < target) {
+        uint32_t r = rnd(16);
+        if (r == 0) {
+            // line noise, heavy on framing bytes
+            for (uint32_t i = 0, k = 1 + rnd(40); i < k; i++)
+                out[len++] = rnd(3) ? (uint8_t)rnd(256) : (uint8_t)framing[rnd(5)];
+        } else if (r == 1) {
+            // over-long line
+            out[len++] = '$';
+            for (uint32_t i = 0, k = BN220_LINE_MAX + rnd(40); i < k; i++)
+                out[len++] = (uint8_t)('A' + rnd(26));
+            out[len++] = '\n';
+        } else {
+            len = genSentence(out, len, cap);
+        }
+    }
+    return len;
+}
+
+
+/* --- Feeding strategies ---------------------------------------------------- */
+
+static void ctxInit(BN220_Context *ctx, EpochLog *log, uint8_t policy) {
+    gpsInit(ctx);
+    ctx->csPolicy = policy;
+    ctx->onEpoch  = onEpoch;
+    ctx->user     = log;
+    log->hash     = 0xCBF29CE484222325ull;
+    log->epochs   = 0;
+}
+
+static size_t feedChunked(BN220_Context *ctx, EpochLog *log, uint8_t policy,
+                          const uint8_t *s, size_t n, uint8_t *blob, int *restoreOk) {
+    ctxInit(ctx, log, policy);
+    *restoreOk = 1;
+
+    for (size_t i = 0; i < n;) {
+        size_t k = 1 + rnd(rnd(4) ? 64 : 512);
+        if (k > n - i)
+            k = n - i;
+        gpsFeed(ctx, s + i, k);
+        i += k;
+
+        // Checkpoint/restore into a fresh context, as across a STOP-mode wake-up
+        if (rnd(3) == 0) {
+            size_t   bl = gpsCheckpoint(ctx, blob, BN220_CHECKPOINT_MAX);
+            EpochLog keep = *log;
+            memset(ctx, 0xA5, sizeof(*ctx));
+            ctxInit(ctx, log, policy);
+            *log = keep;
+            // A short length is refused; the exact one or the whole region
+            // (backup SRAM, stale bytes after the blob) is accepted
+            if (!bl || gpsRestore(ctx, blob, bl - 1) ||
+                !gpsRestore(ctx, blob, i & 1 ? bl : BN220_CHECKPOINT_MAX))
+                *restoreOk = 0;
+        }
+    }
+    return gpsCheckpoint(ctx, blob, BN220_CHECKPOINT_MAX);
+}
+
+
+/* --- Fixed checksum cases ------------------------------------------------ */
+
+// Feeds one GGA with a fix, its checksum and @p tail; returns 1 if it made an epoch
+static int ggaAccepted(const char *fmt, const char *tail) {
+    static const char body[] = "GPGGA,123519.00,4807.03800,N,01131.00000,E,1,08,0.9,545.4,M,46.9,M,,";
+    uint8_t cs = 0;
+    for (const char *p = body; *p; p++)
+        cs ^= (uint8_t)*p;
+
+    char line[160], star[8];
+    snprintf(star, sizeof(star), fmt, (unsigned)cs);
+    int n = snprintf(line, sizeof(line), "$%s*%s%s", body, star, tail);
+
+    BN220_Context ctx;
+    EpochLog      log;
+    ctxInit(&ctx, &log, BN220_CS_VERIFY);
+    gpsFeed(&ctx, (const uint8_t *)line, (size_t)n);
+    return log.epochs == 1;
+}
+
+static void checkChecksumField(void) {
+    CHECK(ggaAccepted("%02X", "\r\n"), "checksum with CRLF accepted");
+    CHECK(ggaAccepted("%02x", "\r\n"), "lowercase checksum accepted");
+    CHECK(ggaAccepted("%02X", "\n"), "checksum with bare LF accepted");
+    CHECK(!ggaAccepted("%02X", "XYZ\r\n"), "bytes after the checksum rejected");
+    CHECK(!ggaAccepted("%02X", "7\r\n"), "third checksum digit rejected");
+    CHECK(!ggaAccepted("%02X", " \r\n"), "space after the checksum rejected");
+    CHECK(!ggaAccepted("%02X", "\rX\n"), "byte after the CR rejected");
+}
+
+
+int main(int argc, char **argv) {
+    static uint8_t stream[FEED_STREAM_MAX];
+    static uint8_t blobA[BN220_CHECKPOINT_MAX], blobB[BN220_CHECKPOINT_MAX], blobC[BN220_CHECKPOINT_MAX];
+    unsigned streams = 2000, seed = 1;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:s:")) != -1) {
+        if (opt == 'n')
+            streams = (unsigned)atoi(optarg);
+        else if (opt == 's')
+            seed = (unsigned)atoi(optarg);
+        else
+            return 2;
+    }
+    rngState = 0x9E3779B97F4A7C15ull * (seed + 1);
+
+    uint64_t digest = 0xCBF29CE484222325ull;
+    unsigned epochs = 0;
+
+    for (unsigned it = 0; it < streams; it++) {
+        BN220_Context a, b, c;
+        EpochLog      la, lb, lc;
+        uint8_t       policy = (uint8_t)rnd(3);
+        size_t        n = genStream(stream, sizeof(stream));
+        int           restoreOk;
+
+        // 1) Whole stream in one call
+        ctxInit(&a, &la, policy);
+        gpsFeed(&a, stream, n);
+        size_t na = gpsCheckpoint(&a, blobA, sizeof(blobA));
+
+        // 2) One byte at a time, as from an RX interrupt
+        ctxInit(&c, &lc, policy);
+        for (size_t i = 0; i < n; i++)
+            gpsFeed(&c, stream + i, 1);
+        size_t nc = gpsCheckpoint(&c, blobC, sizeof(blobC));
+
+        // 3) Random chunks with checkpoint/restore in between
+        size_t nb = feedChunked(&b, &lb, policy, stream, n, blobB, &restoreOk);
+
+        int before = failures;
+        CHECK(na && na == nb && na == nc, "checkpoint length");
+        CHECK(na == nb && !memcmp(blobA, blobB, na), "chunked + restored state matches one-shot");
+        CHECK(na == nc && !memcmp(blobA, blobC, na), "byte-wise state matches one-shot");
+        CHECK(restoreOk, "gpsRestore accepts its own checkpoint");
+        CHECK(la.epochs == lb.epochs && la.hash == lb.hash, "chunked epochs match one-shot");
+        CHECK(la.epochs == lc.epochs && la.hash == lc.hash, "byte-wise epochs match one-shot");
+        if (failures != before)
+            printf("  in stream %u\n", it);
+
+        digest = fnv(digest, blobA, na);
+        digest = fnv(digest, &la.hash, sizeof(la.hash));
+        epochs += la.epochs;
+        if (failures > 20)
+            break;
+    }
+
+    checkChecksumField();
+
+    // Same digest with and without BN220_USE_SWAR <=> same results on every stream
+    printf("streams %u epochs %u digest %016llx (SWAR %d)\n", streams, epochs,
+           (unsigned long long)digest, BN220_USE_SWAR);
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,217 @@
+/*
+ * test_fleet.c — Fleet store test
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    test_fleet.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   API checks and a writer/reader race on the epoch-based reclamation
+ *          of the fleet store.
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * Fleet store test: single-threaded API checks, then writers and readers
+ * racing on the same devices.
+ *
+ * Each writer owns one shard and publishes, per device, records whose
+ * fields all derive from a version number that only grows.  Readers look
+ * devices up inside read sections and check, field by field and again
+ * after a pause, that the record is intact.  They also check that a
+ * device's version never goes backwards.  A record recycled while a reader
+ * still holds it fails the first check; a lost update fails the second.
+ *
+ * Usage:  test_fleet [-n updates per writer]
+ * Exit status is 0 when every check passes.
+ */
+
+#include "BN220_fleet.h"
+#include "test_util.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#define SHARDS    4
+#define READERS   3
+#define DEVICES   512
+
+static BN220_Fleet *fleet;
+static atomic_int   writersLeft;
+static atomic_long  torn, backwards, reads;
+static long         updatesPerWriter = 400000;
+
+static void makeFix(BN220_Fix *f, uint64_t device, uint32_t version) {
+    memset(f, 0, sizeof(*f));
+    f->utc_ms = version;
+    f->lat_e7 = (int32_t)(device * 7919u + version);
+    f->lon_e7 = ~f->lat_e7;
+    f->alt_mm = (int32_t)device;
+    f->sats   = (uint8_t)version;
+}
+
+static int intact(const BN220_Fix *f, uint64_t device) {
+    uint32_t v = (uint32_t)f->utc_ms;
+    return f->lat_e7 == (int32_t)(device * 7919u + v) && f->lon_e7 == ~f->lat_e7 &&
+           f->alt_mm == (int32_t)device && f->sats == (uint8_t)v;
+}
+
+static void *writer(void *arg) {
+    uint32_t shard = (uint32_t)(uintptr_t)arg;
+    uint32_t version[DEVICES] = { 0 };
+    uint64_t mine[DEVICES];
+    size_t   n = 0;
+
+    for (uint64_t d = 0; d < DEVICES; d++)
+        if (fleetShardOf(fleet, d) == shard)
+            mine[n++] = d;
+
+    for (long i = 0; n && i < updatesPerWriter; i++) {
+        uint64_t  d = mine[i % n];
+        BN220_Fix f;
+        makeFix(&f, d, ++version[d]);
+        fleetUpdate(fleet, d, &f);
+    }
+    atomic_fetch_sub(&writersLeft, 1);
+    return NULL;
+}
+
+static void *reader(void *arg) {
+    BN220_FleetReader *r = arg;
+    uint32_t seen[DEVICES] = { 0 };
+    uint64_t x = (uintptr_t)arg;
+
+    while (atomic_load(&writersLeft) > 0) {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+        uint64_t d = (x >> 33) % DEVICES;
+
+        fleetReadBegin(fleet, r);
+        const BN220_Fix *f = fleetLookup(fleet, d);
+        if (f) {
+            volatile const BN220_Fix *vf = f;
+            BN220_Fix a = *(const BN220_Fix *)vf;
+            for (int k = 0; k < 64; k++)   // hold the record while writers move on
+                __asm__ __volatile__("" ::: "memory");
+            BN220_Fix b = *(const BN220_Fix *)vf;
+            if (!intact(&a, d) || memcmp(&a, &b, sizeof(a)))
+                atomic_fetch_add(&torn, 1);
+            else if ((uint32_t)a.utc_ms < seen[d])
+                atomic_fetch_add(&backwards, 1);
+            else
+                seen[d] = (uint32_t)a.utc_ms;
+        }
+        fleetReadEnd(r);
+        atomic_fetch_add(&reads, 1);
+    }
+    return NULL;
+}
+
+
+static void basics(void) {
+    BN220_Fleet *f = fleetCreate(2, 16, 2);
+    BN220_Fix    fix, out;
+
+    CHECK(f != NULL, "create");
+    BN220_FleetReader *r1 = fleetReaderRegister(f), *r2 = fleetReaderRegister(f);
+    CHECK(r1 && r2 && r1 != r2 && !fleetReaderRegister(f), "reader handles are limited to maxReaders");
+    fleetReaderRelease(r2);
+    CHECK((r2 = fleetReaderRegister(f)) != NULL, "a released handle can be registered again");
+
+    CHECK(!fleetGet(f, r1, 42, &out), "unknown device");
+    makeFix(&fix, 42, 1);
+    CHECK(fleetUpdate(f, 42, &fix) && fleetGet(f, r1, 42, &out) && intact(&out, 42) &&
+          out.utc_ms == 1, "insert then get");
+    makeFix(&fix, 42, 2);
+    CHECK(fleetUpdate(f, 42, &fix) && fleetGet(f, r2, 42, &out) && out.utc_ms == 2, "replace");
+
+    // Fill one shard: 8 slots per shard at this capacity
+    uint32_t shard = fleetShardOf(f, 42), inShard = 1, refused = 0;
+    for (uint64_t d = 1000; d < 1200; d++) {
+        if (fleetShardOf(f, d) != shard)
+            continue;
+        makeFix(&fix, d, 1);
+        if (fleetUpdate(f, d, &fix))
+            inShard++;
+        else
+            refused++;
+    }
+    CHECK(inShard == 8 && refused > 0, "a full shard refuses new devices");
+    CHECK(fleetGet(f, r1, 42, &out) && out.utc_ms == 2, "existing devices survive a full shard");
+
+    fleetReaderRelease(r1);
+    fleetReaderRelease(r2);
+    fleetDestroy(f);
+}
+
+
+int main(int argc, char **argv) {
+    int opt;
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        if (opt == 'n')
+            updatesPerWriter = atol(optarg);
+        else
+            return 2;
+    }
+
+    // 1) Single-threaded API
+    basics();
+
+    // 2) One writer per shard against concurrent readers
+    fleet = fleetCreate(SHARDS, 2 * DEVICES, READERS);
+    CHECK(fleet != NULL, "create");
+    if (!fleet)
+        return 1;
+
+    pthread_t          w[SHARDS], rd[READERS];
+    BN220_FleetReader *handle[READERS];
+    atomic_store(&writersLeft, SHARDS);
+    for (int i = 0; i < READERS; i++) {
+        handle[i] = fleetReaderRegister(fleet);
+        pthread_create(&rd[i], NULL, reader, handle[i]);
+    }
+    for (int i = 0; i < SHARDS; i++)
+        pthread_create(&w[i], NULL, writer, (void *)(uintptr_t)i);
+    for (int i = 0; i < SHARDS; i++)
+        pthread_join(w[i], NULL);
+    for (int i = 0; i < READERS; i++) {
+        pthread_join(rd[i], NULL);
+        fleetReaderRelease(handle[i]);
+    }
+
+    // 3) Every device ends at its writer's last version
+    BN220_FleetReader *r = fleetReaderRegister(fleet);
+    int complete = 1;
+    for (uint64_t d = 0; d < DEVICES; d++) {
+        BN220_Fix out;
+        complete &= fleetGet(fleet, r, d, &out) && intact(&out, d);
+    }
+    fleetReaderRelease(r);
+    CHECK(complete, "every device holds an intact record at the end");
+    CHECK(atomic_load(&torn) == 0, "readers never see a recycled record");
+    CHECK(atomic_load(&backwards) == 0, "a device's version never goes backwards");
+
+    printf("%d writers x %ld updates, %ld reads, %ld torn, %ld backwards\n", SHARDS,
+           updatesPerWriter, atomic_load(&reads), atomic_load(&torn), atomic_load(&backwards));
+    printf("%s\n", failures ? "FAILED" : "OK");
+    fleetDestroy(fleet);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,138 @@
+/*
+ * test_geom.c — DOP test
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    test_geom.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Satellite selection and degenerate-geometry checks, plus a table
+ *          reader for tests/check_geom.py.
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * DOP test.
+ *
+ * Without arguments, checks the satellite selection (elevation mask, SNR
+ * floor, GSA-used flag, satellites without a position) and the rejection
+ * of degenerate geometry.  With -r, reads satellite tables from stdin and
+ * prints geomDop's result for each, so tests/check_geom.py can compare it
+ * with a numpy double-precision inverse:
+ *
+ *   in:   minElev minSnr usedOnly n  (elev azim snr used) x n
+ *   out:  ret sats gdop pdop hdop vdop tdop
+ *
+ * Exit status is 0 when every check passes.
+ */
+
+#include "BN220_geom.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <unistd.h>
+
+#define GEOM_SATS_MAX 64
+
+static void setSat(BN220_Sat *s, int elev, unsigned azim, unsigned snr, int used) {
+    memset(s, 0, sizeof(*s));
+    s->elev = (int8_t)elev;
+    s->azim = (uint16_t)azim;
+    s->snr  = (uint8_t)snr;
+    s->used = (uint8_t)used;
+}
+
+static int readTables(void) {
+    char line[4096];
+
+    while (fgets(line, sizeof(line), stdin)) {
+        BN220_Sat      sats[GEOM_SATS_MAX];
+        BN220_GeomMask mask;
+        BN220_Dop      dop;
+        int  minElev, minSnr, usedOnly, n, off;
+        char *p = line;
+
+        if (sscanf(p, "%d %d %d %d%n", &minElev, &minSnr, &usedOnly, &n, &off) != 4 ||
+            n < 0 || n > GEOM_SATS_MAX)
+            return 2;
+        p += off;
+        for (int i = 0; i < n; i++) {
+            int elev, azim, snr, used;
+            if (sscanf(p, "%d %d %d %d%n", &elev, &azim, &snr, &used, &off) != 4)
+                return 2;
+            p += off;
+            setSat(&sats[i], elev, (unsigned)azim, (unsigned)snr, used);
+        }
+        mask.minElev  = (int8_t)minElev;
+        mask.minSnr   = (uint8_t)minSnr;
+        mask.usedOnly = (uint8_t)usedOnly;
+
+        int ret = geomDop(sats, (size_t)n, &mask, &dop);
+        printf("%d %u %.9g %.9g %.9g %.9g %.9g\n", ret, dop.sats, dop.gdop, dop.pdop, dop.hdop,
+               dop.vdop, dop.tdop);
+    }
+    return 0;
+}
+
+
+int main(int argc, char **argv) {
+    BN220_Sat sats[8];
+    BN220_Dop dop, ref;
+    int       opt;
+
+    while ((opt = getopt(argc, argv, "r")) != -1) {
+        if (opt == 'r')
+            return readTables();
+        return 2;
+    }
+
+    // 1) Four satellites, zenith plus three at 120° spacing: textbook case
+    setSat(&sats[0], 90, 0, 40, 1);
+    setSat(&sats[1], 20, 0, 40, 1);
+    setSat(&sats[2], 20, 120, 40, 1);
+    setSat(&sats[3], 20, 240, 40, 1);
+    CHECK(geomDop(sats, 4, NULL, &ref) && ref.sats == 4, "four well-spread satellites give a solution");
+    CHECK(ref.hdop > 0 && ref.vdop > 0 && ref.pdop * ref.pdop > ref.hdop * ref.hdop, "DOPs are consistent");
+
+    // 2) Masked-out extras must not change the result
+    setSat(&sats[4], 5, 60, 40, 1);                   // below the mask
+    setSat(&sats[5], 45, 300, 10, 1);                 // too weak
+    setSat(&sats[6], 45, 200, 40, 0);                 // not in the GSA
+    setSat(&sats[7], 45, BN220_SAT_NO_POS, 40, 1);    // no position
+    BN220_GeomMask mask = { 10, 20, 1 };
+    CHECK(geomDop(sats, 8, &mask, &dop) && dop.sats == 4, "mask keeps the four selected satellites");
+    CHECK(dop.gdop == ref.gdop && dop.hdop == ref.hdop, "masked satellites do not contribute");
+
+    // 3) Without a mask every satellite with a position counts
+    CHECK(geomDop(sats, 8, NULL, &dop) && dop.sats == 7, "NULL mask keeps all satellites with a position");
+    CHECK(dop.gdop < ref.gdop, "more satellites lower GDOP");
+
+    // 4) Fewer than four, or lines of sight that do not span four unknowns
+    CHECK(!geomDop(sats, 3, NULL, &dop) && dop.sats == 3, "three satellites are rejected");
+    for (int i = 0; i < 6; i++)
+        setSat(&sats[i], 35, (unsigned)(i * 60), 40, 1);
+    CHECK(!geomDop(sats, 6, NULL, &dop) && dop.sats == 6, "equal elevations (up = clock) are rejected");
+
+    printf("gdop %.3f pdop %.3f hdop %.3f vdop %.3f tdop %.3f (4 satellites)\n",
+           ref.gdop, ref.pdop, ref.hdop, ref.vdop, ref.tdop);
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
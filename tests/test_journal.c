@@ -0,0 +1,206 @@
+/*
+ * test_journal.c — Journal recovery test
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    test_journal.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Clean, torn-write and wrapped-ring recovery of the fix journal on
+ *          an in-memory store.
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * Journal recovery test on an in-memory store.
+ *
+ * The store can tear a group write: the whole group reaches the medium
+ * except its first block, the order in which an SD card or flash may
+ * complete a multi-block write interrupted by power loss.  Records carry
+ * their append index in device, so every replay can be compared with what
+ * was committed.
+ *
+ *   - clean sessions replay everything, in order;
+ *   - a torn group is cut at the torn block, and after the next session
+ *     rewrites that slot, its stale tail is not replayed as newer data
+ *     (also when the very first block of the store is torn);
+ *   - a circular store replays the last capacity blocks after wrapping,
+ *     skipping a torn one.
+ *
+ * Exit status is 0 when every check passes.
+ */
+
+#include "BN220_journal.h"
+#include "test_util.h"
+
+#define BS       256   // block size
+#define STAGE    4     // staging blocks
+#define MEDIUM   64    // blocks of storage
+#define PER      ((uint32_t)BN220_JOURNAL_PER_BLOCK(BS))
+
+typedef struct {
+    uint8_t  data[MEDIUM * BS];
+    uint64_t size;       // bytes ever written: reads past it fail, as past EOF
+    int      tearNext;   // corrupt the first block of the next write
+} MemStore;
+
+static MemStore mem;
+static uint64_t stage[STAGE * BS / 8];
+static uint32_t got[MEDIUM * 8];
+static size_t   nGot;
+
+static int memWrite(void *user, uint64_t offset, const void *data, size_t len) {
+    MemStore *m = user;
+    if (offset + len > sizeof(m->data))
+        return 0;
+    memcpy(m->data + offset, data, len);
+    if (m->tearNext) {
+        m->data[offset + 7] ^= 0x5A;
+        m->tearNext = 0;
+    }
+    if (offset + len > m->size)
+        m->size = offset + len;
+    return 1;
+}
+
+static int memRead(void *user, uint64_t offset, void *data, size_t len) {
+    MemStore *m = user;
+    if (offset + len > m->size)
+        return 0;
+    memcpy(data, m->data + offset, len);
+    return 1;
+}
+
+static int collect(void *user, const BN220_LogRecord *recs, size_t n) {
+    (void)user;
+    for (size_t i = 0; i < n && nGot < sizeof(got) / sizeof(got[0]); i++)
+        got[nGot++] = recs[i].device;
+    return 1;
+}
+
+// Open a session on mem and replay it into got[]
+static void session(BN220_Journal *j, uint32_t capacity) {
+    static const BN220_JournalStore store = { memWrite, memRead, NULL, &mem };
+    journalInit(j, &store, stage, sizeof(stage), BS, capacity, 1000);
+    nGot = 0;
+    journalRecover(j, collect, NULL);
+}
+
+static void append(BN220_Journal *j, uint32_t first, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        BN220_LogRecord r;
+        memset(&r, 0, sizeof(r));
+        r.device     = first + i;
+        r.fix.utc_ms = first + i;
+        journalAppend(j, &r, 1, 0);
+    }
+    journalCommit(j);
+}
+
+// got[] holds exactly first .. first + n - 1
+static int replayed(uint32_t first, uint32_t n) {
+    if (nGot != n)
+        return 0;
+    for (uint32_t i = 0; i < n; i++)
+        if (got[i] != first + i)
+            return 0;
+    return 1;
+}
+
+
+static void growing(void) {
+    BN220_Journal j;
+
+    // 1) Clean sessions
+    memset(&mem, 0, sizeof(mem));
+    session(&j, 0);
+    CHECK(nGot == 0, "empty store replays nothing");
+    append(&j, 0, 50);
+    session(&j, 0);
+    CHECK(replayed(0, 50), "clean session replays every record");
+    append(&j, 50, 30);
+    session(&j, 0);
+    CHECK(replayed(0, 80), "second session continues after the first");
+
+    // 2) One committed block; the next session's first group, three blocks,
+    //    has its first block torn
+    memset(&mem, 0, sizeof(mem));
+    session(&j, 0);
+    append(&j, 0, PER);
+    session(&j, 0);
+    mem.tearNext = 1;
+    append(&j, 1000, 3 * PER);
+    session(&j, 0);
+    CHECK(replayed(0, PER), "recovery stops at the torn block");
+    append(&j, 2000, 1);
+    session(&j, 0);
+    CHECK(nGot == PER + 1 && got[PER] == 2000, "stale blocks after a rewritten torn slot are not replayed");
+    append(&j, 3000, 1);
+    session(&j, 0);
+    CHECK(nGot == PER + 2 && got[PER + 1] == 3000, "the session after that continues normally");
+
+    // 3) The very first group of the store torn
+    memset(&mem, 0, sizeof(mem));
+    session(&j, 0);
+    mem.tearNext = 1;
+    append(&j, 1000, 3 * PER);
+    session(&j, 0);
+    CHECK(nGot == 0, "torn first block: nothing replayed");
+    append(&j, 2000, 1);
+    session(&j, 0);
+    CHECK(replayed(2000, 1), "torn first block: only the rewritten record is replayed");
+}
+
+static void circular(void) {
+    BN220_Journal j;
+    const uint32_t cap = 8;
+
+    // 1) Twenty blocks into eight slots, over several sessions
+    memset(&mem, 0, sizeof(mem));
+    session(&j, cap);
+    append(&j, 0, 7 * PER);
+    session(&j, cap);
+    append(&j, 7 * PER, 13 * PER);
+    session(&j, cap);
+    CHECK(replayed(12 * PER, 8 * PER), "circular store replays the last capacity blocks");
+
+    // 2) A torn block in the ring is skipped, the rest replays in order
+    mem.tearNext = 1;
+    append(&j, 20 * PER, 2 * PER);
+    session(&j, cap);
+    int ok = nGot == 7 * PER;
+    for (uint32_t i = 0; ok && i < 6 * PER; i++)
+        ok = got[i] == 14 * PER + i;
+    for (uint32_t i = 0; ok && i < PER; i++)
+        ok = got[6 * PER + i] == 21 * PER + i;
+    CHECK(ok, "circular store skips a torn block");
+}
+
+
+int main(void) {
+    growing();
+    circular();
+
+    printf("%u records per %u-byte block, torn-write recovery checked\n", (unsigned)PER, BS);
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * test_knn.c — test_knn.c
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    test_knn.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   k-nearest queries must match a brute-force scan, at the poles too.
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * k-nearest queries against a brute-force scan.
+ *
+ * Devices are scattered around a mid-latitude city, across the
+ * antimeridian and around both poles, where a cell is only metres wide
+ * east-west.  Every query must return the same distances as a linear scan
+ * with the same equirectangular metric, and polar queries must finish
+ * without walking every ring of the globe.
+ *
+ * Exit status is 0 when every check passes.
+ */
+
+#include "BN220_knn.h"
+#include "test_util.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define DEVICES 4000
+#define K       8
+
+static int32_t lat[DEVICES], lon[DEVICES];
+static int     queries;
+
+static float bruteDist(int32_t qlat, int32_t qlon, uint32_t d) {
+    const double m  = 6371008.8 * 3.14159265358979323846 / 180.0 / 1e7;
+    const float  my = (float)m;
+    const float  mx = (float)(m * cos(qlat * 1e-7 * 3.14159265358979323846 / 180.0));
+    int64_t dlon = (int64_t)lon[d] - qlon;
+    if (dlon >  1800000000LL) dlon -= 3600000000LL;
+    if (dlon < -1800000000LL) dlon += 3600000000LL;
+    float dx = (float)dlon * mx, dy = (float)(lat[d] - qlat) * my;
+    return sqrtf(dx * dx + dy * dy);
+}
+
+static int cmpFloat(const void *a, const void *b) {
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+// Compare one query with the scan; returns the number found
+static size_t query(const BN220_Grid *g, int32_t qlat, int32_t qlon, float maxDist_m) {
+    uint32_t dev[K];
+    float    dist[K], all[DEVICES];
+    size_t   n = gridNearest(g, qlat, qlon, K, maxDist_m, dev, dist);
+    queries++;
+
+    size_t m = 0;
+    for (uint32_t d = 0; d < DEVICES; d++) {
+        float dd = bruteDist(qlat, qlon, d);
+        if (dd <= maxDist_m)
+            all[m++] = dd;
+    }
+    qsort(all, m, sizeof(float), cmpFloat);
+
+    CHECK(n == (m < K ? m : K), "neighbour count");
+    for (size_t i = 0; i < n && i < m; i++) {
+        CHECK(fabsf(dist[i] - all[i]) <= 1e-3f * all[i] + 0.01f, "k-th distance");
+        CHECK(fabsf(dist[i] - bruteDist(qlat, qlon, dev[i])) <= 0.01f, "device matches its distance");
+    }
+    if (n != (m < K ? m : K))
+        printf("  query %.7f, %.7f: %zu found, %zu expected\n", qlat * 1e-7, qlon * 1e-7, n, m);
+    return n;
+}
+
+static int32_t clampLat(double deg) {
+    if (deg >  90.0) deg =  180.0 - deg;
+    if (deg < -90.0) deg = -180.0 - deg;
+    return (int32_t)lround(deg * 1e7);
+}
+
+static int32_t wrapLon(double deg) {
+    while (deg >= 180.0) deg -= 360.0;
+    while (deg < -180.0) deg += 360.0;
+    return (int32_t)lround(deg * 1e7);
+}
+
+int main(void) {
+    // 0.005° cells: 72 000 columns, so a polar query that walks square
+    // rings would visit billions of cells
+    BN220_Grid *g = gridCreate(DEVICES, 50000, 4096);
+    CHECK(g != NULL, "create");
+    if (!g)
+        return 1;
+
+    // 1) A quarter each: city, antimeridian, north pole, south pole
+    for (uint32_t d = 0; d < DEVICES; d++) {
+        switch (d % 4) {
+        case 0: lat[d] = clampLat(48.2 + uniform(-0.05, 0.05));  lon[d] = wrapLon(16.37 + uniform(-0.08, 0.08)); break;
+        case 1: lat[d] = clampLat(-16.5 + uniform(-0.05, 0.05)); lon[d] = wrapLon(180.0 + uniform(-0.08, 0.08)); break;
+        case 2: lat[d] = clampLat(89.99 + uniform(-0.02, 0.02)); lon[d] = wrapLon(uniform(-180.0, 180.0));       break;
+        default: lat[d] = clampLat(-89.98 + uniform(-0.02, 0.02)); lon[d] = wrapLon(uniform(-180.0, 180.0));     break;
+        }
+        CHECK(gridUpdate(g, d, lat[d], lon[d]), "update");
+    }
+
+    // 2) Queries around each cluster, at the poles themselves, and out of range
+    size_t found = 0;
+    for (int i = 0; i < 50; i++) {
+        found += query(g, clampLat(48.2 + uniform(-0.06, 0.06)), wrapLon(16.37 + uniform(-0.1, 0.1)), 2000.0f);
+        found += query(g, clampLat(-16.5 + uniform(-0.06, 0.06)), wrapLon(180.0 + uniform(-0.1, 0.1)), 2000.0f);
+        found += query(g, clampLat(89.99 + uniform(-0.03, 0.03)), wrapLon(uniform(-180.0, 180.0)), 3000.0f);
+        found += query(g, clampLat(-89.98 + uniform(-0.03, 0.03)), wrapLon(uniform(-180.0, 180.0)), 3000.0f);
+    }
+    found += query(g, 900000000, 0, 5000.0f);
+    found += query(g, -900000000, 1234567, 5000.0f);
+    found += query(g, 0, 0, 5000.0f);
+
+    // 3) Without distance storage there is nothing to search with
+    uint32_t dev[K];
+    CHECK(gridNearest(g, 0, 0, K, 1e7f, dev, NULL) == 0, "dist_m required");
+
+    gridDestroy(g);
+    printf("%zu neighbours in %d queries\n", found, queries);
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,129 @@
+/*
+ * test_parquet.c — Parquet writer read-back test
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    test_parquet.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Writes a synthetic track to Parquet and to a raw file for
+ *          tests/check_parquet.py.
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * Parquet writer read-back, C side.
+ *
+ * Writes a synthetic track (jumps in time, sign changes, extreme altitudes
+ * and speeds, no-fix rows) to a Parquet file through parquetWrite, and the
+ * same rows to a raw little-endian file.  tests/check_parquet.py then reads
+ * the Parquet file with pyarrow and compares every column and every row
+ * group's min/max statistics against the raw rows.
+ *
+ * Usage:  test_parquet [-w] out.parquet out.raw rows rowGroupRows
+ *   -w  one device id per row and full-range hdop; with row groups over
+ *       65536 rows the device column exceeds the dictionary limit and
+ *       takes the delta fallback
+ *
+ * Raw row layout (30 bytes): device u32, utc_ms i64, lat_e7 i32, lon_e7 i32,
+ * alt_mm i32, speed_cms u16, hdop_c u16, sats u8, fix u8.
+ */
+
+#include "BN220_parquet.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <unistd.h>
+
+static void putLE(FILE *f, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; i++)
+        fputc((int)(v >> (8 * i)) & 0xFF, f);
+}
+
+
+int main(int argc, char **argv) {
+    int wide = 0, opt;
+    while ((opt = getopt(argc, argv, "w")) != -1) {
+        if (opt == 'w')
+            wide = 1;
+        else
+            return 2;
+    }
+    if (argc - optind != 4)
+        return 2;
+
+    const char *pqPath = argv[optind], *rawPath = argv[optind + 1];
+    size_t      rows = (size_t)atol(argv[optind + 2]);
+    uint32_t    group = (uint32_t)atol(argv[optind + 3]);
+
+    BN220_Parquet *pq = parquetOpen(pqPath, group);
+    FILE *raw = fopen(rawPath, "wb");
+    if (!pq || !raw) {
+        printf("FAIL: cannot create output files\n");
+        return 1;
+    }
+
+    BN220_Fix f;
+    memset(&f, 0, sizeof(f));
+    int64_t t = 1760000000000LL;
+    int32_t lat = 412345678, lon = 290000000;
+
+    for (size_t i = 0; i < rows; i++) {
+        // 1) A plausible track with the odd edge case mixed in
+        t   += 1000 + (rnd(3) == 0 ? rnd(5000) : 0);
+        lat += (int32_t)rnd(2001) - 1000;
+        lon += (int32_t)rnd(2001) - 1000;
+        if (i % 100000 == 7)
+            lat = -lat;
+        f.utc_ms    = t;
+        f.lat_e7    = lat;
+        f.lon_e7    = lon;
+        f.alt_mm    = i % 50000 == 3 ? -2147483647 : 100000 + (int32_t)rnd(1000);
+        f.speed_cms = (uint16_t)(i % 70000 == 5 ? 65535 : rnd(3000));
+        f.hdop_c    = (uint16_t)(wide ? rnd(65536) : 80 + rnd(40));
+        f.sats      = (uint8_t)(4 + rnd(10));
+        f.fix       = (uint8_t)(i % 1000 < 990 ? 1 : i % 1000 < 995 ? 0 : 200);
+        uint32_t dev = wide ? (uint32_t)i * 2654435761u
+                            : i % 7 == 0 ? 4000000000u + (uint32_t)(i % 5) : (uint32_t)(i % 13);
+
+        // 2) Same row to both files
+        if (!parquetWrite(pq, &dev, &f, 1)) {
+            printf("FAIL: parquetWrite at row %zu\n", i);
+            return 1;
+        }
+        putLE(raw, dev, 4);
+        putLE(raw, (uint64_t)f.utc_ms, 8);
+        putLE(raw, (uint32_t)f.lat_e7, 4);
+        putLE(raw, (uint32_t)f.lon_e7, 4);
+        putLE(raw, (uint32_t)f.alt_mm, 4);
+        putLE(raw, f.speed_cms, 2);
+        putLE(raw, f.hdop_c, 2);
+        putLE(raw, f.sats, 1);
+        putLE(raw, f.fix, 1);
+    }
+
+    if (fclose(raw) != 0 || !parquetClose(pq)) {
+        printf("FAIL: closing output files\n");
+        return 1;
+    }
+    printf("wrote %zu rows\n", rows);
+    return 0;
+}
@@ -0,0 +1,195 @@
+/*
+ * test_rollup.c — test_rollup.c
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    test_rollup.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Rollup buckets must match the fixes they summarise.
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * Time-bucket rollup test.
+ *
+ * Random fix streams (gaps, clock steps backwards, ms-of-day wraps,
+ * negative timestamps, no-fix epochs and field values equal to the
+ * min/max sentinels) go through a per-minute rollup.  Every emitted bucket
+ * is compared with one recomputed from the fixes of its run, and the
+ * minutes folded with rollupCombine() must equal an hourly rollup of the
+ * same stream.
+ *
+ * Exit status is 0 when every check passes.
+ */
+
+#include "BN220_rollup.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define FIXES    200000
+#define BUCKETS  FIXES
+
+typedef struct {
+    BN220_RollupBucket *b;
+    size_t              n;
+} BucketLog;
+
+static void onBucket(void *user, const BN220_RollupBucket *b) {
+    BucketLog *log = user;
+    log->b[log->n++] = *b;
+}
+
+static int64_t floorStart(int64_t t, int64_t w) {
+    return t - ((t % w) + w) % w;
+}
+
+static BN220_Fix genFix(int64_t *t) {
+    BN220_Fix f;
+    memset(&f, 0, sizeof(f));
+    switch (rnd(400)) {
+    case 0:  *t -= 1 + (int64_t)rnd(600000); break;          // clock step back
+    case 1:  *t += (int64_t)rnd(3600000) * 10; break;        // long gap
+    case 2:  *t = 86400000 - 1 - (int64_t)rnd(3000); break;  // just before a ms-of-day wrap
+    case 3:  *t = -(int64_t)rnd(200000); break;              // before 1970
+    default: *t += (int64_t)rnd(rnd(8) ? 1500 : 40000); break;
+    }
+    if (*t >= 86400000 && *t < 86400000 + 5000 && rnd(2))
+        *t -= 86400000;                                      // ms-of-day wrap
+    f.utc_ms    = *t;
+    f.fix       = rnd(6) != 0;
+    f.speed_cms = (uint16_t)(rnd(20) ? rnd(4000) : (rnd(2) ? 0 : UINT16_MAX));
+    f.hdop_c    = (uint16_t)(rnd(20) ? 50 + rnd(400) : (rnd(2) ? 0 : UINT16_MAX));
+    f.alt_mm    = rnd(20) ? (int32_t)rnd(2000000) - 100000 : (rnd(2) ? INT32_MIN : INT32_MAX);
+    f.sats      = (uint8_t)(rnd(20) ? 4 + rnd(20) : (rnd(2) ? 0 : UINT8_MAX));
+    return f;
+}
+
+// Bucket recomputed from fixes[from..to), which all share one bucket
+static BN220_RollupBucket reference(const BN220_Fix *fx, size_t from, size_t to, uint32_t width) {
+    BN220_RollupBucket r;
+    memset(&r, 0, sizeof(r));
+    r.start_ms = floorStart(fx[from].utc_ms, width);
+    r.width_ms = width;
+    for (size_t i = from; i < to; i++) {
+        const BN220_Fix *f = &fx[i];
+        r.epochs++;
+        if (!f->fix)
+            continue;
+        int first = !r.valid++;
+        if (first || f->speed_cms < r.speedMin_cms) r.speedMin_cms = f->speed_cms;
+        if (first || f->speed_cms > r.speedMax_cms) r.speedMax_cms = f->speed_cms;
+        if (first || f->hdop_c < r.hdopMin_c)       r.hdopMin_c    = f->hdop_c;
+        if (first || f->hdop_c > r.hdopMax_c)       r.hdopMax_c    = f->hdop_c;
+        if (first || f->alt_mm < r.altMin_mm)       r.altMin_mm    = f->alt_mm;
+        if (first || f->alt_mm > r.altMax_mm)       r.altMax_mm    = f->alt_mm;
+        if (first || f->sats < r.satsMin)           r.satsMin      = f->sats;
+        if (first || f->sats > r.satsMax)           r.satsMax      = f->sats;
+        r.speedSum_cms += f->speed_cms;
+        r.hdopSum_c    += f->hdop_c;
+        r.altSum_mm    += f->alt_mm;
+        r.satsSum      += f->sats;
+    }
+    return r;
+}
+
+static int sameBucket(const BN220_RollupBucket *a, const BN220_RollupBucket *b) {
+    return a->start_ms == b->start_ms && a->width_ms == b->width_ms && a->epochs == b->epochs &&
+           a->valid == b->valid && a->speedMin_cms == b->speedMin_cms &&
+           a->speedMax_cms == b->speedMax_cms && a->hdopMin_c == b->hdopMin_c &&
+           a->hdopMax_c == b->hdopMax_c && a->altMin_mm == b->altMin_mm &&
+           a->altMax_mm == b->altMax_mm && a->satsMin == b->satsMin && a->satsMax == b->satsMax &&
+           a->speedSum_cms == b->speedSum_cms && a->hdopSum_c == b->hdopSum_c &&
+           a->altSum_mm == b->altSum_mm && a->satsSum == b->satsSum;
+}
+
+
+int main(void) {
+    BN220_Fix *fx = malloc(sizeof(*fx) * FIXES);
+    BucketLog  minutes = { malloc(sizeof(BN220_RollupBucket) * BUCKETS), 0 };
+    BucketLog  hours   = { malloc(sizeof(BN220_RollupBucket) * BUCKETS), 0 };
+    if (!fx || !minutes.b || !hours.b)
+        return 1;
+
+    // 1) One stream through a minute and an hour rollup
+    BN220_Rollup rm, rh;
+    rollupInit(&rm, 0, onBucket, &minutes);
+    rollupInit(&rh, 3600000, onBucket, &hours);
+    CHECK(rm.cur.width_ms == BN220_ROLLUP_MINUTE, "width 0 selects a minute");
+    rollupFlush(&rm);
+    CHECK(minutes.n == 0, "nothing emitted before the first fix");
+
+    int64_t t = 1760000000000LL % 86400000;
+    for (size_t i = 0; i < FIXES; i++) {
+        fx[i] = genFix(&t);
+        rollupEpochSink(&rm, &fx[i]);
+        rollupUpdate(&rh, &fx[i]);
+    }
+    rollupFlush(&rm);
+    rollupFlush(&rh);
+    rollupFlush(&rm);
+
+    // 2) Every minute bucket against the fixes of its run
+    size_t from = 0, k = 0, empty = 0;
+    for (size_t i = 1; i <= FIXES; i++) {
+        if (i < FIXES && floorStart(fx[i].utc_ms, 60000) == floorStart(fx[from].utc_ms, 60000))
+            continue;
+        BN220_RollupBucket want = reference(fx, from, i, 60000);
+        if (k < minutes.n && !sameBucket(&minutes.b[k], &want)) {
+            CHECK(0, "minute bucket matches its fixes");
+            printf("  bucket %zu (fixes %zu..%zu, start %lld)\n", k, from, i, (long long)want.start_ms);
+        }
+        empty += !want.valid;
+        k++;
+        from = i;
+        if (failures > 10)
+            break;
+    }
+    CHECK(k == minutes.n, "one minute bucket per run of fixes");
+
+    // 3) Consecutive minutes of one hour folded together equal the hour
+    size_t h = 0, folded = 0;
+    for (size_t i = 0; i < minutes.n && h < hours.n && failures <= 10; h++) {
+        BN220_RollupBucket acc;
+        memset(&acc, 0, sizeof(acc));
+        acc.start_ms = floorStart(minutes.b[i].start_ms, 3600000);
+        acc.width_ms = 3600000;
+        do {
+            rollupCombine(&acc, &minutes.b[i++]);
+            folded++;
+        } while (i < minutes.n && floorStart(minutes.b[i].start_ms, 3600000) == acc.start_ms);
+        if (!sameBucket(&acc, &hours.b[h])) {
+            CHECK(0, "folded minutes match the hour");
+            printf("  hour %zu (start %lld)\n", h, (long long)acc.start_ms);
+        }
+    }
+    CHECK(h == hours.n && folded == minutes.n, "every minute folds into one hour");
+
+    printf("%u fixes, %zu minute buckets (%zu without a fix), %zu hours\n",
+           FIXES, minutes.n, empty, hours.n);
+    printf("%s\n", failures ? "FAILED" : "OK");
+    free(fx);
+    free(minutes.b);
+    free(hours.b);
+    return failures ? 1 : 0;
+}
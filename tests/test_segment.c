@@ -0,0 +1,108 @@
+/*
+ * test_segment.c — Segmentation test
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    test_segment.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Stops and trips across the antimeridian must keep their real
+ *          distances.
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * Stop/trip segmentation across the antimeridian.
+ *
+ * A vehicle parks with its position noise straddling 180°, so consecutive
+ * longitudes jump between +179.9999998° and -179.9999998°, then drives
+ * 12 km east across the antimeridian and stops again.  The segmenter must
+ * see a 2 cm jitter and a 12 km trip, not 40 000 km ones, and put the
+ * first stop's centroid at 180°.
+ *
+ * Exit status is 0 when every check passes.
+ */
+
+#include "BN220_segment.h"
+#include "test_util.h"
+#include <stdlib.h>
+
+#define MAX_EVENTS 16
+
+static BN220_SegEvent events[MAX_EVENTS];
+static int            nEvents;
+
+static void onEvent(void *user, const BN220_SegEvent *ev) {
+    (void)user;
+    if (nEvents < MAX_EVENTS)
+        events[nEvents++] = *ev;
+}
+
+static void feed(BN220_Segmenter *seg, int64_t t_s, int32_t lon_e7, uint16_t speed_cms) {
+    BN220_Fix f;
+    memset(&f, 0, sizeof(f));
+    f.utc_ms    = t_s * 1000;
+    f.lat_e7    = 0;
+    f.lon_e7    = lon_e7;
+    f.speed_cms = speed_cms;
+    f.fix       = 1;
+    segUpdate(seg, &f);
+}
+
+
+int main(void) {
+    BN220_Segmenter seg;
+    int64_t         t = 0;
+
+    segInit(&seg, onEvent, NULL);
+
+    // 1) Parked on the antimeridian for 5 minutes
+    for (; t < 300; t++)
+        feed(&seg, t, t & 1 ? 1799999998 : -1799999998, 0);
+    CHECK(nEvents == 1 && events[0].type == BN220_SEG_STOP_START, "parked across 180°: one stop, no trip");
+    CHECK(nEvents >= 1 && abs(events[0].lon_e7) >= 1799999990, "stop centroid at 180°");
+
+    // 2) Drive east at 20 m/s for 10 minutes, across 180° (1e-7° ~ 1.1132 cm here)
+    int64_t lon = 1799999998;
+    for (int k = 0; k < 600; k++, t++) {
+        lon += 1797;
+        if (lon >= 1800000000)
+            lon -= 3600000000LL;
+        feed(&seg, t, (int32_t)lon, 2000);
+    }
+
+    // 3) Stop again
+    for (int k = 0; k < 300; k++, t++)
+        feed(&seg, t, (int32_t)lon, 0);
+
+    const BN220_SegEvent *trip = NULL;
+    for (int i = 0; i < nEvents; i++)
+        if (events[i].type == BN220_SEG_STOP_START && i > 0)
+            trip = &events[i];
+    CHECK(nEvents == 4 && events[1].type == BN220_SEG_STOP_END &&
+          events[2].type == BN220_SEG_TRIP_START, "stop end, trip start, stop start");
+    CHECK(trip && trip->distance_m > 11500 && trip->distance_m < 12500, "trip distance about 12 km");
+
+    printf("%d events, trip %u m across 180°\n", nEvents, trip ? trip->distance_m : 0);
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
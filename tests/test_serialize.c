@@ -0,0 +1,394 @@
+/*
+ * test_serialize.c — JSON Lines / CSV round-trip test
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    test_serialize.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   A million fixes rendered by serFixes in every layout must parse
+ *          back bit-exact.
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * JSON Lines / CSV round trip.
+ *
+ * Renders a million fixes (random values plus the integer extremes of every
+ * field) with serFixes in both formats, with and without device ids, into
+ * buffers of random size so records keep stopping at the buffer end.  Each
+ * chunk is parsed back with a strict reader that expects exactly the
+ * documented keys, separators and decimal places, and every value must
+ * come back bit-exact.  Random satellite tables go through serSats the
+ * same way, including tables without positions and odd talker bytes.
+ *
+ * Usage:  test_serialize [-n fixes]
+ * Exit status is 0 when every record round-trips.
+ */
+
+#include "BN220_serialize.h"
+#include "test_util.h"
+#include <stdio.h>
+#include <unistd.h>
+
+#define SER_CHUNK_MAX  65536
+
+
+/* --- Strict reader --------------------------------------------------------- */
+
+typedef struct {
+    const char *p, *end;
+    int         ok;
+} Reader;
+
+static void expect(Reader *r, const char *lit) {
+    size_t n = strlen(lit);
+    if (r->ok && (size_t)(r->end - r->p) >= n && !memcmp(r->p, lit, n))
+        r->p += n;
+    else
+        r->ok = 0;
+}
+
+// Optional '-', an integer part without leading zeros, then exactly
+// @p decimals fraction digits when decimals > 0
+static int64_t readFixed(Reader *r, unsigned decimals) {
+    int      neg = 0;
+    uint64_t v = 0;
+    unsigned digits = 0;
+
+    if (r->ok && r->p < r->end && *r->p == '-') {
+        neg = 1;
+        r->p++;
+    }
+    const char *start = r->p;
+    for (; r->ok && r->p < r->end && *r->p >= '0' && *r->p <= '9'; r->p++, digits++)
+        v = v * 10 + (uint64_t)(*r->p - '0');
+    if (!digits || digits > 19 || (digits > 1 && *start == '0'))
+        r->ok = 0;
+
+    if (decimals) {
+        expect(r, ".");
+        for (unsigned i = 0; i < decimals; i++) {
+            if (!r->ok || r->p >= r->end || *r->p < '0' || *r->p > '9') {
+                r->ok = 0;
+                break;
+            }
+            v = v * 10 + (uint64_t)(*r->p++ - '0');
+        }
+    }
+    return neg ? (int64_t)(0 - v) : (int64_t)v;
+}
+
+static int readFix(Reader *r, BN220_SerFormat format, int withDevice, uint32_t *device, BN220_Fix *f) {
+    memset(f, 0, sizeof(*f));
+    if (format == BN220_SER_JSON) {
+        expect(r, "{");
+        if (withDevice) {
+            expect(r, "\"device\":");
+            *device = (uint32_t)readFixed(r, 0);
+            expect(r, ",");
+        }
+        expect(r, "\"utc_ms\":");  f->utc_ms    = readFixed(r, 0);
+        expect(r, ",\"lat\":");    f->lat_e7    = (int32_t)readFixed(r, 7);
+        expect(r, ",\"lon\":");    f->lon_e7    = (int32_t)readFixed(r, 7);
+        expect(r, ",\"alt\":");    f->alt_mm    = (int32_t)readFixed(r, 3);
+        expect(r, ",\"speed\":");  f->speed_cms = (uint16_t)readFixed(r, 2);
+        expect(r, ",\"hdop\":");   f->hdop_c    = (uint16_t)readFixed(r, 2);
+        expect(r, ",\"sats\":");   f->sats      = (uint8_t)readFixed(r, 0);
+        expect(r, ",\"fix\":");    f->fix       = (uint8_t)readFixed(r, 0);
+        expect(r, "}\n");
+    } else {
+        if (withDevice) {
+            *device = (uint32_t)readFixed(r, 0);
+            expect(r, ",");
+        }
+        f->utc_ms    = readFixed(r, 0);           expect(r, ",");
+        f->lat_e7    = (int32_t)readFixed(r, 7);  expect(r, ",");
+        f->lon_e7    = (int32_t)readFixed(r, 7);  expect(r, ",");
+        f->alt_mm    = (int32_t)readFixed(r, 3);  expect(r, ",");
+        f->speed_cms = (uint16_t)readFixed(r, 2); expect(r, ",");
+        f->hdop_c    = (uint16_t)readFixed(r, 2); expect(r, ",");
+        f->sats      = (uint8_t)readFixed(r, 0);  expect(r, ",");
+        f->fix       = (uint8_t)readFixed(r, 0);  expect(r, "\n");
+    }
+    return r->ok;
+}
+
+static int sameFix(const BN220_Fix *a, const BN220_Fix *b) {
+    return a->utc_ms == b->utc_ms && a->lat_e7 == b->lat_e7 && a->lon_e7 == b->lon_e7 &&
+           a->alt_mm == b->alt_mm && a->speed_cms == b->speed_cms && a->hdop_c == b->hdop_c &&
+           a->sats == b->sats && a->fix == b->fix;
+}
+
+
+// A number, or null / an empty CSV field when the satellite has no position
+static int64_t readOpt(Reader *r, const char *none, int *present) {
+    size_t n = strlen(none);
+    *present = !(r->ok && (size_t)(r->end - r->p) >= n && !memcmp(r->p, none, n) &&
+                 (r->p + n == r->end || r->p[n] == ',' || r->p[n] == '\n'));
+    if (*present)
+        return readFixed(r, 0);
+    r->p += n;
+    return 0;
+}
+
+static int readSat(Reader *r, BN220_SerFormat format, BN220_Sat *s) {
+    int hasElev, hasAzim;
+    memset(s, 0, sizeof(*s));
+    if (format == BN220_SER_JSON) {
+        expect(r, "{\"prn\":");
+        s->prn = (uint8_t)readFixed(r, 0);
+        expect(r, ",\"talker\":\"");
+        s->talker = r->ok && r->p < r->end ? *r->p++ : 0;
+        expect(r, "\",\"elev\":");
+        s->elev = (int8_t)readOpt(r, "null", &hasElev);
+        expect(r, ",\"azim\":");
+        s->azim = (uint16_t)readOpt(r, "null", &hasAzim);
+        expect(r, ",\"snr\":");
+        s->snr = (uint8_t)readFixed(r, 0);
+        expect(r, ",\"used\":");
+        s->used = (uint8_t)readFixed(r, 0);
+        expect(r, "}");
+    } else {
+        s->prn = (uint8_t)readFixed(r, 0);           expect(r, ",");
+        s->talker = r->ok && r->p < r->end ? *r->p++ : 0;
+        expect(r, ",");
+        s->elev = (int8_t)readOpt(r, "", &hasElev);    expect(r, ",");
+        s->azim = (uint16_t)readOpt(r, "", &hasAzim);  expect(r, ",");
+        s->snr  = (uint8_t)readFixed(r, 0);           expect(r, ",");
+        s->used = (uint8_t)readFixed(r, 0);           expect(r, "\n");
+    }
+    if (hasElev != hasAzim)
+        r->ok = 0;
+    if (!hasAzim)
+        s->azim = BN220_SAT_NO_POS;
+    return r->ok;
+}
+
+static int sameSat(const BN220_Sat *got, const BN220_Sat *want) {
+    char talker = want->talker >= 'A' && want->talker <= 'Z' ? want->talker : '?';
+    int  noPos  = want->azim == BN220_SAT_NO_POS;
+    return got->prn == want->prn && got->talker == talker && got->snr == want->snr &&
+           got->used == want->used && got->azim == want->azim &&
+           (noPos || got->elev == want->elev);
+}
+
+static int satsRoundTrip(size_t epochs, uint64_t *bytes) {
+    static char buf[BN220_SER_SATS_MAX(64)];
+    BN220_Sat   sats[64], got;
+
+    for (size_t e = 0; e < epochs; e++) {
+        // 1) A random table: sometimes empty, some satellites without a position
+        size_t  n      = (size_t)(rnd64() % 65);
+        int64_t utc_ms = e < 2 ? (e ? INT64_MAX : INT64_MIN) : (int64_t)rnd64();
+        for (size_t i = 0; i < n; i++) {
+            uint64_t a = rnd64();
+            sats[i].prn      = (uint8_t)a;
+            sats[i].talker   = a >> 8 & 1 ? (char)('A' + (a >> 9) % 26) : (char)(a >> 16);
+            sats[i].elev     = (int8_t)(a >> 24);
+            sats[i].snr      = (uint8_t)(a >> 32);
+            sats[i].azim     = (uint16_t)(a >> 40) % 4 ? (uint16_t)(a >> 40) : BN220_SAT_NO_POS;
+            sats[i].used     = (uint8_t)(a >> 56);
+            sats[i].reserved = 0;
+        }
+
+        for (int format = BN220_SER_JSON; format <= BN220_SER_CSV; format++) {
+            const char *name = format == BN220_SER_JSON ? "JSON" : "CSV";
+
+            // 2) Nothing below the documented size, everything at it
+            if (serSats(buf, BN220_SER_SATS_MAX(n) - 1, format, utc_ms, sats, n) != 0) {
+                printf("FAIL: %s sats written below BN220_SER_SATS_MAX\n", name);
+                return 0;
+            }
+            size_t len = serSats(buf, BN220_SER_SATS_MAX(n), format, utc_ms, sats, n);
+            if (!len && (n || format == BN220_SER_JSON)) {
+                printf("FAIL: %s sats epoch %zu: %zu bytes for %zu satellites\n", name, e, len, n);
+                return 0;
+            }
+
+            // 3) Parse back
+            Reader r = { buf, buf + len, 1 };
+            if (format == BN220_SER_JSON) {
+                expect(&r, "{\"utc_ms\":");
+                if (readFixed(&r, 0) != utc_ms)
+                    r.ok = 0;
+                expect(&r, ",\"sats\":[");
+            }
+            for (size_t i = 0; i < n && r.ok; i++) {
+                if (format == BN220_SER_JSON && i)
+                    expect(&r, ",");
+                if (format == BN220_SER_CSV) {
+                    if (readFixed(&r, 0) != utc_ms)
+                        r.ok = 0;
+                    expect(&r, ",");
+                }
+                if (readSat(&r, format, &got) && !sameSat(&got, &sats[i])) {
+                    printf("FAIL: %s sats epoch %zu, satellite %zu differs\n", name, e, i);
+                    return 0;
+                }
+            }
+            if (format == BN220_SER_JSON)
+                expect(&r, "]}\n");
+            if (!r.ok || r.p != r.end) {
+                printf("FAIL: %s sats epoch %zu does not parse: %.80s\n", name, e, r.p);
+                return 0;
+            }
+            *bytes += len;
+        }
+    }
+
+    size_t h = serCsvSatHeader(buf, sizeof(buf));
+    if (h != strlen("utc_ms,prn,talker,elev,azim,snr,used\n") ||
+        memcmp(buf, "utc_ms,prn,talker,elev,azim,snr,used\n", h)) {
+        printf("FAIL: CSV satellite header\n");
+        return 0;
+    }
+    return 1;
+}
+
+
+/* --- One format/device combination ----------------------------------------- */
+
+static int roundTrip(const BN220_Fix *fix, const uint32_t *device, size_t n,
+                     BN220_SerFormat format, uint64_t *bytes) {
+    static char buf[SER_CHUNK_MAX];
+    const char *name = format == BN220_SER_JSON ? "JSON" : "CSV";
+    size_t off = 0;
+
+    // 1) CSV header, with the device column only when ids are passed
+    if (format == BN220_SER_CSV) {
+        size_t h = serCsvFixHeader(buf, sizeof(buf), device != NULL);
+        const char *want = device ? "device,utc_ms,lat,lon,alt,speed,hdop,sats,fix\n"
+                                  : "utc_ms,lat,lon,alt,speed,hdop,sats,fix\n";
+        if (h != strlen(want) || memcmp(buf, want, h)) {
+            printf("FAIL: CSV header (device %d)\n", device != NULL);
+            return 0;
+        }
+    }
+
+    // 2) Chunks of random capacity, each parsed back on its own
+    while (off < n) {
+        size_t cap  = BN220_SER_FIX_MAX + (size_t)(rnd64() % (SER_CHUNK_MAX - BN220_SER_FIX_MAX));
+        size_t done = 0;
+        size_t len  = serFixes(buf, cap, format, device ? device + off : NULL, fix + off, n - off, &done);
+        if (!done || len > cap) {
+            printf("FAIL: %s chunk at fix %zu: %zu fixes in %zu/%zu bytes\n", name, off, done, len, cap);
+            return 0;
+        }
+
+        Reader r = { buf, buf + len, 1 };
+        for (size_t i = 0; i < done; i++) {
+            uint32_t  dev = 0;
+            BN220_Fix got;
+            if (!readFix(&r, format, device != NULL, &dev, &got)) {
+                printf("FAIL: %s fix %zu does not parse: %.80s\n", name, off + i, r.p);
+                return 0;
+            }
+            if (!sameFix(&got, &fix[off + i]) || (device && dev != device[off + i])) {
+                printf("FAIL: %s fix %zu differs after the round trip\n", name, off + i);
+                return 0;
+            }
+        }
+        if (r.p != r.end) {
+            printf("FAIL: %s chunk at fix %zu has trailing bytes\n", name, off);
+            return 0;
+        }
+        *bytes += len;
+        off += done;
+    }
+
+    // 3) Below BN220_SER_FIX_MAX nothing is written
+    size_t done = 1;
+    if (serFixes(buf, BN220_SER_FIX_MAX - 1, format, device, fix, n, &done) != 0 || done != 0) {
+        printf("FAIL: %s writes into a buffer below BN220_SER_FIX_MAX\n", name);
+        return 0;
+    }
+    return 1;
+}
+
+
+int main(int argc, char **argv) {
+    size_t n = 1000000;
+    int    opt, failures = 0;
+
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        if (opt == 'n')
+            n = (size_t)atol(optarg);
+        else
+            return 2;
+    }
+    if (n < 8)
+        n = 8;
+
+    BN220_Fix *fix    = calloc(n, sizeof(*fix));
+    uint32_t  *device = calloc(n, sizeof(*device));
+    if (!fix || !device)
+        return 1;
+
+    // 1) Random values over each field's full range...
+    for (size_t i = 0; i < n; i++) {
+        uint64_t a = rnd64(), b = rnd64();
+        fix[i].utc_ms    = (int64_t)rnd64();
+        fix[i].lat_e7    = (int32_t)(uint32_t)a;
+        fix[i].lon_e7    = (int32_t)(uint32_t)(a >> 32);
+        fix[i].alt_mm    = (int32_t)(uint32_t)b;
+        fix[i].speed_cms = (uint16_t)(b >> 32);
+        fix[i].hdop_c    = (uint16_t)(b >> 48);
+        fix[i].sats      = (uint8_t)rnd64();
+        fix[i].fix       = (uint8_t)rnd64();
+        device[i]        = (uint32_t)rnd64();
+        // ...and small magnitudes, where the fraction needs leading zeros
+        if (i % 3 == 0) {
+            fix[i].lat_e7 %= 1000;
+            fix[i].alt_mm %= 100;
+            fix[i].hdop_c %= 10;
+        }
+    }
+
+    // 2) Integer extremes
+    static const int64_t edge64[] = { INT64_MIN, INT64_MAX, 0, -1 };
+    static const int32_t edge32[] = { INT32_MIN, INT32_MAX, 0, -1 };
+    for (size_t i = 0; i < 4; i++) {
+        fix[i].utc_ms    = edge64[i];
+        fix[i].lat_e7    = fix[i].lon_e7 = fix[i].alt_mm = edge32[i];
+        fix[i].speed_cms = fix[i].hdop_c = i & 1 ? UINT16_MAX : 0;
+        fix[i].sats      = fix[i].fix = i & 1 ? UINT8_MAX : 0;
+        device[i]        = i & 1 ? UINT32_MAX : 0;
+    }
+
+    // 3) Every format, with and without device ids
+    uint64_t bytes = 0;
+    failures += !roundTrip(fix, NULL,   n, BN220_SER_JSON, &bytes);
+    failures += !roundTrip(fix, device, n, BN220_SER_JSON, &bytes);
+    failures += !roundTrip(fix, NULL,   n, BN220_SER_CSV,  &bytes);
+    failures += !roundTrip(fix, device, n, BN220_SER_CSV,  &bytes);
+
+    // 4) Satellite tables, one epoch per 100 fixes
+    failures += !satsRoundTrip(n / 100, &bytes);
+
+    printf("%zu fixes x 4 layouts + %zu satellite tables, %llu bytes parsed back\n", n, n / 100,
+           (unsigned long long)bytes);
+    printf("%s\n", failures ? "FAILED" : "OK");
+    free(fix);
+    free(device);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * test_sigmon.c — Signal monitor test
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    test_sigmon.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   The C/N0 monitor must keep receiving GSV tables, and raise a
+ *          uniform drop, while the receiver has no fix.
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * Signal monitor test through the streaming parser.
+ *
+ * A synthetic BN-220 stream (RMC, GGA, GSA, GSV groups, GLL per epoch) is
+ * fed to gpsFeed with sigmonUpdateGps driven from ctx.onSats.  From epoch
+ * JAM_EPOCH every satellite loses JAM_DB of C/N0; in the main run the
+ * receiver also loses its fix, so GGA carries no position and onEpoch
+ * stops.  The monitor must still see every table and raise UNIFORM_DROP,
+ * exactly as in the control run where the fix is kept.
+ *
+ * Exit status is 0 when every check passes.
+ */
+
+#include "BN220_sigmon.h"
+#include "test_util.h"
+#include <stdlib.h>
+
+#define EPOCHS     60
+#define JAM_EPOCH  40
+#define JAM_DB     25
+#define SATS       8
+
+typedef struct {
+    BN220_SigMon mon;
+    unsigned     tables, updates, epochs, sats, drops;
+    float        dropDb;
+} Run;
+
+static void onEvent(void *user, const BN220_SigEvent *ev) {
+    Run *r = user;
+    if (ev->type == BN220_SIG_UNIFORM_DROP && ev->active) {
+        r->drops++;
+        r->dropDb = ev->value;
+    }
+}
+
+static void onSats(void *user, const BN220_GPS *gps) {
+    Run *r = user;
+    r->tables++;
+    r->sats = gps->satCount;
+    r->updates += (unsigned)sigmonUpdateGps(&r->mon, gps, r->tables);
+}
+
+static void onEpoch(void *user, const BN220_Fix *fix) {
+    (void)fix;
+    ((Run *)user)->epochs++;
+}
+
+// "$<body>*CS\r\n" appended at p
+static char *put(char *p, const char *body) {
+    uint8_t cs = 0;
+    for (const char *b = body; *b; b++)
+        cs ^= (uint8_t)*b;
+    return p + sprintf(p, "$%s*%02X\r\n", body, cs);
+}
+
+static size_t genEpoch(char *out, int t, int jammed, int keepFix) {
+    char body[96], *p = out;
+    int  fix = !jammed || keepFix;
+
+    sprintf(body, "GPRMC,1200%02d.00,%c,4100.00000,N,02900.00000,E,0.0,0.0,181026,,,A",
+            t % 60, fix ? 'A' : 'V');
+    p = put(p, body);
+    if (fix)
+        sprintf(body, "GPGGA,1200%02d.00,4100.00000,N,02900.00000,E,1,%02d,1.0,100.0,M,37.0,M,,",
+                t % 60, SATS);
+    else
+        sprintf(body, "GPGGA,1200%02d.00,,,,,0,00,99.99,,,,,,", t % 60);
+    p = put(p, body);
+    p = put(p, fix ? "GPGSA,A,3,01,02,03,04,05,06,07,08,,,,,1.8,1.0,1.5"
+                   : "GPGSA,A,1,,,,,,,,,,,,,99.99,99.99,99.99");
+
+    // Two GSV messages of four satellites
+    for (int m = 0; m < SATS / 4; m++) {
+        int n = sprintf(body, "GPGSV,%d,%d,%02d", SATS / 4, m + 1, SATS);
+        for (int k = 0; k < 4; k++) {
+            int i   = m * 4 + k;
+            int snr = 38 + i % 5 + (int)rnd(3) - (jammed ? JAM_DB : 0);
+            n += sprintf(body + n, ",%02d,%02d,%03d,%02d", i + 1, 20 + i * 8, i * 45, snr);
+        }
+        p = put(p, body);
+    }
+    p = put(p, "GPGLL,4100.00000,N,02900.00000,E,1200.00,A,A");
+    return (size_t)(p - out);
+}
+
+static void run(Run *r, int keepFix) {
+    static BN220_Context ctx;
+    static char          buf[1024];
+
+    memset(r, 0, sizeof(*r));
+    sigmonInit(&r->mon, onEvent, r);
+    gpsInit(&ctx);
+    ctx.onSats  = onSats;
+    ctx.onEpoch = onEpoch;
+    ctx.user    = r;
+
+    for (int t = 0; t < EPOCHS; t++) {
+        size_t n = genEpoch(buf, t, t >= JAM_EPOCH, keepFix);
+        gpsFeed(&ctx, (const uint8_t *)buf, n);
+    }
+}
+
+
+int main(void) {
+    Run lost, kept;
+
+    run(&kept, 1);
+    CHECK(kept.epochs == EPOCHS, "control: every GGA decodes");
+    CHECK(kept.tables == EPOCHS && kept.updates == EPOCHS, "control: every table reaches the monitor");
+    CHECK(kept.drops == 1 && kept.dropDb < -20, "control: UNIFORM_DROP raised");
+
+    run(&lost, 0);
+    CHECK(lost.epochs == JAM_EPOCH, "loss of fix: onEpoch stops with the fix");
+    CHECK(lost.tables == EPOCHS && lost.updates == EPOCHS, "loss of fix: every table reaches the monitor");
+    CHECK(lost.sats == SATS, "tables are complete when handed over");
+    CHECK(lost.drops == 1 && lost.dropDb < -20, "loss of fix: UNIFORM_DROP raised");
+
+    printf("%u tables, %u with a fix, UNIFORM_DROP %.1f dB (control %.1f dB)\n", lost.tables,
+           lost.epochs, lost.dropDb, kept.dropDb);
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
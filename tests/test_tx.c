@@ -0,0 +1,191 @@
+/*
+ * test_tx.c — test_tx.c
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    test_tx.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Transmit queue order, priority and ring wrap on the UART
+ *          simulator.
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * Transmit queue test on the host UART simulator.
+ *
+ * Config frames and RTCM-sized bulk frames are queued at random times,
+ * in bursts that overrun the line, through a start hook that sometimes
+ * refuses a transfer (retried by txPoll).  Every accepted frame must reach
+ * the wire once, intact, in order within its priority; a bulk frame may
+ * only start while no config frame waits; every frame handed to DMA must
+ * lie contiguously inside its ring; refused frames are counted as drops.
+ *
+ * Exit status is 0 when every check passes.
+ */
+
+#include "BN220_tx.h"
+#include "test_util.h"
+#include <stdio.h>
+
+#define STEPS     400000    // 50 us each: 20 s of line time
+#define FIFO_MAX  4096
+
+typedef struct {
+    uint32_t seq[FIFO_MAX];
+    uint16_t len[FIFO_MAX];
+    size_t   head, tail;
+} Fifo;
+
+static BN220_TxQueue q;
+static BN220_TxSim   sim;
+static Fifo          expect[2];
+static uint32_t      delivered[2], refusedStarts, wrongOrder, badBytes, badPrio, badSlot;
+
+static uint8_t frameByte(uint32_t seq, size_t i) {
+    return (uint8_t)(seq * 31u + i * 7u + (seq >> 8));
+}
+
+static void fillFrame(uint8_t *buf, uint32_t seq, uint16_t len) {
+    for (size_t i = 0; i < len; i++)
+        buf[i] = frameByte(seq, i);
+}
+
+// Which ring a DMA pointer lies in; -1 if neither
+static int ringOf(const uint8_t *data, uint16_t len) {
+    for (int p = 0; p < 2; p++) {
+        const BN220_TxRing *r = &q.ring[p];
+        if (data >= r->buf && data + len <= r->buf + r->size)
+            return p;
+    }
+    return -1;
+}
+
+static int startHook(void *port, const uint8_t *data, uint16_t len) {
+    if (rnd(10) == 0) {
+        refusedStarts++;
+        return 0;
+    }
+    int p = ringOf(data, len);
+    if (p < 0)
+        badSlot++;
+    else if (p == BN220_TX_BULK && q.ring[BN220_TX_CONFIG].head != q.ring[BN220_TX_CONFIG].tail)
+        badPrio++;  // a config frame was waiting
+    return txSimStart(port, data, len);
+}
+
+static int sink(void *user, const uint8_t *data, uint16_t len) {
+    (void)user;
+    int   p = ringOf(data, len);
+    Fifo *f = &expect[p < 0 ? 0 : p];
+    if (f->head == f->tail) {
+        wrongOrder++;
+        return 1;
+    }
+    uint32_t seq = f->seq[f->tail % FIFO_MAX];
+    if (f->len[f->tail % FIFO_MAX] != len) {
+        wrongOrder++;
+    } else {
+        for (size_t i = 0; i < len; i++)
+            if (data[i] != frameByte(seq, i)) {
+                badBytes++;
+                break;
+            }
+    }
+    f->tail++;
+    delivered[p < 0 ? 0 : p]++;
+    return 1;
+}
+
+static int push(BN220_TxPriority prio, uint16_t len, uint32_t seq) {
+    static uint8_t frame[BN220_TX_BULK_BYTES];
+    Fifo *f = &expect[prio];
+    fillFrame(frame, seq, len);
+    if (f->head - f->tail >= FIFO_MAX)
+        return 0;
+    f->seq[f->head % FIFO_MAX] = seq;
+    f->len[f->head % FIFO_MAX] = len;
+    int ok = txQueue(&q, prio, frame, len);
+    if (ok)
+        f->head++;
+    return ok;
+}
+
+
+int main(void) {
+    uint32_t queued[2] = { 0, 0 }, refused[2] = { 0, 0 }, seq = 1;
+
+    txInit(&q, startHook, &sim);
+    txSimInit(&sim, &q, 460800, sink, NULL);
+
+    // 1) Malformed frames are refused and counted
+    uint8_t one = 0;
+    CHECK(!txQueue(&q, BN220_TX_CONFIG, &one, 0), "empty frame refused");
+    CHECK(!txQueue(&q, BN220_TX_BULK, &one, BN220_TX_BULK_BYTES), "frame larger than the ring refused");
+    CHECK(q.dropped[BN220_TX_CONFIG] == 1 && q.dropped[BN220_TX_BULK] == 1, "refusals counted");
+    CHECK(txIdle(&q), "idle after refusals");
+    txComplete(&q);  // spurious interrupt: harmless
+    CHECK(txIdle(&q), "spurious completion ignored");
+    q.dropped[0] = q.dropped[1] = 0;
+
+    // 2) Random traffic, bursts overrunning the line now and then
+    for (uint32_t step = 0; step < STEPS; step++) {
+        int burst = (step / 20000) % 4 == 3;
+        if (rnd(burst ? 60 : 400) == 0) {
+            uint16_t len = (uint16_t)(8 + rnd(rnd(4) ? 60 : 200));
+            int ok = push(BN220_TX_CONFIG, len, seq++);
+            queued[0] += ok;
+            refused[0] += !ok;
+        }
+        if (rnd(burst ? 20 : 700) == 0) {
+            uint16_t len = (uint16_t)(1 + rnd(rnd(3) ? 300 : 1029));
+            int ok = push(BN220_TX_BULK, len, seq++);
+            queued[1] += ok;
+            refused[1] += !ok;
+        }
+        txSimAdvance(&sim, (uint64_t)step * 50);
+        txPoll(&q);
+    }
+
+    // 3) Drain
+    for (uint64_t t = (uint64_t)STEPS * 50; !txIdle(&q) && t < (uint64_t)STEPS * 50 + 10000000; t += 50) {
+        txSimAdvance(&sim, t);
+        txPoll(&q);
+    }
+
+    CHECK(txIdle(&q), "queue drains");
+    CHECK(!wrongOrder && !badBytes, "frames delivered once, in order, intact");
+    CHECK(!badPrio, "bulk never starts while a config frame waits");
+    CHECK(!badSlot, "DMA reads each frame contiguously from its ring");
+    for (int p = 0; p < 2; p++) {
+        CHECK(delivered[p] == queued[p] && q.sent[p] == queued[p], "every accepted frame sent");
+        CHECK(q.dropped[p] == refused[p], "drops counted");
+        CHECK(expect[p].head == expect[p].tail, "nothing left expected");
+    }
+    CHECK(refused[1] > 0 && refusedStarts > 0, "bursts overran the bulk ring and starts were retried");
+
+    printf("config %u sent %u dropped, bulk %u sent %u dropped, %llu bytes, %u starts retried\n",
+           delivered[0], refused[0], delivered[1], refused[1], (unsigned long long)sim.bytes,
+           refusedStarts);
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,72 @@
+/*
+ * test_util.h — Shared host-test helpers
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    test_util.h
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Reproducible random numbers and the CHECK macro used by the host
+ *          tests.
+ * ---------------------------------------------------------------------------
+ */
+
+#ifndef TESTS_TEST_UTIL_H_
+#define TESTS_TEST_UTIL_H_
+
+/*
+ * Helpers shared by the host tests; each test is one translation unit.
+ *
+ * The generator is xorshift64*, so a seed gives the same values on every
+ * libc, unlike rand().  Tests that check values against a recorded digest
+ * depend on this sequence: do not change it.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define TEST_SEED 0x9E3779B97F4A7C15ull
+
+static uint64_t rngState __attribute__((unused)) = TEST_SEED;
+static int      failures __attribute__((unused));
+
+#define CHECK(cond, what) \
+    do { if (!(cond)) { printf("FAIL: %s\n", what); failures++; } } while (0)
+
+static inline uint64_t rnd64(void) {
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return rngState * 0x2545F4914F6CDD1Dull;
+}
+
+// Uniform in [0, n), n > 0
+static inline uint32_t rnd(uint32_t n) {
+    return (uint32_t)(rnd64() >> 32) % n;
+}
+
+// Uniform in [lo, hi)
+static inline double uniform(double lo, double hi) {
+    return lo + (hi - lo) * (double)(rnd64() >> 11) * 0x1p-53;
+}
+
+#endif /* TESTS_TEST_UTIL_H_ */
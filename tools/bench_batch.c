@@ -0,0 +1,142 @@
+/*
+ * bench_batch.c — Batch GGA throughput benchmark
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    bench_batch.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   gpsBatchGGA against one gpsFeed context per device, in sentences
+ *          per second.
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * Throughput of gpsBatchGGA against the streaming parser.
+ *
+ * Builds N random GGA sentences (one per simulated device), decodes them
+ * with gpsBatchGGA and, for comparison, feeds the same bytes through one
+ * gpsFeed context per sentence, as a per-device server loop would.  Both
+ * are timed with the monotonic clock over several passes; the best pass
+ * is reported.
+ *
+ * Build and run (host):
+ *   cc -std=gnu99 -O2 -DBN220_PLATFORM_HAL=0 -I. tools/bench_batch.c \
+ *      BN220_batch.c BN220.c -o bench_batch && ./bench_batch
+ *
+ * Options: -n <count>  sentences per pass (default 200000)
+ *          -p <count>  passes (default 5)
+ *          -m <rate>   fail unless the batch path reaches <rate> sentences/s
+ *                      (default 100000)
+ */
+
+#include "BN220_batch.h"
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_LINE 100
+
+static double now(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+static void genGGA(char *out) {
+    char    body[BENCH_LINE - 8];   // room for "$", "*CS" and CR/LF
+    uint8_t cs = 0;
+
+    snprintf(body, sizeof(body), "GPGGA,%02d%02d%02d.%02d,%02d%02d.%05d,%c,%03d%02d.%05d,%c,1,%02d,%d.%02d,%d.%d,M,46.9,M,,",
+             rand() % 24, rand() % 60, rand() % 60, rand() % 100, rand() % 90, rand() % 60, rand() % 100000,
+             rand() % 2 ? 'N' : 'S', rand() % 180, rand() % 60, rand() % 100000, rand() % 2 ? 'E' : 'W',
+             3 + rand() % 10, rand() % 5, rand() % 100, rand() % 4000, rand() % 10);
+    for (const char *p = body; *p; p++)
+        cs ^= (uint8_t)*p;
+    snprintf(out, BENCH_LINE, "$%s*%02X\r\n", body, cs);
+}
+
+
+int main(int argc, char **argv) {
+    size_t n = 200000;
+    int    passes = 5, opt;
+    double minRate = 100000;
+
+    while ((opt = getopt(argc, argv, "n:p:m:")) != -1) {
+        if (opt == 'n')
+            n = (size_t)atol(optarg);
+        else if (opt == 'p')
+            passes = atoi(optarg);
+        else if (opt == 'm')
+            minRate = atof(optarg);
+        else
+            return 2;
+    }
+
+    char        (*line)[BENCH_LINE] = calloc(n, BENCH_LINE);
+    size_t       *len = calloc(n, sizeof(*len));
+    const char  **ptr = calloc(n, sizeof(*ptr));
+    BN220_Fix    *out = calloc(n, sizeof(*out));
+    uint8_t      *ok  = calloc(n, 1);
+    BN220_Context *ctx = malloc(sizeof(*ctx));
+    if (!line || !len || !ptr || !out || !ok || !ctx)
+        return 1;
+
+    srand(3);
+    for (size_t i = 0; i < n; i++) {
+        genGGA(line[i]);
+        len[i] = strlen(line[i]);
+        ptr[i] = line[i];
+    }
+
+    double  bestBatch = 1e9, bestFeed = 1e9;
+    size_t  decoded = 0;
+    int64_t sink = 0;
+    for (int p = 0; p < passes; p++) {
+        // 1) Batch decoder
+        double t0 = now();
+        decoded = gpsBatchGGA(ptr, NULL, n, out, ok);
+        double t1 = now();
+
+        // 2) Streaming parser, a fresh context per device
+        for (size_t i = 0; i < n; i++) {
+            BN220_Fix fix;
+            gpsInit(ctx);
+            gpsFeed(ctx, (const uint8_t *)line[i], len[i]);
+            gpsToFix(&ctx->gps, &fix);
+            sink += fix.lat_e7;
+        }
+        double t2 = now();
+
+        if (t1 - t0 < bestBatch)
+            bestBatch = t1 - t0;
+        if (t2 - t1 < bestFeed)
+            bestFeed = t2 - t1;
+    }
+
+    double rate = (double)n / bestBatch;
+    printf("gpsBatchGGA: %.2f M sentences/s (%zu/%zu decoded)\n", rate / 1e6, decoded, n);
+    printf("gpsFeed:     %.2f M sentences/s (checksum %lld)\n", (double)n / bestFeed / 1e6, (long long)sink);
+    printf("%s\n", decoded == n && rate >= minRate ? "OK" : "FAILED");
+    free(line); free(len); free(ptr); free(out); free(ok); free(ctx);
+    return decoded == n && rate >= minRate ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+#!/bin/sh
+#
+# size_report.sh — flash/RAM footprint of the BN-220 driver per configuration
+#
+# Builds the driver sources together with a minimal main() for a set of
+# BN220_config.h presets, links with --gc-sections so only what is really
+# referenced is kept (including libc), and prints text/data/bss per preset.
+#
+# Usage:  tools/size_report.sh
+#         CC=gcc SIZE=size CFLAGS_TARGET= LDFLAGS_TARGET= tools/size_report.sh   (host)
+#
+# The MCU build uses BN220_PLATFORM_HAL=0 so the report does not depend on a
+# CubeMX project; the HAL only contributes to the UBX port hooks anyway.
+
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+CC=${CC:-arm-none-eabi-gcc}
+SIZE=${SIZE:-arm-none-eabi-size}
+CFLAGS_TARGET=${CFLAGS_TARGET--mcpu=cortex-m33 -mthumb -mfloat-abi=hard -mfpu=fpv5-sp-d16}
+LDFLAGS_TARGET=${LDFLAGS_TARGET---specs=nano.specs --specs=nosys.specs}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+SOURCES="BN220.c BN220_ubx.c BN220_aiding.c BN220_rate.c"
+
+# name | -D flags
+PRESETS='
+full         |
+gga-only     | -DBN220_ENABLE_GLL=0 -DBN220_ENABLE_GSA=0 -DBN220_ENABLE_GSV=0 -DBN220_ENABLE_RMC=0
+gga-lite     | -DBN220_ENABLE_GLL=0 -DBN220_ENABLE_GSA=0 -DBN220_ENABLE_GSV=0 -DBN220_ENABLE_RMC=0 -DBN220_NUMERIC_LIBC=0 -DBN220_ENABLE_LEGACY_PARSE=0 -DBN220_ENABLE_UBX=0
+stream-lite  | -DBN220_NUMERIC_LIBC=0 -DBN220_ENABLE_LEGACY_PARSE=0
+stream-stats | -DBN220_NUMERIC_LIBC=0 -DBN220_ENABLE_LEGACY_PARSE=0 -DBN220_ENABLE_STATS=1
+stream-swar  | -DBN220_NUMERIC_LIBC=0 -DBN220_ENABLE_LEGACY_PARSE=0 -DBN220_USE_SWAR=1
+'
+
+# Reference the public API so --gc-sections keeps what an application would use
+cat > "$WORK/main.c" <<'EOF'
+#include "BN220.h"
+#include "BN220_aiding.h"
+#include "BN220_rate.h"
+
+static BN220_Context ctx;
+volatile uint8_t rx[64];
+volatile size_t sink;
+
+static int port(void *u, const uint8_t *d, uint16_t n) { (void)u; sink += d[0] + n; return 1; }
+
+int main(void)
+{
+    uint8_t blob[BN220_CHECKPOINT_MAX];
+
+    gpsInit(&ctx);
+    gpsFeed(&ctx, (const uint8_t *)rx, sizeof rx);
+#if BN220_ENABLE_LEGACY_PARSE
+    gpsParse(&ctx.gps, (uint8_t *)rx);
+#endif
+    sink = gpsCheckpoint(&ctx, blob, sizeof blob);
+    sink += gpsRestore(&ctx, blob, sink);
+#if BN220_ENABLE_UBX
+    static BN220_RateCtl rate;
+    static const BN220_RateProfile prof[] = { { 1000, 0.0f }, { 100, 5.0f } };
+    BN220_AidingStore store = { 0, 0, 0 };
+    gpsRateInit(&rate, prof, 2, 0);
+    sink += gpsRateUpdate(&rate, &ctx.gps, port, 0);
+    sink += gpsAidingSave(&store, &ctx.gps);
+    sink += gpsAidingInject(&store, 0, port, 0);
+#else
+    (void)port;
+#endif
+    return (int)sink;
+}
+EOF
+
+printf '%-14s %8s %8s %8s\n' preset text data bss
+echo "$PRESETS" | while IFS='|' read -r name defs; do
+    name=$(echo "$name" | tr -d ' ')
+    [ -z "$name" ] && continue
+    srcs=""
+    for s in $SOURCES; do srcs="$srcs $ROOT/$s"; done
+    # shellcheck disable=SC2086
+    $CC -std=gnu11 -Os -ffunction-sections -fdata-sections $CFLAGS_TARGET \
+        -DBN220_PLATFORM_HAL=0 $defs -I"$ROOT" \
+        "$WORK/main.c" $srcs -Wl,--gc-sections $LDFLAGS_TARGET -o "$WORK/$name.elf"
+    $SIZE "$WORK/$name.elf" | awk -v n="$name" 'NR == 2 { printf "%-14s %8s %8s %8s\n", n, $1, $2, $3 }'
+done
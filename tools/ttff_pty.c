@@ -0,0 +1,358 @@
+/*
+ * ttff_pty.c — Warm-start TTFF harness
+ *
+ * Copyright (c) 2026  Kaan Sezer  <kaansezer0594@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the “Software”), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  • The above copyright notice and this permission notice shall be included
+ *    in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ---------------------------------------------------------------------------
+ * @file    ttff_pty.c
+ * @author  Kaan Sezer
+ * @date    18 October 2026
+ * @brief   Simulated receiver on a pty: checks MGA-INI aiding and measures
+ *          TTFF
+ * ---------------------------------------------------------------------------
+ */
+
+/*
+ * Warm-start check on a pseudo-terminal.
+ *
+ * A simulated BN-220 runs in a child process on the master side of a pty;
+ * the driver runs unchanged on the slave side, as it would on a serial
+ * port.  The receiver model decodes the UBX frames it is sent, reports
+ * every MGA-INI frame back as a $PSIM sentence, and produces a fix after
+ * a cold or an aided time-to-first-fix (modelled, in simulated seconds).
+ *
+ * Two runs are made: a cold start with an empty aiding store, then a warm
+ * start that injects the fix saved by the cold run plus the host clock.
+ * The tool checks that the warm run's MGA-INI-TIME_UTC and
+ * MGA-INI-POS_LLH arrive intact, that the cold run sends nothing, and
+ * prints the TTFF measured by the driver in both cases.
+ *
+ * Build and run (host):
+ *   cc -std=c99 -D_DEFAULT_SOURCE -DBN220_PLATFORM_HAL=0 -I. tools/ttff_pty.c \
+ *      BN220.c BN220_ubx.c BN220_aiding.c -lutil -o ttff_pty && ./ttff_pty
+ *
+ * Options: -s <ms>   real milliseconds per simulated second (default 20)
+ *          -c <s>    modelled cold TTFF (default 29)
+ *          -w <s>    modelled TTFF with time and position aiding (default 11)
+ * Exit status is 0 when every check passes.
+ */
+
+#include "BN220.h"
+#include "BN220_aiding.h"
+#include <errno.h>
+#include <poll.h>
+#include <pty.h>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SIM_LAT_E7   412345678   // true antenna position of the simulated receiver
+#define SIM_LON_E7   290123456
+#define SIM_ALT_CM   4210
+#define SIM_TIMEOUT  120         // simulated seconds before a run is abandoned
+
+static int simScaleMs = 20, simColdS = 29, simWarmS = 11;
+
+
+/* --- Simulated receiver (master side) ------------------------------------- */
+
+typedef struct {
+    int      fd;
+    uint8_t  frame[128];
+    uint16_t len;
+    int      gotPos, gotTime, aidEpoch;
+} SimRx;
+
+static void simSend(int fd, const char *body) {
+    char    line[128];
+    uint8_t cs = 0;
+    for (const char *p = body; *p; p++)
+        cs ^= (uint8_t)*p;
+    int n = snprintf(line, sizeof(line), "$%s*%02X\r\n", body, cs);
+    if (write(fd, line, (size_t)n) != n)
+        _exit(3);
+}
+
+static int32_t simGet32(const uint8_t *p) {
+    return (int32_t)(p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24));
+}
+
+// One complete, checksum-verified UBX frame
+static void simFrame(SimRx *rx, int epoch) {
+    const uint8_t *f = rx->frame, *pl = rx->frame + 6;
+    uint16_t       len = (uint16_t)(f[4] | (f[5] << 8));
+    char           body[96];
+
+    if (f[2] != UBX_CLASS_MGA || f[3] != UBX_MGA_INI)
+        return;
+    if (pl[0] == 0x01 && len == 20) {
+        rx->gotPos = 1;
+        snprintf(body, sizeof(body), "PSIM,MGA,POS,%ld,%ld,%ld,%lu", (long)simGet32(pl + 4),
+                 (long)simGet32(pl + 8), (long)simGet32(pl + 12), (unsigned long)(uint32_t)simGet32(pl + 16));
+    } else if (pl[0] == 0x10 && len == 24) {
+        rx->gotTime = 1;
+        snprintf(body, sizeof(body), "PSIM,MGA,TIME,%04u%02u%02u,%02u%02u%02u",
+                 pl[4] | (pl[5] << 8), pl[6], pl[7], pl[8], pl[9], pl[10]);
+    } else {
+        return;
+    }
+    if (rx->aidEpoch < 0)
+        rx->aidEpoch = epoch;
+    simSend(rx->fd, body);
+}
+
+// Feed received bytes through a small UBX framer
+static void simInput(SimRx *rx, const uint8_t *p, ssize_t n, int epoch) {
+    for (ssize_t i = 0; i < n; i++) {
+        if (rx->len == 0 && p[i] != UBX_SYNC_1)
+            continue;
+        if (rx->len == 1 && p[i] != UBX_SYNC_2) {
+            rx->len = 0;
+            continue;
+        }
+        rx->frame[rx->len++] = p[i];
+        if (rx->len < 6)
+            continue;
+        uint32_t total = (uint32_t)(rx->frame[4] | (rx->frame[5] << 8)) + UBX_FRAME_OVERHEAD;
+        if (total > sizeof(rx->frame)) {
+            rx->len = 0;
+            continue;
+        }
+        if (rx->len < total)
+            continue;
+        uint8_t a = 0, b = 0;
+        for (uint32_t k = 2; k < total - 2; k++) {
+            a += rx->frame[k];
+            b += a;
+        }
+        if (a == rx->frame[total - 2] && b == rx->frame[total - 1])
+            simFrame(rx, epoch);
+        rx->len = 0;
+    }
+}
+
+static void simReceiver(int fd) {
+    SimRx rx = { fd, { 0 }, 0, 0, 0, -1 };
+    char  body[96];
+
+    for (int epoch = 0; epoch < SIM_TIMEOUT; epoch++) {
+        // 1) One simulated second: take whatever the host sent meanwhile
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        struct timespec until;
+        clock_gettime(CLOCK_MONOTONIC, &until);
+        long deadline = until.tv_sec * 1000L + until.tv_nsec / 1000000L + simScaleMs;
+        for (;;) {
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            long left = deadline - (now.tv_sec * 1000L + now.tv_nsec / 1000000L);
+            if (left <= 0 || poll(&pfd, 1, (int)left) <= 0)
+                break;
+            uint8_t buf[256];
+            ssize_t n = read(fd, buf, sizeof(buf));
+            if (n <= 0)
+                break;
+            simInput(&rx, buf, n, epoch);
+        }
+
+        // 2) Modelled TTFF: counted from power-up, or from the aiding when
+        //    both time and position arrived
+        int fixAt = rx.gotPos && rx.gotTime ? rx.aidEpoch + simWarmS : simColdS;
+        int fix   = epoch >= fixAt;
+        int hh = 12 + epoch / 3600, mm = epoch / 60 % 60, ss = epoch % 60;
+        if (fix) {
+            long lat = SIM_LAT_E7 / 10, lon = SIM_LON_E7 / 10;   // 1e-6 deg
+            snprintf(body, sizeof(body), "GPGGA,%02d%02d%02d.00,%02ld%09.6f,N,%03ld%09.6f,E,1,09,0.92,%.1f,M,,M,,",
+                     hh, mm, ss, lat / 1000000, (double)(lat % 1000000) * 60e-6,
+                     lon / 1000000, (double)(lon % 1000000) * 60e-6, SIM_ALT_CM / 100.0);
+        } else {
+            snprintf(body, sizeof(body), "GPGGA,%02d%02d%02d.00,,,,,0,00,99.99,,,,,,", hh, mm, ss);
+        }
+        simSend(fd, body);
+    }
+    _exit(0);
+}
+
+
+/* --- Driver side (slave) -------------------------------------------------- */
+
+typedef struct {
+    uint8_t blob[sizeof(BN220_AidingRecord)];
+    int     valid;
+} MemStore;
+
+static int memSave(void *user, const void *blob, uint16_t len) {
+    MemStore *s = user;
+    if (len != sizeof(s->blob))
+        return 0;
+    memcpy(s->blob, blob, len);
+    s->valid = 1;
+    return 1;
+}
+
+static int memLoad(void *user, void *blob, uint16_t len) {
+    MemStore *s = user;
+    if (!s->valid || len != sizeof(s->blob))
+        return 0;
+    memcpy(blob, s->blob, len);
+    return 1;
+}
+
+static int ttyWrite(void *user, const uint8_t *data, uint16_t len) {
+    return write(*(int *)user, data, len) == (ssize_t)len;
+}
+
+typedef struct {
+    BN220_Context ctx;
+    int           ttff;      // simulated seconds until the first fix, -1 while none
+    int           mgaPos, mgaTime;
+    long          posLat, posLon;
+} Run;
+
+static void onEpoch(void *user, const BN220_Fix *fix) {
+    Run *r = user;
+    // The simulator's clock starts at 12:00:00 and no date is sent
+    if (fix->fix && r->ttff < 0)
+        r->ttff = (int)((fix->utc_ms - 12 * 3600000LL) / 1000);
+}
+
+// $PSIM lines are the simulator's report; the driver ignores them
+static void scanReport(Run *r, const char *line) {
+    long lat, lon;
+    if (sscanf(line, "$PSIM,MGA,POS,%ld,%ld", &lat, &lon) == 2) {
+        r->mgaPos = 1;
+        r->posLat = lat;
+        r->posLon = lon;
+    } else if (!strncmp(line, "$PSIM,MGA,TIME,", 15)) {
+        r->mgaTime = 1;
+    }
+}
+
+static int runOnce(Run *r, MemStore *store, int aided) {
+    int master, slave;
+    if (openpty(&master, &slave, NULL, NULL, NULL) < 0) {
+        perror("openpty");
+        return 0;
+    }
+    struct termios tio;
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(slave);
+        simReceiver(master);
+    }
+    close(master);
+
+    memset(r, 0, sizeof(*r));
+    r->ttff = -1;
+    gpsInit(&r->ctx);
+    r->ctx.onEpoch = onEpoch;
+    r->ctx.user    = r;
+
+    // 1) Power-up: aiding goes out before any byte is parsed
+    if (aided) {
+        time_t          t  = time(NULL);
+        struct tm      *tm = gmtime(&t);
+        BN220_UtcTime   now = { (uint16_t)(tm->tm_year + 1900), (uint8_t)(tm->tm_mon + 1),
+                                (uint8_t)tm->tm_mday, (uint8_t)tm->tm_hour, (uint8_t)tm->tm_min,
+                                (uint8_t)tm->tm_sec, 2 };
+        BN220_AidingStore st = { memSave, memLoad, store };
+        gpsAidingInject(&st, &now, ttyWrite, &slave);
+    }
+
+    // 2) Decode until the first fix, then save it for the next boot
+    char   line[128];
+    size_t lineLen = 0;
+    while (r->ttff < 0) {
+        uint8_t buf[256];
+        ssize_t n = read(slave, buf, sizeof(buf));
+        if (n <= 0)
+            break;   // simulator gave up (EIO once the master is closed)
+        gpsFeed(&r->ctx, buf, (size_t)n);
+        for (ssize_t i = 0; i < n; i++) {
+            if (buf[i] == '$')
+                lineLen = 0;
+            if (lineLen < sizeof(line) - 1)
+                line[lineLen++] = (char)buf[i];
+            if (buf[i] == '\n') {
+                line[lineLen] = '\0';
+                scanReport(r, line);
+            }
+        }
+    }
+    if (r->ttff >= 0) {
+        BN220_AidingStore st = { memSave, memLoad, store };
+        gpsAidingSave(&st, &r->ctx.gps);
+    }
+
+    kill(pid, SIGTERM);
+    waitpid(pid, NULL, 0);
+    close(slave);
+    return r->ttff >= 0;
+}
+
+
+int main(int argc, char **argv) {
+    int opt, failures = 0;
+    while ((opt = getopt(argc, argv, "s:c:w:")) != -1) {
+        if (opt == 's')
+            simScaleMs = atoi(optarg);
+        else if (opt == 'c')
+            simColdS = atoi(optarg);
+        else if (opt == 'w')
+            simWarmS = atoi(optarg);
+        else
+            return 2;
+    }
+
+    MemStore store = { { 0 }, 0 };
+    Run      cold, warm;
+
+#define CHECK(cond, what) \
+    do { if (!(cond)) { printf("FAIL: %s\n", what); failures++; } } while (0)
+
+    // 1) Cold start: nothing stored, nothing sent
+    CHECK(runOnce(&cold, &store, 0), "cold start reaches a fix");
+    CHECK(!cold.mgaPos && !cold.mgaTime, "cold start sends no aiding");
+    CHECK(store.valid, "first fix saved as aiding record");
+
+    // 2) Warm start from the saved fix and the host clock
+    CHECK(runOnce(&warm, &store, 1), "warm start reaches a fix");
+    CHECK(warm.mgaTime, "MGA-INI-TIME_UTC received");
+    CHECK(warm.mgaPos, "MGA-INI-POS_LLH received");
+    BN220_AidingRecord rec;
+    memcpy(&rec, store.blob, sizeof(rec));
+    CHECK(warm.posLat == rec.lat_e7 && warm.posLon == rec.lon_e7, "MGA-INI-POS_LLH carries the saved fix");
+    // GGA minutes are read to three decimals: 1e-3' is about 167e-7 deg
+    CHECK(labs(warm.posLat - SIM_LAT_E7) < 200 && labs(warm.posLon - SIM_LON_E7) < 200,
+          "saved fix matches the simulated antenna");
+    CHECK(warm.ttff >= 0 && cold.ttff >= 0 && warm.ttff < cold.ttff, "aiding shortens TTFF");
+
+    printf("TTFF cold %d s, warm %d s (simulated seconds; model cold %d s, aided %d s)\n",
+           cold.ttff, warm.ttff, simColdS, simWarmS);
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}